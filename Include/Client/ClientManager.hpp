@@ -85,9 +85,7 @@ class ClientManager {
 
         ConnectResponse _connectRes; /**< Response from the server after connection. */
         std::vector<RoomInfo> _rooms; /**< List of available rooms. */
-        double _lastRoomUpdate; /**< Timestamp of the last room list update. */
         LobbyState _lobbyState; /**< Current state of the lobby. */
-        double _lastLobbyUpdate; /**< Timestamp of the last lobby state update. */
         bool _connected; /**< Flag indicating if connected to the server. */
 
         bool _createRoomInitiated; /**< Flag indicating if a room creation request is in progress. */
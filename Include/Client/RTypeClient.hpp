@@ -13,6 +13,8 @@
 #include "GameState.hpp"
 #include "Renderer.hpp"
 #include "Network/Protocole/ProtocoleTCP.hpp"
+#include "Network/Snapshot.hpp"
+#include "Network/ReliableChannel.hpp"
 #include <string>
 #include <iostream>
 #include "Clock.hpp"
@@ -80,11 +82,33 @@ private:
      */
     void update();
 
+    /**
+     * @brief Applies a single server message to the game state.
+     * Messages unpacked from a BUNDLE datagram go through here one by one.
+     * @param data Pointer to the message, starting with its type byte.
+     * @param size Number of readable bytes at @p data.
+     */
+    void handleMessage(const char* data, size_t size);
+
     /**
      * @brief Processes incoming network messages from the server.
      */
     void processNetworkMessages();
 
+    /**
+     * @brief Replaces the server-owned entities with a decoded snapshot and acknowledges it.
+     * @param data Pointer to the SNAPSHOT or SNAPSHOT_PACKED message.
+     * @param size Number of readable bytes at @p data.
+     */
+    void applySnapshot(const char* data, size_t size);
+
+    /**
+     * @brief Sends a player input carrying the reliable channel acknowledgement.
+     * Before protocol 3 the acknowledgement fields are left out.
+     * @param packet The input, its acknowledgement fields are filled in.
+     */
+    void sendInput(PlayerInputPacket& packet);
+
     TCPClient& _tcpClient; /**< TCP client for monitoring connection status */
     UDPClient _udpClient; /**< UDP client for real-time communication */
     GameState _gameState; /**< Current state of the game */
@@ -96,6 +120,13 @@ private:
 
     std::deque<PlayerInputPacket> _pendingInputs; /**< Queue of inputs sent but not yet acknowledged */
 
+    Network::SnapshotHistory _snapshots; /**< Snapshots received from the server, used as delta baselines */
+    std::vector<SyncedEntityState> _snapshotScratch; /**< Decoding buffer for incoming snapshots */
+    std::vector<EntityUpdatePacket> _updateScratch; /**< Decoding buffer for incoming packed entity updates */
+    uint32_t _lastSnapshotId = 0; /**< Id of the newest snapshot applied */
+    uint8_t _protocolVersion; /**< UDP protocol version negotiated at connection */
+    Network::ReliableReceiver _reliable; /**< Orders the messages of the reliable channel, acknowledged in every input */
+
     uint32_t _lastPingTime = 0; /**< Timestamp of the last ping sent */
     static constexpr uint32_t PING_INTERVAL_MS = 1000; /**< Interval between pings in milliseconds */
 
@@ -0,0 +1,150 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Bot
+*/
+
+#ifndef BOT_HPP_
+#define BOT_HPP_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Network/TCP/TCPClient.hpp"
+#include "Network/UDP/UDPClient.hpp"
+#include "Network/ReliableChannel.hpp"
+
+/**
+ * @file Bot.hpp
+ * @brief Header file for the Bot class of the load generator.
+ */
+
+/**
+ * @struct BotStats
+ * @brief What a bot measured during its game.
+ */
+struct BotStats {
+    uint32_t inputsSent = 0; /**< PLAYER_INPUT packets sent. */
+    uint32_t statesReceived = 0; /**< PLAYER_STATE packets received for this bot. */
+    uint32_t statesLost = 0; /**< PLAYER_STATE sequence numbers skipped. */
+    uint32_t pingsSent = 0; /**< PING packets sent. */
+    uint32_t reliableReceived = 0; /**< Messages delivered by the reliable channel. */
+    std::vector<uint32_t> rttMs; /**< One sample per PONG received. */
+    std::vector<uint32_t> inputLatencyMs; /**< Tick latency: time from sending an input to the first PLAYER_STATE reporting its tick processed. */
+};
+
+/**
+ * @class Bot
+ * @brief A headless player speaking the real TCP and UDP protocol.
+ *
+ * The bot goes through the same steps as ClientManager: CONNECT handshake,
+ * create or join a room, wait in the lobby, then play. In game it sends a
+ * randomized PlayerInputPacket on every update(), pings the server and
+ * acknowledges snapshots and reliable messages, and records what it measures
+ * in BotStats.
+ */
+class Bot {
+public:
+    static constexpr uint32_t PING_INTERVAL_MS = 250; /**< Interval between pings in milliseconds */
+    static constexpr size_t INPUT_HISTORY = 256; /**< Input ticks whose send time is remembered */
+
+    /**
+     * @enum State
+     * @brief Where the bot is in its session.
+     */
+    enum class State {
+        CONNECTED,      /**< Handshake done, not in a room. */
+        CREATING_ROOM,  /**< CREATE_ROOM sent, waiting for the room ID. */
+        JOINING_ROOM,   /**< JOIN_ROOM sent, waiting for the answer. */
+        LOBBY,          /**< In a room, waiting for the game to start. */
+        IN_GAME,        /**< Playing. */
+        DONE,           /**< Game over or kicked. */
+        FAILED          /**< A request failed or the connection was lost. */
+    };
+
+    /**
+     * @brief Construct a new Bot object.
+     * @param serverIp IP address of the server.
+     * @param tcpPort TCP port of the server.
+     * @param name Username sent in the CONNECT request.
+     * @param seed Seed of the input generator.
+     */
+    Bot(const std::string& serverIp, uint16_t tcpPort, std::string name, uint32_t seed);
+
+    /**
+     * @brief Connects and completes the CONNECT handshake. Blocking.
+     * @return true on success.
+     */
+    bool connect();
+
+    /**
+     * @brief Creates a room, then joins it.
+     */
+    void hostRoom();
+
+    /**
+     * @brief Joins an existing room.
+     * @param roomId The room.
+     */
+    void joinRoom(int roomId);
+
+    /**
+     * @brief Asks the server to start the game of the bot's room.
+     */
+    void startGame();
+
+    /**
+     * @brief Advances the bot by one frame. Never blocks.
+     * @param nowMs Current time of the load generator clock.
+     */
+    void update(uint32_t nowMs);
+
+    /**
+     * @brief Handles the UDP packets received since the last call, while in game.
+     * @param nowMs Current time of the load generator clock.
+     */
+    void poll(uint32_t nowMs);
+
+    State getState() const { return _state; }
+    int getRoomId() const { return _roomId; }
+    uint32_t getPlayerId() const { return _playerId; }
+    const std::string& getName() const { return _name; }
+    size_t getLobbySize() const { return _lobby.players.size(); }
+    const BotStats& getStats() const { return _stats; }
+
+private:
+    void updateInGame(uint32_t nowMs);
+    void sendInput(uint32_t nowMs);
+    void receive(uint32_t nowMs);
+    void handleMessage(const char* data, size_t size, uint32_t nowMs);
+    void onPlayerState(const PlayerStatePacket& state, uint32_t nowMs);
+
+    std::string _serverIp; /**< IP address of the server. */
+    std::string _name; /**< Username of the bot. */
+    TCPClient _tcpClient; /**< Lobby connection. */
+    std::unique_ptr<UDPClient> _udpClient; /**< Game connection, created after the handshake. */
+    State _state = State::CONNECTED;
+    uint32_t _playerId = 0;
+    uint8_t _protocolVersion = PROTOCOL_VERSION_LEGACY; /**< UDP protocol version negotiated at connection. */
+    Network::ReliableReceiver _reliable; /**< Reliable channel, acknowledged in every input. */
+    int _roomId = -1;
+    LobbyState _lobby; /**< Last lobby state pushed by the server. */
+
+    std::mt19937 _rng; /**< Input generator. */
+    uint8_t _heldInputs = 0; /**< Movement held until _holdFrames runs out. */
+    uint32_t _holdFrames = 0;
+    uint32_t _inputTick = 1; /**< Tick of the next input, 0 is never acknowledged by the server. */
+    std::array<uint32_t, INPUT_HISTORY> _inputSentAt{}; /**< Send time of the last inputs, by tick. */
+    uint32_t _lastAckedTick = 0; /**< Highest lastProcessedTick seen. */
+    bool _receivedState = false;
+    uint32_t _lastStateSequence = 0; /**< Highest PLAYER_STATE sequence seen. */
+    uint32_t _lastPingMs = 0;
+
+    BotStats _stats;
+};
+
+#endif /* !BOT_HPP_ */
@@ -0,0 +1,91 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** LoadGenerator
+*/
+
+#ifndef LOADGENERATOR_HPP_
+#define LOADGENERATOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Clock.hpp"
+#include "LoadGen/Bot.hpp"
+
+/**
+ * @file LoadGenerator.hpp
+ * @brief Header file for the LoadGenerator class.
+ */
+
+/**
+ * @struct LoadGenConfig
+ * @brief Command line settings of rtype_loadgen.
+ */
+struct LoadGenConfig {
+    std::string serverIp = "127.0.0.1"; /**< IP address of the server. */
+    uint16_t tcpPort = 4242; /**< TCP port of the server. */
+    size_t bots = 4; /**< Number of bots. */
+    size_t botsPerRoom = 4; /**< Bots sharing a room, the first one hosts it. */
+    uint32_t durationSeconds = 30; /**< Time spent in game before the report. */
+    uint32_t rate = 60; /**< Inputs sent per second by each bot. */
+    uint32_t seed = 42; /**< Seed of the input generators. */
+    bool verbose = false; /**< Keeps the network layer's log lines, see Network::setLogEnabled(). */
+};
+
+/**
+ * @class LoadGenerator
+ * @brief Drives a swarm of bots against a server and reports what they measured.
+ *
+ * Bots are grouped in rooms of LoadGenConfig::botsPerRoom. The first bot of a
+ * group creates the room, the others join it once its ID is known, and the
+ * host starts the game when everyone is in the lobby. All bots are updated
+ * from one thread at LoadGenConfig::rate, and their UDP sockets are drained
+ * every millisecond in between. Every socket is non-blocking, so a frame
+ * costs one send and a few receives per bot.
+ */
+class LoadGenerator {
+public:
+    static constexpr uint32_t LOBBY_TIMEOUT_MS = 10000; /**< Time allowed to fill a room before the host starts anyway */
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1}; /**< Sleep between two receive passes within a frame */
+
+    /**
+     * @brief Construct a new LoadGenerator object.
+     * @param config The settings.
+     */
+    explicit LoadGenerator(const LoadGenConfig& config);
+
+    /**
+     * @brief Connects the bots, plays for the configured duration and prints the report.
+     * @return int 0 on success, 84 if no bot could play.
+     */
+    int run();
+
+private:
+    /**
+     * @struct Room
+     * @brief A group of bots sharing a room, hosted by the first one.
+     */
+    struct Room {
+        size_t first; /**< Index of the host in _bots. */
+        size_t count; /**< Number of bots in the group. */
+        bool joinsSent = false;
+        uint32_t joinsSentMs = 0; /**< When the other bots were told to join. */
+        bool startSent = false;
+    };
+
+    bool connectBots();
+    void updateRooms(uint32_t nowMs);
+    bool allSettled() const;
+    void printReport() const;
+
+    LoadGenConfig _config;
+    Clock _clock;
+    std::vector<std::unique_ptr<Bot>> _bots;
+    std::vector<Room> _rooms;
+};
+
+#endif /* !LOADGENERATOR_HPP_ */
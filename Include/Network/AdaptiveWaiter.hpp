@@ -0,0 +1,137 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** AdaptiveWaiter
+*/
+
+#ifndef NETWORK_ADAPTIVEWAITER_HPP_
+#define NETWORK_ADAPTIVEWAITER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+/**
+ * @file AdaptiveWaiter.hpp
+ * @brief Spin-then-park wait primitive used by the network consumer threads.
+ */
+
+namespace Network {
+
+/**
+ * @struct WaiterStats
+ * @brief Snapshot of the counters of an AdaptiveWaiter.
+ */
+struct WaiterStats {
+    uint64_t spinHits = 0; ///< Number of waits satisfied while spinning
+    uint64_t parks = 0;    ///< Number of times the consumer went to sleep
+    uint64_t wakeups = 0;  ///< Number of times a parked consumer was woken up
+    uint64_t notifies = 0; ///< Number of notifications that had to issue a wake syscall
+};
+
+/**
+ * @class AdaptiveWaiter
+ * @brief Lets a single consumer wait for work without burning a core.
+ *
+ * The consumer first spins for a short while, which keeps latency low under
+ * load, then parks on an atomic epoch (a futex on Linux) until a producer calls
+ * notify(). Producers only pay for a syscall when the consumer is actually
+ * parked, so notify() is a single atomic load on the hot path.
+ */
+class AdaptiveWaiter {
+    public:
+        static constexpr uint32_t SPIN_ITERATIONS = 2000; ///< Spin attempts before parking
+
+        AdaptiveWaiter() = default;
+        ~AdaptiveWaiter() = default;
+
+        AdaptiveWaiter(const AdaptiveWaiter&) = delete;
+        AdaptiveWaiter& operator=(const AdaptiveWaiter&) = delete;
+
+        /**
+         * @brief Blocks until @p ready returns true.
+         * @tparam Predicate Callable returning bool, checked after every wakeup.
+         * It must also return true when the owner is shutting down.
+         * @param ready The condition to wait for.
+         */
+        template<typename Predicate>
+        void wait(Predicate&& ready) {
+            for (uint32_t i = 0; i < SPIN_ITERATIONS; ++i) {
+                if (ready()) {
+                    _spinHits.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                cpuRelax();
+            }
+
+            while (true) {
+                uint32_t epoch = _epoch.load(std::memory_order_acquire);
+                _sleepers.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (ready()) {
+                    _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                _parks.fetch_add(1, std::memory_order_relaxed);
+                _epoch.wait(epoch, std::memory_order_acquire);
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                _wakeups.fetch_add(1, std::memory_order_relaxed);
+                if (ready())
+                    return;
+            }
+        }
+
+        /**
+         * @brief Wakes the consumer if it is parked. Call after publishing work.
+         */
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_sleepers.load(std::memory_order_relaxed) == 0)
+                return;
+            _notifies.fetch_add(1, std::memory_order_relaxed);
+            _epoch.fetch_add(1, std::memory_order_release);
+            _epoch.notify_all();
+        }
+
+        /**
+         * @brief Returns a snapshot of the wait counters.
+         * @return WaiterStats The current counters.
+         */
+        WaiterStats getStats() const {
+            WaiterStats stats;
+            stats.spinHits = _spinHits.load(std::memory_order_relaxed);
+            stats.parks = _parks.load(std::memory_order_relaxed);
+            stats.wakeups = _wakeups.load(std::memory_order_relaxed);
+            stats.notifies = _notifies.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        /**
+         * @brief Hints the CPU that we are in a spin loop.
+         */
+        static void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        std::atomic<uint32_t> _epoch{0};    ///< Bumped by every notify that has a sleeper to wake
+        std::atomic<uint32_t> _sleepers{0}; ///< Number of consumers currently parked or about to park
+
+        std::atomic<uint64_t> _spinHits{0};
+        std::atomic<uint64_t> _parks{0};
+        std::atomic<uint64_t> _wakeups{0};
+        std::atomic<uint64_t> _notifies{0};
+};
+
+}
+
+#endif /* !NETWORK_ADAPTIVEWAITER_HPP_ */
@@ -0,0 +1,276 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** BitStream
+*/
+
+#ifndef NETWORK_BITSTREAM_HPP_
+#define NETWORK_BITSTREAM_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file BitStream.hpp
+ * @brief Bit-level writer and reader with fixed-point quantization and varints.
+ */
+
+namespace Network {
+
+/**
+ * @struct Quantizer
+ * @brief Fixed-point mapping of a float range onto an unsigned bit field.
+ *
+ * Values are clamped to [min, min + resolution * 2^bits) and rounded to the
+ * nearest step, so the error is at most resolution / 2 inside the range.
+ */
+struct Quantizer {
+    float min;        ///< Lowest value represented
+    float resolution; ///< Step between two representable values
+    uint32_t bits;    ///< Width of the field, 1 to 32
+
+    /**
+     * @brief Returns the largest field value.
+     * @return uint32_t 2^bits - 1.
+     */
+    constexpr uint32_t maxValue() const { return bits >= 32 ? UINT32_MAX : (uint32_t{1} << bits) - 1; }
+
+    /**
+     * @brief Converts a value to its field value.
+     * @param value The value, clamped to the range.
+     * @return uint32_t The field value.
+     */
+    uint32_t quantize(float value) const
+    {
+        float steps = (value - min) / resolution + 0.5f;
+        if (!(steps >= 1.0f)) // Also catches NaN
+            return 0;
+        if (steps >= static_cast<float>(maxValue()))
+            return maxValue();
+        return static_cast<uint32_t>(steps);
+    }
+
+    /**
+     * @brief Converts a field value back to a value.
+     * @param quantized The field value.
+     * @return float The value.
+     */
+    float dequantize(uint32_t quantized) const { return min + static_cast<float>(quantized) * resolution; }
+
+    /**
+     * @brief Returns the value a peer decodes after a round trip.
+     * @param value The value.
+     * @return float The quantized value.
+     */
+    float round(float value) const { return dequantize(quantize(value)); }
+};
+
+static constexpr Quantizer POSITION_X{-512.0f, 0.125f, 15}; ///< Horizontal positions, [-512, 3584) by 1/8 px
+static constexpr Quantizer POSITION_Y{-512.0f, 0.125f, 14}; ///< Vertical positions, [-512, 1536) by 1/8 px
+
+/**
+ * @brief Returns the number of bits writeVarUint() uses for a value.
+ * @param value The value.
+ * @return uint32_t 8 bits per started group of 7 value bits.
+ */
+inline uint32_t varUintBits(uint32_t value)
+{
+    uint32_t groups = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++groups;
+    }
+    return groups * 8;
+}
+
+/**
+ * @class BitWriter
+ * @brief Appends bit fields to a caller-provided buffer, least significant bit first.
+ *
+ * Bits gather in a 64-bit scratch word and are stored a byte at a time.
+ * Writing past the capacity sets overflowed() and drops the extra bits, so a
+ * caller can write a whole entry and check once.
+ */
+class BitWriter {
+public:
+    /**
+     * @brief Construct a new BitWriter object.
+     * @param buffer Destination.
+     * @param capacity Size of @p buffer in bytes.
+     */
+    BitWriter(char* buffer, size_t capacity)
+        : _buffer(reinterpret_cast<uint8_t*>(buffer)), _capacity(capacity)
+    {
+    }
+
+    /**
+     * @brief Writes the low @p bits bits of @p value.
+     * @param value The value.
+     * @param bits Number of bits, 1 to 32.
+     */
+    void writeBits(uint32_t value, uint32_t bits)
+    {
+        if (bits < 32)
+            value &= (uint32_t{1} << bits) - 1;
+        _scratch |= static_cast<uint64_t>(value) << _scratchBits;
+        _scratchBits += bits;
+        while (_scratchBits >= 8) {
+            put(static_cast<uint8_t>(_scratch));
+            _scratch >>= 8;
+            _scratchBits -= 8;
+        }
+    }
+
+    /**
+     * @brief Writes an unsigned value in groups of 7 bits, each preceded by a continuation bit.
+     * @param value The value, small values take fewer bits.
+     */
+    void writeVarUint(uint32_t value)
+    {
+        while (value >= 0x80) {
+            writeBits(((value & 0x7F) << 1) | 1, 8);
+            value >>= 7;
+        }
+        writeBits(value << 1, 8);
+    }
+
+    /**
+     * @brief Writes a value quantized with @p quantizer.
+     * @param value The value.
+     * @param quantizer The field layout.
+     */
+    void writeQuantized(float value, const Quantizer& quantizer) { writeBits(quantizer.quantize(value), quantizer.bits); }
+
+    /**
+     * @brief Stores the pending bits, padding the last byte with zeros.
+     * @return size_t Number of bytes written to the buffer.
+     */
+    size_t finish()
+    {
+        if (_scratchBits > 0) {
+            put(static_cast<uint8_t>(_scratch));
+            _scratch = 0;
+            _scratchBits = 0;
+        }
+        return _bytes;
+    }
+
+    /**
+     * @brief Returns the number of bits written so far.
+     * @return size_t The bits, including the ones not stored yet.
+     */
+    size_t bitsWritten() const { return _bytes * 8 + _scratchBits; }
+
+    /**
+     * @brief Returns the number of bits that still fit.
+     * @return size_t The bits.
+     */
+    size_t bitsLeft() const { return _capacity * 8 - std::min(bitsWritten(), _capacity * 8); }
+
+    /**
+     * @brief Tells whether bits were dropped because the buffer was full.
+     * @return true if the output is truncated.
+     */
+    bool overflowed() const { return _overflow; }
+
+private:
+    void put(uint8_t byte)
+    {
+        if (_bytes < _capacity)
+            _buffer[_bytes++] = byte;
+        else
+            _overflow = true;
+    }
+
+    uint8_t* _buffer;          ///< Destination
+    size_t _capacity;          ///< Size of _buffer
+    size_t _bytes = 0;         ///< Bytes stored
+    uint64_t _scratch = 0;     ///< Bits not stored yet
+    uint32_t _scratchBits = 0; ///< Number of bits in _scratch
+    bool _overflow = false;    ///< Set when a byte did not fit
+};
+
+/**
+ * @class BitReader
+ * @brief Reads the fields written by a BitWriter.
+ *
+ * Reading past the end returns zeros and sets an error flag that stays set,
+ * so a decoder can read a whole entry and check ok() once.
+ */
+class BitReader {
+public:
+    /**
+     * @brief Construct a new BitReader object.
+     * @param data Start of the stream.
+     * @param size Readable bytes at @p data.
+     */
+    BitReader(const char* data, size_t size)
+        : _data(reinterpret_cast<const uint8_t*>(data)), _size(size)
+    {
+    }
+
+    /**
+     * @brief Reads a field of @p bits bits.
+     * @param bits Number of bits, 1 to 32.
+     * @return uint32_t The field, 0 past the end of the stream.
+     */
+    uint32_t readBits(uint32_t bits)
+    {
+        while (_scratchBits < bits) {
+            if (_bytes == _size) {
+                _error = true;
+                return 0;
+            }
+            _scratch |= static_cast<uint64_t>(_data[_bytes++]) << _scratchBits;
+            _scratchBits += 8;
+        }
+        uint32_t value = static_cast<uint32_t>(_scratch & ((uint64_t{1} << bits) - 1));
+        _scratch >>= bits;
+        _scratchBits -= bits;
+        return value;
+    }
+
+    /**
+     * @brief Reads a value written by BitWriter::writeVarUint().
+     * @return uint32_t The value. Sets the error flag if it has more than 5 groups.
+     */
+    uint32_t readVarUint()
+    {
+        uint32_t value = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7) {
+            uint32_t group = readBits(8);
+            value |= (group >> 1) << shift;
+            if ((group & 1) == 0)
+                return value;
+        }
+        _error = true;
+        return 0;
+    }
+
+    /**
+     * @brief Reads a value written by BitWriter::writeQuantized().
+     * @param quantizer The field layout.
+     * @return float The value.
+     */
+    float readQuantized(const Quantizer& quantizer) { return quantizer.dequantize(readBits(quantizer.bits)); }
+
+    /**
+     * @brief Tells whether every read so far was inside the stream.
+     * @return true if no read went past the end.
+     */
+    bool ok() const { return !_error; }
+
+private:
+    const uint8_t* _data;      ///< Start of the stream
+    size_t _size;              ///< Readable bytes
+    size_t _bytes = 0;         ///< Bytes consumed
+    uint64_t _scratch = 0;     ///< Bits consumed but not returned yet
+    uint32_t _scratchBits = 0; ///< Number of bits in _scratch
+    bool _error = false;       ///< Set when a read went past the end
+};
+
+}
+
+#endif /* !NETWORK_BITSTREAM_HPP_ */
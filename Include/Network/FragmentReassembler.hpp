@@ -0,0 +1,99 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** FragmentReassembler
+*/
+
+#ifndef NETWORK_FRAGMENTREASSEMBLER_HPP_
+#define NETWORK_FRAGMENTREASSEMBLER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Network/Protocole/ProtocoleUDP.hpp"
+
+/**
+ * @file FragmentReassembler.hpp
+ * @brief Rebuilds messages sent as FRAGMENT datagrams.
+ */
+
+namespace Network {
+
+/**
+ * @struct ReassemblyStats
+ * @brief Counters of a FragmentReassembler.
+ */
+struct ReassemblyStats {
+    uint64_t completed = 0;  ///< Messages fully rebuilt
+    uint64_t fragments = 0;  ///< Valid fragments accepted
+    uint64_t duplicates = 0; ///< Fragments received twice
+    uint64_t malformed = 0;  ///< Fragments with inconsistent headers
+    uint64_t expired = 0;    ///< Incomplete messages dropped after a timeout or evicted
+};
+
+/**
+ * @class FragmentReassembler
+ * @brief Collects fragments in a fixed set of preallocated slots.
+ *
+ * All buffers are allocated once at construction, so receiving a fragment
+ * never allocates. A message that is not complete after TIMEOUT_MS, or whose
+ * slot is needed for a newer message, is dropped.
+ */
+class FragmentReassembler {
+    public:
+        static constexpr size_t SLOT_COUNT = 8;      ///< Messages that can be rebuilt at the same time
+        static constexpr uint32_t TIMEOUT_MS = 500;  ///< Lifetime of an incomplete message
+
+        FragmentReassembler();
+
+        /**
+         * @brief Stores a fragment.
+         * @param data Pointer to the FRAGMENT message, starting with its type byte.
+         * @param size Number of readable bytes at @p data.
+         * @param nowMs Current time in milliseconds, used for timeouts.
+         * @return std::span<const char> The rebuilt message if this fragment completed it,
+         * an empty span otherwise. The span stays valid until the next call.
+         */
+        std::span<const char> push(const char* data, size_t size, uint32_t nowMs);
+
+        /**
+         * @brief Returns the reassembly counters.
+         * @return const ReassemblyStats& The counters.
+         */
+        const ReassemblyStats& getStats() const { return _stats; }
+
+    private:
+        /**
+         * @struct Slot
+         * @brief State of one message being rebuilt.
+         */
+        struct Slot {
+            bool active = false;        ///< Whether the slot holds an incomplete message
+            uint16_t messageId = 0;     ///< Id of the message
+            uint16_t totalSize = 0;     ///< Size of the whole message
+            uint8_t fragmentCount = 0;  ///< Expected fragments
+            uint8_t received = 0;       ///< Fragments already stored
+            uint32_t receivedMask = 0;  ///< Bit i set when fragment i was stored
+            uint32_t startedMs = 0;     ///< Time of the first fragment
+        };
+
+        /**
+         * @brief Finds the slot of a message, or claims one for it.
+         * @param messageId The message id.
+         * @param nowMs Current time in milliseconds.
+         * @return size_t Index of the slot.
+         */
+        size_t slotFor(uint16_t messageId, uint32_t nowMs);
+
+        std::array<Slot, SLOT_COUNT> _slots; ///< Reassembly states
+        std::vector<char> _buffers;          ///< SLOT_COUNT message buffers of MAX_FRAGMENTED_MESSAGE_SIZE bytes
+        ReassemblyStats _stats;              ///< Counters
+};
+
+}
+
+#endif /* !NETWORK_FRAGMENTREASSEMBLER_HPP_ */
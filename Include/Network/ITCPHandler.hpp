@@ -51,7 +51,7 @@ public:
      */
     virtual int onCreateRoom() = 0;
 
-    virtual bool onJoinRoom(int roomId, uint32_t playerId, const std::string& username) = 0;
+    virtual bool onJoinRoom(int roomId, uint32_t playerId, const std::string& username, uint8_t protocolVersion) = 0;
 
     virtual void onGetLobbyState(int roomId, uint32_t& hostId, std::vector<std::pair<uint32_t, std::string>>& players) = 0;
 
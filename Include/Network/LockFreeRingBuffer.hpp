@@ -0,0 +1,200 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** LockFreeRingBuffer
+*/
+
+#ifndef NETWORK_LOCKFREERINGBUFFER_HPP_
+#define NETWORK_LOCKFREERINGBUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+/**
+ * @file LockFreeRingBuffer.hpp
+ * @brief Lock-free bounded multi-producer / single-consumer circular buffer.
+ */
+
+namespace Network {
+
+/**
+ * @brief Size used to pad the shared indices so producers and the consumer
+ * never write to the same cache line.
+ */
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @class LockFreeRingBuffer
+ * @brief A lock-free fixed-size circular buffer (MPSC).
+ *
+ * Any number of threads may push concurrently, but only one thread may pop.
+ * Every slot carries a sequence number telling whether it is free for the
+ * current lap or holds a published item, so producers only contend on a single
+ * CAS of the tail index and the consumer never takes a lock.
+ * The interface mirrors Network::RingBuffer so both can be swapped freely.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam Capacity Maximum number of elements (must be a power of two, default 1024).
+ */
+template<typename T, size_t Capacity = 1024>
+class LockFreeRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        LockFreeRingBuffer() : _head(0), _tail(0)
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        ~LockFreeRingBuffer() = default;
+
+        LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+        LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+        /**
+         * @brief Pushes an item into the buffer. Safe to call from several threads.
+         * @param item The item to add.
+         * @return true if added successfully, false if the buffer is full.
+         */
+        bool push(const T& item) {
+            return push_n(&item, 1) == 1;
+        }
+
+        /**
+         * @brief Pushes up to @p count items, reserving the slots with a single CAS.
+         * Items are pushed in order; if the buffer fills up only a prefix is pushed.
+         * @param items Pointer to the first item to add.
+         * @param count Number of items to add.
+         * @return size_t Number of items actually pushed.
+         */
+        size_t push_n(const T* items, size_t count) {
+            if (count == 0)
+                return 0;
+            size_t pos = _tail.load(std::memory_order_relaxed);
+            size_t reserved = 0;
+
+            while (true) {
+                reserved = 0;
+                while (reserved < count && reserved < Capacity) {
+                    size_t seq = _slots[(pos + reserved) & MASK].sequence.load(std::memory_order_acquire);
+                    if (seq != pos + reserved)
+                        break;
+                    ++reserved;
+                }
+                if (reserved == 0) {
+                    size_t seq = _slots[pos & MASK].sequence.load(std::memory_order_acquire);
+                    if (static_cast<std::ptrdiff_t>(seq - pos) < 0)
+                        return 0;
+                    pos = _tail.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (_tail.compare_exchange_weak(pos, pos + reserved, std::memory_order_relaxed))
+                    break;
+            }
+
+            for (size_t i = 0; i < reserved; ++i) {
+                Slot& slot = _slots[(pos + i) & MASK];
+                slot.value = items[i];
+                slot.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return reserved;
+        }
+
+        /**
+         * @brief Pops an item from the buffer. Must only be called by the consumer thread.
+         * @return std::optional<T> The item if available, or std::nullopt if empty.
+         */
+        std::optional<T> pop() {
+            size_t pos = _head.load(std::memory_order_relaxed);
+            Slot& slot = _slots[pos & MASK];
+
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+                return std::nullopt;
+            std::optional<T> item(slot.value);
+            slot.sequence.store(pos + Capacity, std::memory_order_release);
+            _head.store(pos + 1, std::memory_order_release);
+            return item;
+        }
+
+        /**
+         * @brief Pops up to @p max items into @p out. Must only be called by the consumer thread.
+         * @param out Destination array, must hold at least @p max elements.
+         * @param max Maximum number of items to pop.
+         * @return size_t Number of items actually popped.
+         */
+        size_t pop_n(T* out, size_t max) {
+            size_t pos = _head.load(std::memory_order_relaxed);
+            size_t popped = 0;
+
+            while (popped < max) {
+                Slot& slot = _slots[(pos + popped) & MASK];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + popped + 1)
+                    break;
+                out[popped] = slot.value;
+                slot.sequence.store(pos + popped + Capacity, std::memory_order_release);
+                ++popped;
+            }
+            if (popped)
+                _head.store(pos + popped, std::memory_order_release);
+            return popped;
+        }
+
+        /**
+         * @brief Checks if the buffer is empty.
+         * The result is only a snapshot when producers are running concurrently.
+         * @return true if empty, false otherwise.
+         */
+        bool isEmpty() const {
+            return count() == 0;
+        }
+
+        /**
+         * @brief Checks if the buffer is full.
+         * The result is only a snapshot when other threads are running concurrently.
+         * @return true if full, false otherwise.
+         */
+        bool isFull() const {
+            return count() >= Capacity;
+        }
+
+        /**
+         * @brief Returns the current number of reserved elements in the buffer.
+         * @return size_t Number of elements.
+         */
+        size_t count() const {
+            size_t head = _head.load(std::memory_order_acquire);
+            size_t tail = _tail.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        /**
+         * @brief Returns the capacity of the buffer.
+         * @return constexpr size_t The fixed capacity.
+         */
+        static constexpr size_t capacity() {
+            return Capacity;
+        }
+    protected:
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        /**
+         * @struct Slot
+         * @brief A buffer cell and its lap sequence number.
+         */
+        struct Slot {
+            std::atomic<size_t> sequence; ///< pos when free, pos + 1 when published
+            T value;                      ///< Stored item
+        };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head; ///< Next position to pop (consumer only)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail; ///< Next position to reserve (producers)
+        alignas(CACHE_LINE_SIZE) std::array<Slot, Capacity> _slots;
+};
+
+}
+
+#endif /* !NETWORK_LOCKFREERINGBUFFER_HPP_ */
@@ -0,0 +1,41 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Log
+*/
+
+#ifndef NETWORK_LOG_HPP_
+#define NETWORK_LOG_HPP_
+
+#include <ostream>
+
+/**
+ * @file Log.hpp
+ * @brief Switch for the informational output of the network classes.
+ *
+ * TCPServer, UDPServer, TCPClient and MetricsExporter write their progress
+ * lines to log() instead of std::cout, so tools that run them by the
+ * thousand, such as the load generator and the benchmarks, can turn them off
+ * without redirecting std::cout under running threads. Errors still go to
+ * std::cerr.
+ */
+
+namespace Network {
+
+/**
+ * @brief Enables or disables log(). Safe to call from any thread; enabled by default.
+ * @param enabled Whether log() writes to std::cout.
+ */
+void setLogEnabled(bool enabled);
+
+/**
+ * @brief Stream for informational output.
+ * @return std::ostream& std::cout when logging is enabled, otherwise a stream of the
+ * calling thread that discards everything.
+ */
+std::ostream& log();
+
+}
+
+#endif /* !NETWORK_LOG_HPP_ */
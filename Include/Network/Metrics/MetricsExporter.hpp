@@ -0,0 +1,80 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** MetricsExporter
+*/
+
+#ifndef NETWORK_METRICSEXPORTER_HPP_
+#define NETWORK_METRICSEXPORTER_HPP_
+
+#include <atomic>
+#include <thread>
+#include "Client/Asio.hpp"
+#include "Network/Metrics/MetricsRegistry.hpp"
+
+/**
+ * @file MetricsExporter.hpp
+ * @brief Minimal HTTP endpoint serving a MetricsRegistry to Prometheus.
+ */
+
+namespace Network {
+
+/**
+ * @class MetricsExporter
+ * @brief Serves GET /metrics on a loopback port.
+ *
+ * One thread runs its own io_context, so scrapes never touch the game or
+ * lobby threads: each request reads the headers, renders the registry and
+ * closes the connection (HTTP/1.0). Any other path answers 404.
+ */
+class MetricsExporter {
+public:
+    static constexpr unsigned short DEFAULT_PORT = 9100; /**< Port used when none is configured */
+    static constexpr size_t MAX_REQUEST_SIZE = 8192; /**< Larger request headers are rejected */
+
+    /**
+     * @brief Construct a new MetricsExporter object.
+     * @param registry The metrics served, must outlive the exporter.
+     * @param port Port to listen on, on 127.0.0.1, 0 for an ephemeral port.
+     */
+    MetricsExporter(const MetricsRegistry& registry, unsigned short port);
+
+    /**
+     * @brief Destroy the MetricsExporter object. Stops it.
+     */
+    ~MetricsExporter();
+
+    /**
+     * @brief Binds the port and starts the exporter thread.
+     * @return true if listening, false if the port could not be bound.
+     */
+    bool start();
+
+    /**
+     * @brief Closes the listener and joins the exporter thread.
+     */
+    void stop();
+
+    /**
+     * @brief Returns the port the exporter listens on.
+     * @return unsigned short The port, useful when constructed with port 0.
+     */
+    unsigned short getPort() const;
+
+private:
+    class Connection;
+
+    void startAccept();
+
+    const MetricsRegistry& _registry; /**< Metrics rendered for each scrape */
+    unsigned short _port; /**< Requested port */
+    asio::io_context _io_context; /**< Runs the acceptor and the connections */
+    asio::ip::tcp::acceptor _acceptor; /**< Listens on 127.0.0.1 */
+    std::thread _thread; /**< Runs _io_context */
+    std::atomic<bool> _running{false};
+};
+
+}
+
+#endif /* !NETWORK_METRICSEXPORTER_HPP_ */
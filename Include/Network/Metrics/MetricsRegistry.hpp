@@ -0,0 +1,135 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** MetricsRegistry
+*/
+
+#ifndef NETWORK_METRICSREGISTRY_HPP_
+#define NETWORK_METRICSREGISTRY_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file MetricsRegistry.hpp
+ * @brief Named counters and gauges rendered in the Prometheus text format.
+ */
+
+namespace Network {
+
+/**
+ * @class Counter
+ * @brief Monotonic counter, incremented with a relaxed atomic add.
+ */
+class Counter {
+public:
+    void add(uint64_t amount = 1) { _value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> _value{0};
+};
+
+/**
+ * @class Gauge
+ * @brief Value that can go up and down.
+ */
+class Gauge {
+public:
+    void set(int64_t value) { _value.store(value, std::memory_order_relaxed); }
+    void add(int64_t amount) { _value.fetch_add(amount, std::memory_order_relaxed); }
+    int64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> _value{0};
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Set of metrics exported together.
+ *
+ * A metric is either owned by the registry (counter(), gauge()), in which
+ * case the hot path holds a reference and only pays for one relaxed atomic
+ * operation, or read through a callback at scrape time (counterFunction(),
+ * gaugeFunction()) for values that already live elsewhere, such as the UDP
+ * server counters or the number of rooms. Metrics are registered at startup;
+ * only registration and render() take the registry lock. Callbacks that share
+ * an expensive source read a snapshot taken once per scrape by onRender().
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Registers a counter owned by the registry.
+     * @param name Metric name, e.g. rtype_udp_packets_received_total.
+     * @param help One line description.
+     * @return Counter& The counter, valid as long as the registry.
+     */
+    Counter& counter(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a gauge owned by the registry.
+     * @param name Metric name.
+     * @param help One line description.
+     * @return Gauge& The gauge, valid as long as the registry.
+     */
+    Gauge& gauge(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a counter whose value is read when the metrics are rendered.
+     * @param name Metric name.
+     * @param help One line description.
+     * @param read Returns the current value. Called from the exporter thread.
+     * @param labels Optional label set without braces, e.g. type="ping". Series of the
+     * same metric must be registered one after the other.
+     */
+    void counterFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                         const std::string& labels = "");
+
+    /**
+     * @brief Registers a gauge whose value is read when the metrics are rendered.
+     * @param name Metric name.
+     * @param help One line description.
+     * @param read Returns the current value. Called from the exporter thread.
+     * @param labels Optional label set without braces, as for counterFunction().
+     */
+    void gaugeFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                       const std::string& labels = "");
+
+    /**
+     * @brief Sets the function called at the start of each render(), before any metric is read.
+     * @param refresh Fills the values the callbacks read. Runs under the registry lock, so
+     * those values need no other synchronisation as long as only the callbacks read them.
+     */
+    void onRender(std::function<void()> refresh);
+
+    /**
+     * @brief Renders every metric in the Prometheus text exposition format.
+     * @return std::string The HELP, TYPE and sample lines of each metric.
+     */
+    std::string render() const;
+
+private:
+    struct Metric {
+        std::string name;
+        std::string help;
+        const char* type;
+        std::function<double()> read;
+        std::string labels;
+    };
+
+    mutable std::mutex _mutex; /**< Protects _metrics and the owned metric lists */
+    std::vector<Metric> _metrics; /**< In registration order */
+    std::function<void()> _refresh; /**< Called at the start of render(), may be empty */
+    std::deque<Counter> _counters; /**< Owned counters, a deque so references stay valid */
+    std::deque<Gauge> _gauges; /**< Owned gauges */
+};
+
+}
+
+#endif /* !NETWORK_METRICSREGISTRY_HPP_ */
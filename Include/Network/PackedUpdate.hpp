@@ -0,0 +1,95 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** PackedUpdate
+*/
+
+#ifndef NETWORK_PACKEDUPDATE_HPP_
+#define NETWORK_PACKEDUPDATE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Network/Protocole/ProtocoleUDP.hpp"
+
+/**
+ * @file PackedUpdate.hpp
+ * @brief ENTITY_UPDATE_PACKED encoding, several quantized entity positions per message.
+ */
+
+namespace Network {
+
+/**
+ * @brief Returns the bits one entity takes in an ENTITY_UPDATE_PACKED message.
+ * @param entityId The entity.
+ * @return uint32_t The bits of its id and quantized position.
+ */
+uint32_t packedUpdateBits(uint32_t entityId);
+
+/**
+ * @class PackedUpdateSizer
+ * @brief Predicts the bytes of the ENTITY_UPDATE_PACKED messages that encodeEntityUpdates()
+ * makes of a list of updates, split at the same points for the same capacity.
+ *
+ * Lets a sender charge each update against a bandwidth budget before encoding,
+ * including the type byte and count of every message the list is split into.
+ */
+class PackedUpdateSizer {
+public:
+    /**
+     * @param capacity Message capacity later given to encodeEntityUpdates().
+     */
+    explicit PackedUpdateSizer(size_t capacity);
+
+    /**
+     * @brief Returns the bytes an update would add after the updates already added.
+     * @param entityId The entity.
+     * @return size_t The whole bytes it adds to the last message, or the size of a new
+     * message holding only it, type byte and count included, when it does not fit.
+     */
+    size_t cost(uint32_t entityId) const;
+
+    /**
+     * @brief Appends an update.
+     * @param entityId The entity.
+     */
+    void add(uint32_t entityId);
+
+private:
+    /**
+     * @return size_t Bits after the type byte of the last message once @p entityId is in it,
+     * 0 when it has to start a new message.
+     */
+    size_t grownBits(uint32_t entityId) const;
+
+    size_t _bitsLeft; /**< Bits available after the type byte */
+    size_t _bits = 0; /**< Bits of the last message after its type byte, count included */
+    uint32_t _count = 0; /**< Updates in the last message */
+};
+
+/**
+ * @brief Encodes as many updates as fit in one ENTITY_UPDATE_PACKED message.
+ * The timestamp of the updates is not carried.
+ * @param updates Updates to encode, in any order.
+ * @param count Number of updates at @p updates.
+ * @param out Destination buffer.
+ * @param capacity Size of @p out in bytes.
+ * @param encoded Receives the number of updates written, from the start of @p updates.
+ * @return size_t Number of bytes written to @p out, 0 if not even one update fits.
+ */
+size_t encodeEntityUpdates(const EntityUpdatePacket* updates, size_t count, char* out, size_t capacity, size_t& encoded);
+
+/**
+ * @brief Decodes an ENTITY_UPDATE_PACKED message.
+ * @param data Pointer to the message, starting with its type byte.
+ * @param size Number of readable bytes at @p data.
+ * @param out Receives the updates, with quantized positions and a 0 timestamp.
+ * @return true on success, false if the message is malformed.
+ */
+bool decodeEntityUpdates(const char* data, size_t size, std::vector<EntityUpdatePacket>& out);
+
+}
+
+#endif /* !NETWORK_PACKEDUPDATE_HPP_ */
@@ -0,0 +1,149 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** PacketPool
+*/
+
+#ifndef NETWORK_PACKETPOOL_HPP_
+#define NETWORK_PACKETPOOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Network/LockFreeRingBuffer.hpp"
+#include "Network/Packet.hpp"
+
+/**
+ * @file PacketPool.hpp
+ * @brief Fixed-size slab of Packet buffers handed out and returned without allocating.
+ */
+
+namespace Network {
+
+/**
+ * @struct PacketPoolStats
+ * @brief Snapshot of the counters of a PacketPool.
+ */
+struct PacketPoolStats {
+    size_t capacity = 0;    ///< Packets in the slab
+    size_t inUse = 0;       ///< Packets acquired and not released yet
+    uint64_t acquired = 0;  ///< Successful acquire() calls
+    uint64_t exhausted = 0; ///< acquire() calls that found the pool empty
+};
+
+/**
+ * @class PacketPool
+ * @brief Lock-free pool of Packet buffers allocated once, at construction.
+ *
+ * Free packets form a stack threaded through an index array; the head packs
+ * a 32-bit index with a 32-bit tag bumped on every change, so a packet popped
+ * and pushed back between a thread's load and its CAS cannot be mistaken for
+ * an unchanged head (ABA). Any thread may acquire or release.
+ *
+ * A packet belongs to whoever acquired it until it is released: ring buffers
+ * carry Packet pointers instead of copying the 1 KB structure, and the thread
+ * that consumes a packet last releases it.
+ */
+class PacketPool {
+    public:
+        /**
+         * @brief Allocates the slab.
+         * @param capacity Number of packets, below 2^32 - 1.
+         */
+        explicit PacketPool(size_t capacity)
+            : _slab(std::make_unique<Packet[]>(capacity)),
+              _next(std::make_unique<std::atomic<uint32_t>[]>(capacity)),
+              _capacity(capacity)
+        {
+            for (size_t i = 0; i < capacity; ++i)
+                _next[i].store(i + 1 < capacity ? static_cast<uint32_t>(i + 1) : NONE, std::memory_order_relaxed);
+            _head.store(capacity > 0 ? 0 : NONE, std::memory_order_relaxed);
+        }
+        ~PacketPool() = default;
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        /**
+         * @brief Takes a free packet. Safe to call from several threads.
+         * The packet keeps whatever an earlier owner left in it.
+         * @return Packet* The packet, or nullptr if every packet is in use.
+         */
+        Packet* acquire()
+        {
+            uint64_t head = _head.load(std::memory_order_acquire);
+            while (true) {
+                uint32_t index = static_cast<uint32_t>(head);
+                if (index == NONE) {
+                    _exhausted.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                uint64_t next = nextTag(head) | _next[index].load(std::memory_order_relaxed);
+                if (_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+                    _acquired.fetch_add(1, std::memory_order_relaxed);
+                    return &_slab[index];
+                }
+            }
+        }
+
+        /**
+         * @brief Gives a packet back. Safe to call from several threads.
+         * @param pkt A packet acquired from this pool and not released since.
+         */
+        void release(Packet* pkt)
+        {
+            auto index = static_cast<uint32_t>(pkt - _slab.get());
+            uint64_t head = _head.load(std::memory_order_relaxed);
+            do {
+                _next[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            } while (!_head.compare_exchange_weak(head, nextTag(head) | index, std::memory_order_release, std::memory_order_relaxed));
+            _released.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns a snapshot of the counters.
+         * @return PacketPoolStats The current counters.
+         */
+        PacketPoolStats getStats() const
+        {
+            PacketPoolStats stats;
+            stats.capacity = _capacity;
+            stats.acquired = _acquired.load(std::memory_order_relaxed);
+            stats.exhausted = _exhausted.load(std::memory_order_relaxed);
+            uint64_t released = _released.load(std::memory_order_relaxed);
+            stats.inUse = stats.acquired > released ? static_cast<size_t>(stats.acquired - released) : 0;
+            return stats;
+        }
+
+        /**
+         * @brief Tells whether every packet is in use.
+         * @return true if acquire() would currently fail.
+         */
+        bool empty() const { return static_cast<uint32_t>(_head.load(std::memory_order_acquire)) == NONE; }
+
+        /**
+         * @brief Returns the number of packets in the slab.
+         * @return size_t The capacity.
+         */
+        size_t capacity() const { return _capacity; }
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX; ///< Index marking the end of the free stack
+
+        static uint64_t nextTag(uint64_t head) { return ((head >> 32) + 1) << 32; }
+
+        std::unique_ptr<Packet[]> _slab;                  ///< The packets
+        std::unique_ptr<std::atomic<uint32_t>[]> _next;   ///< Next free index, for free packets
+        size_t _capacity;                                 ///< Packets in _slab
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _head; ///< Tag << 32 | index of the first free packet
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _acquired{0}; ///< Successful acquires
+        std::atomic<uint64_t> _released{0};               ///< Releases
+        std::atomic<uint64_t> _exhausted{0};              ///< Acquires that found no packet
+};
+
+}
+
+#endif /* !NETWORK_PACKETPOOL_HPP_ */
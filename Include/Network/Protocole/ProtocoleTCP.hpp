@@ -25,6 +25,11 @@
 // -----------------------------------------
 #pragma pack(push, 1)
 
+static constexpr uint8_t PROTOCOL_VERSION_LEGACY = 1; // Raw structures, floats and 32-bit ids
+static constexpr uint8_t PROTOCOL_VERSION_PACKED = 2; // Bit-packed entity updates and snapshots
+static constexpr uint8_t PROTOCOL_VERSION_RELIABLE = 3; // Critical events on the reliable-ordered channel
+static constexpr uint8_t PROTOCOL_VERSION = PROTOCOL_VERSION_RELIABLE; // Latest version this build speaks
+
 /**
  * @enum TCPMessageType
  * @brief Identifies the type of each TCP packet.
@@ -43,20 +48,29 @@ enum TCPMessageType : uint8_t {
     LOBBY_STATE_RESPONSE = 11,
     START_GAME_REQUEST = 12,
     GAME_STARTING_NOTIFICATION = 13,
-    CHAT_MESSAGE = 14
+    CHAT_MESSAGE = 14,
+    ROOM_UPDATE = 15,
+    ROOM_REMOVED = 16,
+    CONNECT_VERSIONED = 17
 };
 
 /**
  * @struct ConnectRequest
  * @brief Sent by the client to request a connection to the server.
  *
+ * Clients from before protocol negotiation send type CONNECT without the
+ * protocolVersion byte; they get a ConnectResponse without it as well and
+ * speak PROTOCOL_VERSION_LEGACY. Current clients send CONNECT_VERSIONED.
+ *
  * Fields:
- * - type: Packet type identifier
+ * - type: Packet type identifier (CONNECT_VERSIONED, or CONNECT for a legacy client)
  * - username: Null-terminated username of the player (max 31 chars)
+ * - protocolVersion: Highest UDP protocol version the client understands
  */
 struct ConnectRequest {
-    uint8_t type = TCPMessageType::CONNECT;     ///< Packet type identifier
+    uint8_t type = TCPMessageType::CONNECT_VERSIONED; ///< Packet type identifier
     char username[32];    ///< Player username
+    uint8_t protocolVersion = PROTOCOL_VERSION; ///< Latest UDP protocol version the client speaks
 };
 
 /**
@@ -67,12 +81,15 @@ struct ConnectRequest {
  * - type: Packet type identifier
  * - playerId: Unique identifier assigned to the player
  * - udpPort: UDP port number assigned for gameplay communication
+ * - protocolVersion: min(client version, server version), used for the whole session.
+ *   Only sent in reply to CONNECT_VERSIONED.
  */
 struct ConnectResponse {
     uint8_t type = TCPMessageType::CONNECT_OK;     ///< Packet type identifier
     uint32_t playerId;    ///< Unique player ID
     uint16_t udpPort;     ///< Assigned UDP port for gameplay
     uint32_t serverTimeMs; ///< Server time in milliseconds for synchronization
+    uint8_t protocolVersion = PROTOCOL_VERSION_LEGACY; ///< UDP protocol version the server will use
 };
 
 /**
@@ -198,6 +215,26 @@ struct GameStartingNotification {
     uint8_t type = TCPMessageType::GAME_STARTING_NOTIFICATION; ///< Packet type identifier.
 };
 
+/**
+ * @struct RoomUpdateNotification
+ * @brief Pushed to lobby clients when a room is created or its player count changes.
+ *
+ * Only sent to clients that are not in a room and already sent a LIST_ROOMS.
+ */
+struct RoomUpdateNotification {
+    uint8_t type = TCPMessageType::ROOM_UPDATE; ///< Packet type identifier.
+    RoomInfo room; ///< New state of the room.
+};
+
+/**
+ * @struct RoomRemovedNotification
+ * @brief Pushed to lobby clients when a room is deleted.
+ */
+struct RoomRemovedNotification {
+    uint8_t type = TCPMessageType::ROOM_REMOVED; ///< Packet type identifier.
+    int32_t roomId; ///< The ID of the deleted room.
+};
+
 
 // Restore default packing
 #pragma pack(pop)
@@ -12,6 +12,7 @@
 #ifndef PROTOCOLEUDP_HPP_
 #define PROTOCOLEUDP_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -58,7 +59,14 @@ enum UDPMessageType : uint8_t {
     PLAYER_DISCONNECT = 8,  ///< Sent by client: player is disconnecting
     GLOBAL_STATE_SYNC = 9,   ///< Sent by server: full game state synchrnization
     YOU_HAVE_BEEN_KICKED = 10,
-    BOSS_STATE        = 11  ///< Sent by server: update boss HP
+    BOSS_STATE        = 11, ///< Sent by server: update boss HP
+    BUNDLE            = 12, ///< Sent by server: several messages packed in one datagram
+    SNAPSHOT          = 13, ///< Sent by server: entity snapshot, delta-encoded against an acknowledged one
+    SNAPSHOT_ACK      = 14, ///< Sent by client: acknowledges the last snapshot applied
+    FRAGMENT          = 15, ///< Sent by server: one piece of a message larger than MAX_UDP_PACKET_SIZE
+    ENTITY_UPDATE_PACKED = 16, ///< Sent by server (protocol 2): bit-packed positions of several entities
+    SNAPSHOT_PACKED   = 17, ///< Sent by server (protocol 2): SNAPSHOT with a bit-packed body
+    RELIABLE          = 18  ///< Sent by server (protocol 3): a message of the reliable-ordered channel
 };
 
 /**
@@ -70,14 +78,22 @@ enum UDPMessageType : uint8_t {
  * - playerId: Player identifier assigned by TCP handshake
  * - tick: Increasing counter used to help server detect late packets
  * - inputs: A bitmask representing all player actions (up, down, left, right, shoot).
+ * - reliableAck / reliableAckBits: Acknowledgement of the RELIABLE messages (protocol 3).
+ *
+ * Clients that negotiated protocol 1 or 2 send only the first
+ * LEGACY_PLAYER_INPUT_SIZE bytes.
  */
 struct PlayerInputPacket {
     uint8_t type = PLAYER_INPUT; ///< Packet type (PLAYER_INPUT)
     uint32_t playerId;           ///< Player identifier
     uint32_t tick;               ///< Input tick counter
     uint8_t inputs;              ///< Bitmask of actions (Input enum)
+    uint16_t reliableAck = 0;    ///< Sequence of the next RELIABLE message expected, all earlier ones were received
+    uint32_t reliableAckBits = 0; ///< Bit i set if the RELIABLE message reliableAck + 1 + i was received
 };
 
+static constexpr size_t LEGACY_PLAYER_INPUT_SIZE = offsetof(PlayerInputPacket, reliableAck); // PLAYER_INPUT size before protocol 3
+
 /**
  * @struct PlayerStatePacket
  * @brief Sent by the server to update the player's authoritative state.
@@ -207,6 +223,48 @@ struct GlobalStateSyncPacket {
     uint32_t entityCount;              ///< Number of entities included in this packet
 };
 
+/**
+ * @struct SnapshotPacket
+ * @brief Sent by the server to synchronize the entity set, replacing GLOBAL_STATE_SYNC.
+ *
+ * When baselineId is 0 the snapshot is full: the client's entity set is
+ * replaced by the changed entries. Otherwise the client starts from the
+ * snapshot baselineId, drops the removed ids and adds/overwrites the changed
+ * entries. The header is followed by `removedCount` uint32_t entity ids, then
+ * `changedCount` SyncedEntityState structures.
+ */
+struct SnapshotPacket {
+    uint8_t type = SNAPSHOT;  ///< Packet type (SNAPSHOT)
+    uint32_t snapshotId;      ///< Id of this snapshot (starts at 1)
+    uint32_t baselineId;      ///< Id of the snapshot this delta applies to, 0 for a full snapshot
+    uint16_t removedCount;    ///< Number of removed entity ids that follow
+    uint16_t changedCount;    ///< Number of added or changed entity states that follow
+};
+
+/**
+ * Bit-packed messages (protocol version 2)
+ *
+ * ENTITY_UPDATE_PACKED is the type byte followed by a Network::BitWriter
+ * stream: a varint entry count, then for each entry a varint entity id and
+ * the position quantized with Network::POSITION_X / Network::POSITION_Y.
+ *
+ * SNAPSHOT_PACKED starts with a SnapshotPacket header (type SNAPSHOT_PACKED,
+ * same semantics) followed by a BitWriter stream: the removed ids, then the
+ * changed entities as a varint id, a varint entity type and the quantized
+ * position. Ids are ascending in both lists and each one is written as the
+ * varint difference with the previous id of its list (the first one as is).
+ */
+
+/**
+ * @struct SnapshotAckPacket
+ * @brief Sent by the client after applying a snapshot, so the server can use it as baseline.
+ */
+struct SnapshotAckPacket {
+    uint8_t type = SNAPSHOT_ACK; ///< Packet type (SNAPSHOT_ACK)
+    uint32_t playerId;           ///< Player identifier
+    uint32_t snapshotId;         ///< Last snapshot applied by the client
+};
+
 /**
  * @struct YouHaveBeenKickedPacket
  * @brief Sent by the server to a player who has been kicked from a room.
@@ -225,6 +283,62 @@ struct BossStatePacket {
     int32_t maxHp;
 };
 
+/**
+ * @struct BundleHeader
+ * @brief Header of a datagram carrying several server messages.
+ *
+ * The header is followed by `messageCount` entries, each made of a
+ * BundledMessageHeader and `length` bytes holding a regular UDP message
+ * (starting with its own type byte). Bundles are never nested.
+ */
+struct BundleHeader {
+    uint8_t type = BUNDLE;   ///< Packet type (BUNDLE)
+    uint8_t messageCount;    ///< Number of messages in the bundle
+};
+
+/**
+ * @struct BundledMessageHeader
+ * @brief Length prefix of a message inside a bundle.
+ */
+struct BundledMessageHeader {
+    uint16_t length;         ///< Size of the message that follows, in bytes
+};
+
+/**
+ * @struct FragmentHeader
+ * @brief Header of one piece of a message too large for a single datagram.
+ *
+ * The message is cut into `fragmentCount` pieces of FRAGMENT_PAYLOAD_SIZE
+ * bytes (the last one holds the remainder). Each piece is sent after this
+ * header. The receiver rebuilds the message once all pieces with the same
+ * messageId have arrived, in any order.
+ */
+struct FragmentHeader {
+    uint8_t type = FRAGMENT; ///< Packet type (FRAGMENT)
+    uint16_t messageId;      ///< Identifies the fragmented message, wraps around
+    uint16_t totalSize;      ///< Size of the whole message, in bytes
+    uint8_t fragmentIndex;   ///< Position of this piece, from 0
+    uint8_t fragmentCount;   ///< Number of pieces of the message
+};
+
+/**
+ * @struct ReliableHeader
+ * @brief Header of a message sent on the reliable-ordered channel (protocol 3).
+ *
+ * The header is followed by a regular UDP message (starting with its own
+ * type byte) of at most Network::MAX_RELIABLE_MESSAGE_SIZE bytes. Sequences
+ * start at 0 and wrap around. The client hands the messages to the game in
+ * sequence order and acknowledges them in every PlayerInputPacket; the server
+ * sends a message again until it is acknowledged.
+ */
+struct ReliableHeader {
+    uint8_t type = RELIABLE; ///< Packet type (RELIABLE)
+    uint16_t sequence;       ///< Position of the message on the channel
+};
+
+static constexpr size_t FRAGMENT_PAYLOAD_SIZE = MAX_UDP_PACKET_SIZE - sizeof(FragmentHeader); // Message bytes carried by each fragment
+static constexpr size_t MAX_FRAGMENT_COUNT = 16; // Maximum number of fragments per message
+static constexpr size_t MAX_FRAGMENTED_MESSAGE_SIZE = FRAGMENT_PAYLOAD_SIZE * MAX_FRAGMENT_COUNT; // Largest message that can be sent
 
 // Restore packing
 #pragma pack(pop)
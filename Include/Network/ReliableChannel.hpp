@@ -0,0 +1,282 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** ReliableChannel
+*/
+
+#ifndef NETWORK_RELIABLECHANNEL_HPP_
+#define NETWORK_RELIABLECHANNEL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+
+#include "Network/Protocole/ProtocoleUDP.hpp"
+
+/**
+ * @file ReliableChannel.hpp
+ * @brief Reliable-ordered delivery of small messages over UDP (protocol 3).
+ */
+
+namespace Network {
+
+static constexpr uint32_t RELIABLE_ACK_BITS = 32;       ///< Messages past reliableAck that a PlayerInputPacket can acknowledge
+static constexpr size_t MAX_RELIABLE_MESSAGE_SIZE = 32; ///< Largest message carried by a RELIABLE message, room for an EntitySpawnPacket
+
+/**
+ * @struct ReliableStats
+ * @brief Counters of a ReliableSender.
+ */
+struct ReliableStats {
+    uint64_t sent = 0;        ///< Messages accepted by send()
+    uint64_t retransmits = 0; ///< Transmissions after a timeout
+    uint64_t acked = 0;       ///< Messages acknowledged by the peer
+    uint64_t overflows = 0;   ///< Messages refused because MAX_PENDING were waiting
+    size_t pending = 0;       ///< Messages not acknowledged yet
+    float rttMs = 0.0f;       ///< Smoothed round-trip time, 0 before the first sample
+    float rtoMs = 0.0f;       ///< Current retransmission timeout
+};
+
+/**
+ * @class ReliableSender
+ * @brief Server end of the reliable channel of one client.
+ *
+ * Each message gets the next 16-bit sequence and is kept until the client
+ * acknowledges it. At most WINDOW messages are in flight, since the client
+ * can only buffer that many past the one it waits for; the others wait their
+ * turn. A message is sent again when it is not acknowledged within the
+ * retransmission timeout, computed from the measured round-trip time as in
+ * RFC 6298 and doubled on every retransmission of the same message. Only
+ * messages acknowledged on their first transmission give RTT samples.
+ *
+ * Not thread-safe: the owner serializes the calls.
+ */
+class ReliableSender {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t WINDOW = RELIABLE_ACK_BITS + 1;            ///< Messages in flight at most
+        static constexpr size_t MAX_PENDING = 1024;                        ///< Messages kept at most, in flight or waiting
+        static constexpr std::chrono::milliseconds INITIAL_RTO{250};       ///< Timeout before the first RTT sample
+        static constexpr std::chrono::milliseconds MIN_RTO{50};            ///< Lower bound of the timeout
+        static constexpr std::chrono::milliseconds MAX_RTO{1000};          ///< Upper bound of the timeout, backoff included
+
+        /**
+         * @brief Queues a message and transmits it if the window allows.
+         * @tparam Transmit Callable taking (const char* data, size_t length).
+         * @param data The message, starting with its type byte.
+         * @param length Its size, at most MAX_RELIABLE_MESSAGE_SIZE.
+         * @param now Current time.
+         * @param transmit Sends a RELIABLE message to the client.
+         * @return false if the message is too large or MAX_PENDING messages are waiting.
+         */
+        template<typename Transmit>
+        bool send(const char* data, size_t length, Clock::time_point now, Transmit&& transmit)
+        {
+            if (length == 0 || length > MAX_RELIABLE_MESSAGE_SIZE)
+                return false;
+            if (_pending.size() >= MAX_PENDING) {
+                ++_stats.overflows;
+                return false;
+            }
+            Entry& entry = _pending.emplace_back();
+            ReliableHeader header;
+            header.sequence = _nextSequence++;
+            entry.sequence = header.sequence;
+            entry.length = static_cast<uint8_t>(sizeof(ReliableHeader) + length);
+            std::memcpy(entry.data.data(), &header, sizeof(header));
+            std::memcpy(entry.data.data() + sizeof(header), data, length);
+            ++_stats.sent;
+            if (_pending.size() <= WINDOW)
+                transmitEntry(entry, now, transmit);
+            return true;
+        }
+
+        /**
+         * @brief Sends the messages whose timeout expired and those the window now allows.
+         * @tparam Transmit Callable taking (const char* data, size_t length).
+         * @param now Current time.
+         * @param transmit Sends a RELIABLE message to the client.
+         */
+        template<typename Transmit>
+        void resend(Clock::time_point now, Transmit&& transmit)
+        {
+            size_t inFlight = std::min(_pending.size(), WINDOW);
+            for (size_t i = 0; i < inFlight; ++i) {
+                Entry& entry = _pending[i];
+                if (entry.acked)
+                    continue;
+                if (entry.transmissions == 0) {
+                    transmitEntry(entry, now, transmit);
+                } else if (now - entry.sentAt >= timeout(entry.transmissions)) {
+                    ++_stats.retransmits;
+                    transmitEntry(entry, now, transmit);
+                }
+            }
+        }
+
+        /**
+         * @brief Applies an acknowledgement received in a PlayerInputPacket.
+         * Acknowledgements older than the current one, or covering messages
+         * never transmitted, are ignored.
+         * @param ack Sequence of the next message the client waits for.
+         * @param ackBits Bit i set if message ack + 1 + i was received.
+         * @param now Current time, for RTT samples.
+         */
+        void acknowledge(uint16_t ack, uint32_t ackBits, Clock::time_point now);
+
+        /**
+         * @brief Tells whether every message was acknowledged.
+         * @return true if nothing is waiting for an acknowledgement.
+         */
+        bool idle() const { return _pending.empty(); }
+
+        /**
+         * @brief Returns the counters.
+         * @return ReliableStats The counters and the current timing estimates.
+         */
+        ReliableStats getStats() const;
+
+    private:
+        /**
+         * @struct Entry
+         * @brief A message waiting for its acknowledgement.
+         */
+        struct Entry {
+            uint16_t sequence = 0;       ///< Sequence of the message
+            uint8_t length = 0;          ///< Bytes used in data, header included
+            uint8_t transmissions = 0;   ///< Times the message was sent
+            bool acked = false;          ///< Acknowledged through ackBits, waiting for the earlier ones
+            Clock::time_point sentAt;    ///< Time of the last transmission
+            std::array<char, sizeof(ReliableHeader) + MAX_RELIABLE_MESSAGE_SIZE> data; ///< The RELIABLE message
+        };
+
+        /**
+         * @brief Sends a message and records the transmission.
+         * @param entry The message.
+         * @param now Current time.
+         * @param transmit Sends a RELIABLE message to the client.
+         */
+        template<typename Transmit>
+        void transmitEntry(Entry& entry, Clock::time_point now, Transmit& transmit)
+        {
+            transmit(entry.data.data(), static_cast<size_t>(entry.length));
+            entry.sentAt = now;
+            if (entry.transmissions < UINT8_MAX)
+                ++entry.transmissions;
+        }
+
+        /**
+         * @brief Returns how long to wait for the acknowledgement of a message.
+         * @param transmissions Times the message was already sent.
+         * @return Clock::duration The timeout, doubled for each retransmission.
+         */
+        Clock::duration timeout(uint8_t transmissions) const;
+
+        /**
+         * @brief Marks a message acknowledged, updating the RTT on its first transmission.
+         * @param entry The message.
+         * @param now Current time.
+         */
+        void markAcked(Entry& entry, Clock::time_point now);
+
+        std::deque<Entry> _pending;            ///< Unacknowledged messages, oldest first, consecutive sequences
+        uint16_t _nextSequence = 0;            ///< Sequence of the next message
+        bool _hasRtt = false;                  ///< Whether _srttMs holds a sample
+        float _srttMs = 0.0f;                  ///< Smoothed round-trip time
+        float _rttVarMs = 0.0f;                ///< Round-trip time variation
+        Clock::duration _rto = INITIAL_RTO;    ///< Retransmission timeout
+        ReliableStats _stats;                  ///< Counters
+};
+
+/**
+ * @class ReliableReceiver
+ * @brief Client end of the reliable channel.
+ *
+ * Messages are delivered once each, in sequence order. A message arriving
+ * ahead of a missing one is kept in one of RELIABLE_ACK_BITS slots until the
+ * gap is filled; later ones are dropped and will be sent again.
+ */
+class ReliableReceiver {
+    public:
+        /**
+         * @brief Accepts a RELIABLE message.
+         * @tparam Deliver Callable taking (const char* data, size_t size), called for
+         * each message that is now in order: this one and the buffered ones it unblocks.
+         * @param data Pointer to the RELIABLE message, starting with its type byte.
+         * @param size Number of readable bytes at @p data.
+         * @param deliver Handles a message.
+         * @return false if the message is malformed, a duplicate or too far ahead.
+         */
+        template<typename Deliver>
+        bool receive(const char* data, size_t size, Deliver&& deliver)
+        {
+            if (size <= sizeof(ReliableHeader) || size > sizeof(ReliableHeader) + MAX_RELIABLE_MESSAGE_SIZE)
+                return false;
+            ReliableHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            auto ahead = static_cast<int16_t>(header.sequence - _nextSequence);
+            if (ahead < 0 || ahead > static_cast<int16_t>(RELIABLE_ACK_BITS))
+                return false;
+
+            const char* payload = data + sizeof(header);
+            size_t length = size - sizeof(header);
+            if (ahead > 0) {
+                uint32_t bit = uint32_t{1} << (ahead - 1);
+                if (_received & bit)
+                    return false;
+                Slot& slot = _slots[header.sequence % RELIABLE_ACK_BITS];
+                std::memcpy(slot.data.data(), payload, length);
+                slot.length = static_cast<uint8_t>(length);
+                _received |= bit;
+                return true;
+            }
+
+            deliver(payload, length);
+            while (true) {
+                bool buffered = (_received & 1) != 0;
+                _received >>= 1;
+                ++_nextSequence;
+                if (!buffered)
+                    break;
+                const Slot& slot = _slots[_nextSequence % RELIABLE_ACK_BITS];
+                deliver(slot.data.data(), static_cast<size_t>(slot.length));
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the sequence of the next message expected, for PlayerInputPacket::reliableAck.
+         * @return uint16_t The sequence.
+         */
+        uint16_t ack() const { return _nextSequence; }
+
+        /**
+         * @brief Returns the messages received past ack(), for PlayerInputPacket::reliableAckBits.
+         * @return uint32_t Bit i set if message ack() + 1 + i was received.
+         */
+        uint32_t ackBits() const { return _received; }
+
+    private:
+        /**
+         * @struct Slot
+         * @brief A message received ahead of a missing one.
+         */
+        struct Slot {
+            uint8_t length = 0;                                  ///< Size of the message
+            std::array<char, MAX_RELIABLE_MESSAGE_SIZE> data;    ///< The message
+        };
+
+        std::array<Slot, RELIABLE_ACK_BITS> _slots; ///< Buffered messages, by sequence modulo RELIABLE_ACK_BITS
+        uint16_t _nextSequence = 0;                 ///< Sequence of the next message to deliver
+        uint32_t _received = 0;                     ///< Bit i set if message _nextSequence + 1 + i is buffered
+};
+
+}
+
+#endif /* !NETWORK_RELIABLECHANNEL_HPP_ */
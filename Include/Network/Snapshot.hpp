@@ -0,0 +1,147 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Snapshot
+*/
+
+#ifndef NETWORK_SNAPSHOT_HPP_
+#define NETWORK_SNAPSHOT_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Network/Protocole/ProtocoleUDP.hpp"
+
+/**
+ * @file Snapshot.hpp
+ * @brief Delta-compressed entity snapshots shared by the client and the server.
+ */
+
+namespace Network {
+
+/**
+ * @struct SnapshotRecord
+ * @brief The full entity set of one snapshot, as seen by one client.
+ */
+struct SnapshotRecord {
+    uint32_t id = 0;                          ///< Snapshot identifier, 0 when the slot is unused
+    std::vector<SyncedEntityState> entities;  ///< Entities sorted by entityId
+};
+
+/**
+ * @class SnapshotHistory
+ * @brief Ring buffer of the last snapshots exchanged with one peer.
+ *
+ * Snapshot ids grow by one per synchronization, so a snapshot lives in slot
+ * `id % CAPACITY` until it is overwritten CAPACITY snapshots later. Slots keep
+ * their vectors between uses so steady-state synchronization does not allocate.
+ */
+class SnapshotHistory {
+    public:
+        static constexpr size_t CAPACITY = 32; ///< Number of snapshots kept (3.2 s at 10 Hz)
+
+        /**
+         * @brief Claims the slot of a new snapshot.
+         * @param id The new snapshot id (must not be 0).
+         * @return SnapshotRecord& The slot, with its id set and its entities cleared.
+         */
+        SnapshotRecord& push(uint32_t id);
+
+        /**
+         * @brief Looks up a snapshot still held in the history.
+         * @param id The snapshot id.
+         * @return const SnapshotRecord* The snapshot, or nullptr if it was never stored or was overwritten.
+         */
+        const SnapshotRecord* find(uint32_t id) const;
+
+        /**
+         * @brief Returns the snapshot that can serve as baseline for @p nextId.
+         * The baseline is the last acknowledged snapshot, as long as storing
+         * @p nextId will not overwrite it.
+         * @param nextId The id of the snapshot about to be encoded.
+         * @return const SnapshotRecord* The baseline, or nullptr if a full snapshot is required.
+         */
+        const SnapshotRecord* baselineFor(uint32_t nextId) const;
+
+        /**
+         * @brief Records that the peer received a snapshot.
+         * Older or unknown ids are ignored.
+         * @param id The acknowledged snapshot id.
+         */
+        void acknowledge(uint32_t id);
+
+        /**
+         * @brief Returns the last acknowledged snapshot id.
+         * @return uint32_t The id, 0 if nothing was acknowledged yet.
+         */
+        uint32_t lastAcknowledged() const { return _lastAcked; }
+
+    private:
+        std::array<SnapshotRecord, CAPACITY> _records; ///< Snapshot slots
+        uint32_t _lastAcked = 0;                       ///< Last snapshot the peer acknowledged
+};
+
+/**
+ * @brief Encodes @p current as a SNAPSHOT message relative to @p baseline.
+ *
+ * Only added, changed and removed entities are written; removals go first.
+ * When the delta does not fit in @p capacity, the remaining entries are left
+ * for the next snapshot. @p view receives exactly what the client will hold
+ * after decoding, so later deltas stay correct.
+ *
+ * @param snapshotId Id of the new snapshot.
+ * @param baseline Snapshot the client already has, or nullptr for a full snapshot.
+ * @param current Current entities sorted by entityId.
+ * @param out Destination buffer.
+ * @param capacity Size of @p out in bytes.
+ * @param view Receives the entity set the client will reconstruct (sorted by entityId).
+ * @return size_t Number of bytes written to @p out.
+ */
+size_t encodeSnapshot(uint32_t snapshotId, const SnapshotRecord* baseline, const std::vector<SyncedEntityState>& current,
+    char* out, size_t capacity, std::vector<SyncedEntityState>& view);
+
+/**
+ * @brief Rebuilds the entity set of a received SNAPSHOT message.
+ * @param data Pointer to the message, starting with its type byte.
+ * @param size Number of readable bytes at @p data.
+ * @param history Snapshots already received, used to find the baseline.
+ * @param out Receives the entities of the snapshot, sorted by entityId.
+ * @return true on success, false if the message is malformed or its baseline is unknown.
+ */
+bool decodeSnapshot(const char* data, size_t size, const SnapshotHistory& history, std::vector<SyncedEntityState>& out);
+
+/**
+ * @brief Encodes @p current as a SNAPSHOT_PACKED message relative to @p baseline.
+ *
+ * Same semantics as encodeSnapshot(), with the bit-packed body described in
+ * ProtocoleUDP.hpp. Positions are compared and stored after quantization, so
+ * @p view holds the rounded positions the client decodes and an entity moving
+ * by less than a step is not resent.
+ *
+ * @param snapshotId Id of the new snapshot.
+ * @param baseline Snapshot the client already has, or nullptr for a full snapshot.
+ * @param current Current entities sorted by entityId.
+ * @param out Destination buffer.
+ * @param capacity Size of @p out in bytes.
+ * @param view Receives the entity set the client will reconstruct (sorted by entityId).
+ * @return size_t Number of bytes written to @p out.
+ */
+size_t encodeSnapshotPacked(uint32_t snapshotId, const SnapshotRecord* baseline, const std::vector<SyncedEntityState>& current,
+    char* out, size_t capacity, std::vector<SyncedEntityState>& view);
+
+/**
+ * @brief Rebuilds the entity set of a received SNAPSHOT_PACKED message.
+ * @param data Pointer to the message, starting with its type byte.
+ * @param size Number of readable bytes at @p data.
+ * @param history Snapshots already received, used to find the baseline.
+ * @param out Receives the entities of the snapshot, sorted by entityId.
+ * @return true on success, false if the message is malformed or its baseline is unknown.
+ */
+bool decodeSnapshotPacked(const char* data, size_t size, const SnapshotHistory& history, std::vector<SyncedEntityState>& out);
+
+}
+
+#endif /* !NETWORK_SNAPSHOT_HPP_ */
@@ -61,15 +61,36 @@ private:
      */
     enum class RequestState {
         IDLE,           /**< No request is currently in progress. */
-        SENT_REQUEST,   /**< The request has been sent to the server. */
-        RECEIVED_TYPE,  /**< The response type header has been received. */
-        RECEIVED_DATA   /**< The response data has been received. */
+        SENT_REQUEST    /**< The request has been sent, waiting for its response. */
     };
 
     RequestState _createRoomState = RequestState::IDLE; /**< Current state of the create room request. */
     RequestState _joinRoomState = RequestState::IDLE; /**< Current state of the join room request. */
-    uint8_t _createRoomPendingRespType = 0; /**< Stores the response type received for create room while waiting for data. */
-    uint8_t _joinRoomPendingRespType = 0; /**< Stores the response type received for join room while waiting for data. */
+
+    std::vector<uint8_t> _inbox; /**< Bytes received from the server that do not form a full message yet. */
+    bool _roomListRequested = false; /**< True once LIST_ROOMS was sent, which subscribes to room updates. */
+    std::vector<RoomInfo> _rooms; /**< Room list, kept up to date by ROOM_UPDATE / ROOM_REMOVED. */
+    LobbyState _lobbyState; /**< Last lobby state pushed by the server. */
+    std::optional<int> _createRoomResult; /**< Room ID from CREATE_ROOM_RESPONSE, -1 on error, until consumed. */
+    std::optional<bool> _joinRoomResult; /**< Status from JOIN_ROOM_RESPONSE, until consumed. */
+    std::vector<std::string> _chatMessages; /**< Chat messages received but not consumed yet. */
+
+    /**
+     * @brief Reads everything the socket has without blocking and dispatches the complete messages.
+     *
+     * The server pushes lobby state, room updates, chat and the game start on
+     * its own, so every public getter goes through this single reader instead
+     * of expecting a given response type next.
+     */
+    void pollMessages();
+
+    /**
+     * @brief Applies one message from the front of a buffer.
+     * @param data Start of the message.
+     * @param size Bytes available from @p data.
+     * @return size_t Bytes consumed, or 0 if the message is not complete yet.
+     */
+    size_t handleMessage(const uint8_t* data, size_t size);
 
 public:
     /**
@@ -116,9 +137,10 @@ public:
     bool sendConnectRequest(const std::string& username, ConnectResponse& outResponse);
 
     /**
-     * @brief Requests the list of available rooms from the server.
+     * @brief Returns the list of available rooms.
      *
-     * Sends a request to list rooms and reads the response.
+     * The first call sends LIST_ROOMS, which also subscribes to ROOM_UPDATE and
+     * ROOM_REMOVED pushes. Later calls only apply the pushes received since.
      *
      * @return A std::vector containing RoomInfo structures for each available room.
      */
@@ -152,10 +174,11 @@ public:
     std::optional<bool> joinRoom(int roomId);
 
     /**
-     * @brief Polls the server for the current state of the lobby.
+     * @brief Returns the current state of the lobby.
      *
-     * Sends a request to get the lobby state and processes pending packets to update
-     * the local view of the lobby (players, host, game start status).
+     * The server pushes the lobby state whenever a player joins or leaves and
+     * notifies the game start, so this only applies the pending messages to the
+     * local view of the lobby (players, host, game start status).
      *
      * @return A LobbyState structure containing the current lobby information.
      */
@@ -181,7 +204,7 @@ public:
 
     /**
      * @brief Checks for incoming chat messages without blocking.
-     * @return A vector of received messages.
+     * @return A vector of the messages received since the last call.
      */
     std::vector<std::string> receiveChatMessages();
 
@@ -14,6 +14,8 @@
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <optional>
+#include <functional>
 #include "Client/Asio.hpp"
 #include "Network/ITCPHandler.hpp"
 #include "Network/Protocole/ProtocoleTCP.hpp"
@@ -32,16 +34,24 @@
  * handling the initial handshake, and managing client requests within the lobby
  * (listing rooms, creating rooms, joining rooms, etc.). It delegates specific
  * game logic actions to an ITCPHandler implementation.
+ *
+ * All sockets are driven asynchronously by a small fixed pool of threads
+ * running the io_context. Every connection is a Session whose handlers run on
+ * its own strand, so an idle client costs a socket and a few buffers instead
+ * of a thread.
  */
 class TCPServer {
 public:
+    static constexpr size_t DEFAULT_IO_THREADS = 2; /**< Threads running the io_context by default */
+
     /**
      * @brief Construct a new TCPServer object.
-     * @param port The port number to listen on.
+     * @param port The port number to listen on, 0 for an ephemeral port.
      * @param handler Pointer to the handler for game logic events.
      * @param clock Reference to the shared Clock object.
+     * @param ioThreads Number of threads running the io_context.
      */
-    TCPServer(int port, Network::ITCPHandler* handler, Clock& clock);
+    TCPServer(int port, Network::ITCPHandler* handler, Clock& clock, size_t ioThreads = DEFAULT_IO_THREADS);
 
     /**
      * @brief Destroy the TCPServer object.
@@ -51,13 +61,13 @@ public:
 
     /**
      * @brief Starts the TCP server.
-     * Initializes the acceptor and starts the thread for accepting connections.
+     * Starts accepting connections and launches the io_context threads.
      */
     void start();
 
     /**
      * @brief Stops the TCP server.
-     * Closes the acceptor and all client sockets, and stops all threads.
+     * Closes the acceptor and all client sockets, and joins the io_context threads.
      */
     void stop();
 
@@ -67,49 +77,110 @@ public:
      */
     void sendGameStartingNotification(int roomId);
 
+    /**
+     * @brief Pushes a LOBBY_STATE_RESPONSE to every player of a room.
+     * @param roomId The room.
+     * @param hostId The ID of its host.
+     * @param players The players in the room, as (ID, username).
+     */
+    void pushLobbyState(int roomId, uint32_t hostId, const std::vector<std::pair<uint32_t, std::string>>& players);
+
+    /**
+     * @brief Pushes a ROOM_UPDATE to the lobby clients subscribed to the room list.
+     * @param room The new state of the room.
+     */
+    void pushRoomUpdate(const Network::RoomSimpleInfo& room);
+
+    /**
+     * @brief Pushes a ROOM_REMOVED to the lobby clients subscribed to the room list.
+     * @param roomId The deleted room.
+     */
+    void pushRoomRemoved(int roomId);
+
     /**
      * @brief Kicks a player from the server by closing their TCP socket.
      * @param playerId The ID of the player to kick.
      */
     void kickPlayer(uint32_t playerId);
 
+    /**
+     * @brief Returns the port the server listens on.
+     * @return unsigned short The port, useful when constructed with port 0.
+     */
+    unsigned short getPort() const;
+
+    /**
+     * @brief Returns the number of connected players.
+     * @return size_t Sessions that completed the CONNECT handshake and are still open.
+     */
+    size_t getSessionCount();
+
 private:
+    class Session;
+
+    /**
+     * @brief Queues an asynchronous accept.
+     */
+    void startAccept();
+
+    /**
+     * @brief Registers a session once its CONNECT handshake succeeded.
+     * @param session The session.
+     * @return uint32_t The player ID assigned to it.
+     */
+    uint32_t registerSession(const std::shared_ptr<Session>& session);
+
+    /**
+     * @brief Forgets a closed session.
+     * @param playerId The ID of its player.
+     */
+    void unregisterSession(uint32_t playerId);
+
+    /**
+     * @brief Copies the sessions matching a filter, under _serverMutex.
+     * Messages are then queued outside the lock, so the lock is only held for the scan.
+     * @param filter Predicate on the session.
+     * @return The matching sessions.
+     */
+    std::vector<std::shared_ptr<Session>> collectSessions(const std::function<bool(const Session&)>& filter);
+
     /**
-     * @brief Main loop for accepting new client connections.
+     * @brief Queues a chat message to every other player of a room.
+     * @param roomId The room.
+     * @param senderId The player who sent it.
+     * @param message The serialized CHAT_MESSAGE.
      */
-    void acceptLoop();
+    void broadcastChat(int roomId, uint32_t senderId, const std::shared_ptr<const std::vector<uint8_t>>& message);
 
     /**
-     * @brief Handles the communication with a connected client in the lobby.
-     * @param clientSocket Shared pointer to the client's socket.
+     * @brief Queues a message to every session of a room.
+     * @param roomId The room.
+     * @param message The serialized message.
      */
-    void handleClient(std::shared_ptr<asio::ip::tcp::socket> clientSocket);
+    void sendToRoom(int roomId, const std::shared_ptr<const std::vector<uint8_t>>& message);
 
     /**
-     * @brief Handles the communication with a client that has joined a room.
-     * @param clientSocket Shared pointer to the client's socket.
-     * @param roomId The ID of the room the client is in.
-     * @param playerId The ID of the client.
+     * @brief Queues a message to every session outside a room that subscribed to the room list.
+     * @param message The serialized message.
      */
-    void handleInRoomClient(std::shared_ptr<asio::ip::tcp::socket> clientSocket, int roomId, uint32_t playerId);
+    void sendToRoomListSubscribers(const std::shared_ptr<const std::vector<uint8_t>>& message);
 
     asio::io_context _io_context; /**< ASIO IO context for managing I/O operations. */
-    asio::ip::tcp::acceptor _acceptor; /**< TCP acceptor for listening to incoming connections. */
+    std::optional<asio::executor_work_guard<asio::io_context::executor_type>> _workGuard; /**< Keeps the IO threads alive while the server runs. */
+    asio::ip::tcp::acceptor _acceptor; /**< TCP acceptor for listening to incoming connections, on its own strand. */
+    asio::steady_timer _acceptRetryTimer; /**< Delays accepting again after a failure such as running out of file descriptors. */
 
     std::atomic<bool> _running; /**< Flag indicating if the server is running. */
 
     Network::ITCPHandler* _handler; /**< Pointer to the handler for game logic events. */
 
-    uint32_t _nextPlayerId = 1; /**< Counter for assigning unique player IDs. */
-    int _nextRoomId = 0; /**< Counter for assigning unique room IDs. */
-    std::map<uint32_t, std::string> _playerUsernames; /**< Map of player IDs to usernames. */
-    std::mutex _serverMutex; /**< Mutex for thread safety. */
-    std::map<uint32_t, std::shared_ptr<asio::ip::tcp::socket>> _playerSockets; /**< Map of player IDs to their sockets. */
-    std::map<uint32_t, int> _playerRoomMap; /**< Map of player IDs to the room ID they are currently in. */
+    std::atomic<uint32_t> _nextPlayerId{1}; /**< Counter for assigning unique player IDs. */
+    std::mutex _serverMutex; /**< Mutex protecting _sessions. */
+    std::map<uint32_t, std::shared_ptr<Session>> _sessions; /**< Connected players by ID. */
 
-    std::thread _acceptThread; /**< Thread for the accept loop. */
-    std::vector<std::thread> _clientThreads; /**< Vector of threads handling individual clients. */
+    size_t _ioThreadCount; /**< Number of threads started by start(). */
+    std::vector<std::thread> _ioThreads; /**< Threads running the io_context. */
     const Clock& _clock; /**< Reference to the shared Clock object. */
 };
 
-#endif /* !TCPSERVER_HPP_ */
\ No newline at end of file
+#endif /* !TCPSERVER_HPP_ */
@@ -0,0 +1,116 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Backpressure
+*/
+
+#ifndef NETWORK_BACKPRESSURE_HPP_
+#define NETWORK_BACKPRESSURE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "Network/Packet.hpp"
+#include "Network/Protocole/ProtocoleUDP.hpp"
+
+/**
+ * @file Backpressure.hpp
+ * @brief Priorities of the server UDP messages and policies applied when the outgoing queue fills up.
+ */
+
+namespace Network {
+
+static constexpr size_t MESSAGE_TYPE_COUNT = 32; ///< UDPMessageType values fit below this bound
+
+/**
+ * @enum BackpressurePolicy
+ * @brief What the UDP server drops once its outgoing queue is past its limit.
+ *
+ * Whatever the policy, CRITICAL datagrams are never dropped while the server
+ * runs: the top of the queue is reserved for them and, when even that is full,
+ * the producer waits for the send thread instead of dropping.
+ */
+enum class BackpressurePolicy : uint8_t {
+    DROP_NEWEST,      ///< Reject the datagram being queued
+    DROP_OLDEST,      ///< Queue it and have the send thread discard the oldest non-critical datagram
+    DROP_BY_PRIORITY, ///< Like DROP_NEWEST, but LOW datagrams are rejected once the queue is half full
+    FAIR_SHARE        ///< Past half full, a client holding more than its share of the queue is rejected
+};
+
+/**
+ * @enum MessagePriority
+ * @brief How bad losing a message is.
+ */
+enum class MessagePriority : uint8_t {
+    LOW,      ///< Superseded by the next tick (positions, snapshots)
+    NORMAL,   ///< Repaired by a later sync or a retransmission if lost (spawns, pongs, fragments, reliable channel)
+    CRITICAL  ///< Never repaired: kicks, and entity destruction and boss state sent to clients before protocol 3
+};
+
+/**
+ * @brief Returns the priority of a single message.
+ * @param type The UDPMessageType of the message.
+ * @return MessagePriority Its priority.
+ */
+MessagePriority messagePriority(uint8_t type);
+
+/**
+ * @brief Calls @p fn with the type of each message carried by a datagram.
+ * A BUNDLE yields the type of each bundled message, any other datagram its own type.
+ * @param pkt The datagram.
+ * @param fn Callable taking the uint8_t message type.
+ */
+template<typename Fn>
+void forEachMessageType(const Packet& pkt, Fn&& fn)
+{
+    if (pkt.length == 0)
+        return;
+    auto type = static_cast<uint8_t>(pkt.data[0]);
+    if (type != BUNDLE || pkt.length < sizeof(BundleHeader)) {
+        fn(type);
+        return;
+    }
+    BundleHeader header;
+    std::memcpy(&header, pkt.data.data(), sizeof(header));
+    size_t offset = sizeof(BundleHeader);
+    for (uint8_t i = 0; i < header.messageCount && offset + sizeof(BundledMessageHeader) < pkt.length; ++i) {
+        BundledMessageHeader entry;
+        std::memcpy(&entry, pkt.data.data() + offset, sizeof(entry));
+        fn(static_cast<uint8_t>(pkt.data[offset + sizeof(entry)]));
+        offset += sizeof(entry) + entry.length;
+    }
+}
+
+/**
+ * @brief Returns the priority of a datagram, the highest of the messages it carries.
+ * @param pkt The datagram.
+ * @return MessagePriority Its priority.
+ */
+MessagePriority packetPriority(const Packet& pkt);
+
+/**
+ * @brief Returns a lowercase name for a message type, used by the shell and the metrics.
+ * @param type The UDPMessageType.
+ * @return const char* The name, "unknown" for values outside the enum.
+ */
+const char* messageTypeName(uint8_t type);
+
+/**
+ * @brief Returns the name of a policy, as accepted by parseBackpressurePolicy().
+ * @param policy The policy.
+ * @return const char* Its name.
+ */
+const char* backpressurePolicyName(BackpressurePolicy policy);
+
+/**
+ * @brief Parses a policy name: drop-newest, drop-oldest, priority or fair-share.
+ * @param name The name.
+ * @param policy Set to the policy on success.
+ * @return true if the name is known.
+ */
+bool parseBackpressurePolicy(const std::string& name, BackpressurePolicy& policy);
+
+}
+
+#endif /* !NETWORK_BACKPRESSURE_HPP_ */
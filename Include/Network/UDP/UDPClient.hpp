@@ -13,8 +13,10 @@
 #include <optional>
 #include <array>
 #include <iostream>
+#include <span>
 
 #include "Network/Protocole/ProtocoleUDP.hpp"
+#include "Network/FragmentReassembler.hpp"
 #include "CrossPlatformSocket.hpp"
 #include "Client/Asio.hpp"
 
@@ -28,6 +30,7 @@ private:
     asio::io_context _io_context; /**< ASIO IO context */
     asio::ip::udp::socket _socket; /**< UDP socket */
     asio::ip::udp::endpoint _server_endpoint; /**< Endpoint of the server */
+    Network::FragmentReassembler _reassembler; /**< Rebuilds messages received as FRAGMENT pieces */
 
 public:
     /**
@@ -86,6 +89,35 @@ public:
         return !ec;
     }
 
+    /**
+     * @brief Sends the first bytes of a packet to the server.
+     * Used for packets whose size depends on the negotiated protocol version.
+     * @param data Pointer to the packet.
+     * @param size Number of bytes to send.
+     * @return true if sent successfully, false otherwise.
+     */
+    bool sendMessage(const void* data, size_t size) noexcept
+    {
+        asio::error_code ec;
+        _socket.send_to(asio::buffer(data, size), _server_endpoint, 0, ec);
+        return !ec;
+    }
+
+    /**
+     * @brief Stores a FRAGMENT message and returns the original message once complete.
+     * @param data Pointer to the FRAGMENT message.
+     * @param size Number of readable bytes at @p data.
+     * @return std::span<const char> The rebuilt message, empty while fragments are missing.
+     * The span stays valid until the next call.
+     */
+    std::span<const char> reassemble(const char* data, size_t size) noexcept;
+
+    /**
+     * @brief Returns the fragment reassembly counters.
+     * @return const Network::ReassemblyStats& The counters.
+     */
+    const Network::ReassemblyStats& getReassemblyStats() const { return _reassembler.getStats(); }
+
     /**
      * @brief Checks if the UDP socket is still open and valid.
      * @return true if the connection is considered active, false otherwise.
@@ -17,10 +17,14 @@
 #include <map>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "Client/Asio.hpp"
-#include "Network/RingBuffer.hpp"
+#include "Network/LockFreeRingBuffer.hpp"
+#include "Network/AdaptiveWaiter.hpp"
 #include "Network/Packet.hpp"
+#include "Network/PacketPool.hpp"
+#include "Network/UDP/Backpressure.hpp"
 #include "Network/INetworkHandler.hpp"
 #include "Network/Protocole/ProtocoleUDP.hpp"
 #include "Clock.hpp"
@@ -39,12 +43,100 @@ struct ClientInfo {
     sockaddr_in addr; /**< Client's UDP address */
 };
 
+/**
+ * @struct BatchStats
+ * @brief Snapshot of the datagram batch sizes seen by a network thread.
+ */
+struct BatchStats {
+    uint64_t batches = 0;   /**< Number of batches (syscalls on the batched path) */
+    uint64_t datagrams = 0; /**< Total number of datagrams in those batches */
+    uint64_t maxBatch = 0;  /**< Largest batch seen */
+
+    /**
+     * @brief Average number of datagrams per batch.
+     * @return double The average, 0 if no batch was recorded.
+     */
+    double average() const { return batches ? static_cast<double>(datagrams) / batches : 0.0; }
+};
+
+/**
+ * @class BatchCounter
+ * @brief Batch size counters updated by a single network thread and read by any thread.
+ */
+class BatchCounter {
+public:
+    /**
+     * @brief Records a batch of datagrams.
+     * @param size Number of datagrams in the batch.
+     */
+    void record(size_t size)
+    {
+        _batches.fetch_add(1, std::memory_order_relaxed);
+        _datagrams.fetch_add(size, std::memory_order_relaxed);
+        if (size > _maxBatch.load(std::memory_order_relaxed))
+            _maxBatch.store(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns a snapshot of the counters.
+     * @return BatchStats The current counters.
+     */
+    BatchStats snapshot() const
+    {
+        return {_batches.load(std::memory_order_relaxed), _datagrams.load(std::memory_order_relaxed),
+                _maxBatch.load(std::memory_order_relaxed)};
+    }
+
+private:
+    std::atomic<uint64_t> _batches{0};
+    std::atomic<uint64_t> _datagrams{0};
+    std::atomic<uint64_t> _maxBatch{0};
+};
+
+/**
+ * @struct UDPServerStats
+ * @brief Snapshot of the UDP server thread counters.
+ */
+struct UDPServerStats {
+    Network::WaiterStats process; /**< Wait counters of the process thread (incoming queue) */
+    Network::WaiterStats send;    /**< Wait counters of the send thread (outgoing queue) */
+    Network::WaiterStats recv;    /**< Wait counters of the receive thread (incoming pool) */
+    BatchStats recvBatches;       /**< Datagrams received per batch */
+    BatchStats sendBatches;       /**< Datagrams sent per batch */
+    bool batchedIo = false;       /**< Whether the recvmmsg/sendmmsg backend is in use */
+    uint64_t coalescedMessages = 0;  /**< Messages that went through a TickBatch */
+    uint64_t coalescedDatagrams = 0; /**< Datagrams produced for those messages */
+    uint64_t fragmentedMessages = 0; /**< Messages larger than MAX_UDP_PACKET_SIZE sent as fragments */
+    uint64_t fragments = 0;          /**< FRAGMENT datagrams produced for those messages */
+    uint64_t bytesReceived = 0;      /**< Payload bytes of the datagrams received */
+    uint64_t bytesSent = 0;          /**< Payload bytes of the datagrams handed to the socket */
+    uint64_t incomingDropped = 0;    /**< Datagrams received but dropped because the incoming queue was full */
+    uint64_t outgoingDropped = 0;    /**< Datagrams dropped by the backpressure policy, evictions included */
+    uint64_t evicted = 0;            /**< Queued datagrams discarded by DROP_OLDEST */
+    uint64_t criticalWaits = 0;      /**< Critical messages that had to wait for room in the outgoing queue or pool */
+    Network::PacketPoolStats incomingPool; /**< Buffers of the received datagrams */
+    Network::PacketPoolStats outgoingPool; /**< Buffers of the datagrams to send */
+    uint64_t payloadCopies = 0;      /**< Copies of outgoing message bytes, one per message when no bundle is shifted */
+    std::array<uint64_t, Network::MESSAGE_TYPE_COUNT> droppedByType{}; /**< Outgoing messages dropped, by UDPMessageType */
+    Network::BackpressurePolicy policy = Network::BackpressurePolicy::DROP_BY_PRIORITY; /**< Policy in use */
+    size_t incomingDepth = 0;        /**< Datagrams waiting in the incoming queue */
+    size_t outgoingDepth = 0;        /**< Datagrams waiting in the outgoing queue */
+};
+
 /**
  * @class UDPServer
  * @brief Server class managing UDP communication.
  *
  * Handles receiving player inputs and sending game state updates.
- * Uses ring buffers for thread-safe packet processing.
+ * Uses lock-free ring buffers to hand packets between the network threads:
+ * the receive thread is the only producer of _incoming and the send thread
+ * is the only consumer of _outgoing. The rings carry pointers to packets of
+ * two fixed pools: datagrams are received straight into a pooled packet, and
+ * outgoing messages are copied once, into the pooled datagram that is sent.
+ * The thread that consumes a packet last returns it to its pool.
+ * When _outgoing fills up, the backpressure policy decides which datagrams
+ * are dropped; critical ones (see Network::MessagePriority) are never dropped
+ * while the server runs.
  */
 class UDPServer {
 public:
@@ -83,24 +175,71 @@ public:
     template<typename T>
     void queueMessage(const T& msg, const sockaddr_in& addr)
     {
-        Network::Packet pkt;
-        pkt.addr = addr;
-        pkt.length = sizeof(T);
+        static_assert(sizeof(T) <= Network::Packet::MAX_SIZE, "Packet too large!");
 
-        static_assert(sizeof(T) <= pkt.data.size(), "Packet too large!");
-
-        std::memcpy(pkt.data.data(), &msg, sizeof(T));
-        _outgoing.push(pkt);
+        queueMessage(reinterpret_cast<const char*>(&msg), sizeof(T), addr);
     }
 
     /**
      * @brief Queues a raw data message to be sent to a specific client.
+     * Inside a TickBatch opened by the calling thread, the message is staged
+     * and coalesced with the other messages for the same client. Messages
+     * larger than MAX_UDP_PACKET_SIZE are split into FRAGMENT messages.
      * @param data Pointer to the raw data buffer.
      * @param length The length of the data to send.
      * @param clientAddr The destination address.
      */
     void queueMessage(const char* data, size_t length, const sockaddr_in& clientAddr);
 
+    /**
+     * @class TickBatch
+     * @brief RAII scope that coalesces the messages queued by the current thread.
+     *
+     * While a TickBatch is alive, queueMessage() calls made by the thread that
+     * opened it are grouped per destination. When the scope ends, each
+     * destination's messages are packed into as few BUNDLE datagrams as fit in
+     * MAX_UDP_PACKET_SIZE and pushed to the outgoing queue at once. Messages
+     * queued by other threads are sent immediately, as before.
+     */
+    class TickBatch {
+    public:
+        /**
+         * @brief Starts coalescing messages queued by the calling thread.
+         * @param server The server the messages are queued on.
+         */
+        explicit TickBatch(UDPServer& server);
+
+        /**
+         * @brief Packs and queues everything staged since construction.
+         */
+        ~TickBatch();
+
+        TickBatch(const TickBatch&) = delete;
+        TickBatch& operator=(const TickBatch&) = delete;
+
+    private:
+        UDPServer& _server; /**< Server the staged messages are flushed to */
+        bool _owner;        /**< False when nested inside another TickBatch */
+    };
+
+    /**
+     * @brief Returns a snapshot of the network thread counters.
+     * @return UDPServerStats The current counters.
+     */
+    UDPServerStats getStats() const;
+
+    /**
+     * @brief Changes the policy applied when the outgoing queue is full. Safe at any time.
+     * @param policy The new policy.
+     */
+    void setBackpressurePolicy(Network::BackpressurePolicy policy);
+
+    /**
+     * @brief Returns the policy applied when the outgoing queue is full.
+     * @return Network::BackpressurePolicy The policy.
+     */
+    Network::BackpressurePolicy getBackpressurePolicy() const;
+
 private:
     asio::io_context _io_context; /**< ASIO IO context */
     asio::ip::udp::socket _socket; /**< UDP socket */
@@ -115,21 +254,93 @@ private:
     std::thread _sendThread; /**< Thread for sending packets */
     std::thread _processThread; /**< Thread for processing logic */
 
-    Network::RingBuffer<Network::Packet, 1024> _incoming; /**< Buffer for incoming packets */
-    Network::RingBuffer<Network::Packet, 1024> _outgoing; /**< Buffer for outgoing packets */
+    static constexpr size_t BATCH_SIZE = 32; /**< Maximum number of datagrams handled per batch by the network threads */
+    static constexpr size_t QUEUE_CAPACITY = 1024; /**< Slots of each ring buffer */
+    static constexpr size_t CRITICAL_RESERVE = 128; /**< Top slots of _outgoing only critical datagrams may take */
+    static constexpr size_t PRESSURE_THRESHOLD = QUEUE_CAPACITY / 2; /**< Depth past which the LOW and fair share limits apply */
+    static constexpr size_t DESTINATION_BUCKETS = 256; /**< Hash buckets of _destinationDepth */
+    static constexpr int32_t MIN_FAIR_SHARE = 16; /**< A client may always hold this many queued datagrams */
+
+    static constexpr size_t INCOMING_POOL_SIZE = QUEUE_CAPACITY + 2 * BATCH_SIZE; /**< _incoming full, plus the receive and process batches */
+    static constexpr size_t OUTGOING_POOL_SIZE = 4 * QUEUE_CAPACITY; /**< _outgoing full, plus the bundles of the ticks being staged */
+
+    Network::PacketPool _incomingPool{INCOMING_POOL_SIZE}; /**< Packets datagrams are received into */
+    Network::PacketPool _outgoingPool{OUTGOING_POOL_SIZE}; /**< Packets outgoing datagrams are built in */
+    Network::LockFreeRingBuffer<Network::Packet*, QUEUE_CAPACITY> _incoming; /**< Received packets, from the receive to the process thread */
+    Network::LockFreeRingBuffer<Network::Packet*, QUEUE_CAPACITY> _outgoing; /**< Packets to send, from any thread to the send thread */
+    Network::AdaptiveWaiter _incomingWaiter; /**< Parks the process thread while _incoming is empty */
+    Network::AdaptiveWaiter _outgoingWaiter; /**< Parks the send thread while _outgoing is empty */
+    Network::AdaptiveWaiter _incomingPoolWaiter; /**< Parks the receive thread while every _incomingPool packet is in use */
+
+    std::atomic<bool> _batchedIo{false}; /**< Use recvmmsg/sendmmsg (Linux) instead of one asio call per datagram */
+    BatchCounter _recvBatches; /**< Batch sizes of the receive thread */
+    BatchCounter _sendBatches; /**< Batch sizes of the send thread */
+    std::atomic<uint64_t> _coalescedMessages{0}; /**< Messages staged by TickBatch scopes */
+    std::atomic<uint64_t> _coalescedDatagrams{0}; /**< Datagrams emitted by TickBatch flushes */
+    std::atomic<uint16_t> _nextFragmentedId{0}; /**< Id of the next fragmented message */
+    std::atomic<uint64_t> _fragmentedMessages{0}; /**< Messages split into fragments */
+    std::atomic<uint64_t> _fragments{0}; /**< Fragments queued */
+    std::atomic<uint64_t> _bytesReceived{0}; /**< Bytes received, added once per batch */
+    std::atomic<uint64_t> _bytesSent{0}; /**< Bytes sent, added once per batch */
+    std::atomic<uint64_t> _incomingDropped{0}; /**< Datagrams that did not fit in _incoming */
+    std::atomic<uint64_t> _outgoingDropped{0}; /**< Datagrams that did not fit in _outgoing */
+    std::atomic<Network::BackpressurePolicy> _policy{Network::BackpressurePolicy::DROP_BY_PRIORITY}; /**< Applied when _outgoing is full */
+    std::array<std::atomic<uint64_t>, Network::MESSAGE_TYPE_COUNT> _droppedByType{}; /**< Outgoing messages dropped, by type */
+    std::array<std::atomic<int32_t>, DESTINATION_BUCKETS> _destinationDepth{}; /**< Queued datagrams per destination hash, may dip below 0 briefly */
+    std::atomic<uint64_t> _evictRequests{0}; /**< Oldest datagrams the send thread still has to discard (DROP_OLDEST) */
+    std::atomic<uint64_t> _evicted{0}; /**< Datagrams discarded by DROP_OLDEST */
+    std::atomic<uint64_t> _criticalWaits{0}; /**< Critical messages that found the queue or the pool full */
+    std::atomic<uint64_t> _payloadCopies{0}; /**< Outgoing message copies, staged ones added at each flush */
 
     std::unordered_map<uint32_t, ClientInfo> _clients; /**< Map of connected clients */
 
+    /**
+     * @brief Splits a message larger than MAX_UDP_PACKET_SIZE into FRAGMENT messages and queues them.
+     * @param data Pointer to the message.
+     * @param length Size of the message, at most MAX_FRAGMENTED_MESSAGE_SIZE.
+     * @param clientAddr The destination address.
+     */
+    void queueFragmented(const char* data, size_t length, const sockaddr_in& clientAddr);
+
     /**
      * @brief The main loop for receiving incoming UDP packets.
      * Listens on the socket and pushes received packets into the incoming ring buffer.
      */
     void recvLoop();
+    /**
+     * @brief Receives one datagram with asio (portable fallback).
+     * @param batch Pooled destination packets, only the first one is filled.
+     * @param count Set to the number of packets received.
+     * @return false if the socket was closed and the loop must stop.
+     */
+    bool receiveBatchAsio(Network::Packet* const* batch, size_t& count);
+    /**
+     * @brief Receives up to BATCH_SIZE datagrams with a single recvmmsg call.
+     * Falls back to asio when the syscall is not available.
+     * @param batch Pooled destination packets.
+     * @param available Number of packets at @p batch.
+     * @param count Set to the number of packets received.
+     * @return false if the socket was closed and the loop must stop.
+     */
+    bool receiveBatchNative(Network::Packet* const* batch, size_t available, size_t& count);
     /**
      * @brief The main loop for sending outgoing UDP packets.
      * Pops packets from the outgoing ring buffer and sends them to their destination.
      */
     void sendLoop();
+    /**
+     * @brief Sends packets one by one with asio (portable fallback).
+     * @param packets Packets to send.
+     * @param count Number of packets.
+     */
+    void sendBatchAsio(Network::Packet* const* packets, size_t count);
+    /**
+     * @brief Sends packets with as few sendmmsg calls as possible.
+     * Falls back to asio when the syscall is not available.
+     * @param packets Packets to send.
+     * @param count Number of packets (at most BATCH_SIZE).
+     */
+    void sendBatchNative(Network::Packet* const* packets, size_t count);
     /**
      * @brief The main loop for processing received packets.
      * Pops packets from the incoming ring buffer and passes them to handlePacket.
@@ -143,6 +354,59 @@ private:
      * @param clientAddr The source address of the packet.
      */
     void handlePacket(const char* data, size_t length, const sockaddr_in& clientAddr);
+    /**
+     * @brief Pushes fully built packets to the outgoing queue and wakes the send thread.
+     * Packets dropped by the backpressure policy go back to the pool.
+     * @param packets Pooled packets to push, owned by the queue or released afterwards.
+     * @param count Number of packets.
+     */
+    void pushOutgoing(Network::Packet* const* packets, size_t count);
+    /**
+     * @brief Queues one datagram on the slow path, applying the backpressure policy.
+     * @param pkt The pooled datagram, released if dropped.
+     */
+    void enqueueOutgoing(Network::Packet* pkt);
+    /**
+     * @brief Takes a packet from the outgoing pool to build a datagram in.
+     * When the pool is empty, a critical message waits for the send thread
+     * to release packets; any other message is counted as dropped.
+     * @param type UDPMessageType of the message the packet is for.
+     * @return Network::Packet* The packet, or nullptr if the message is dropped.
+     */
+    Network::Packet* acquireOutgoing(uint8_t type);
+    /**
+     * @brief Tells whether a non-critical datagram may be queued under the current policy.
+     * @param pkt The datagram.
+     * @param priority Its priority.
+     * @return true if it may be pushed.
+     */
+    bool admitOutgoing(const Network::Packet& pkt, Network::MessagePriority priority);
+    /**
+     * @brief Discards the oldest non-critical datagrams of a popped batch to pay the DROP_OLDEST debt.
+     * @param packets The batch, compacted in place. Discarded packets are released.
+     * @param count Number of datagrams in the batch.
+     * @return size_t Number of datagrams left to send.
+     */
+    size_t evictOldest(Network::Packet** packets, size_t count);
+    /**
+     * @brief Counts a datagram, and each message it carries, as dropped.
+     * @param pkt The datagram.
+     */
+    void recordDrop(const Network::Packet& pkt);
+    /**
+     * @brief Returns the _destinationDepth bucket of an address.
+     * @param addr The destination.
+     * @return std::atomic<int32_t>& Its bucket.
+     */
+    std::atomic<int32_t>& destinationDepth(const sockaddr_in& addr);
+    /**
+     * @brief Packs and queues the messages staged by the calling thread's TickBatch.
+     */
+    void flushStaged();
+    /**
+     * @brief Queues the datagrams the calling thread's TickBatch has finished so far.
+     */
+    void pushStagedReady();
 };
 
 #endif /* !UDPSERVER_HPP_ */
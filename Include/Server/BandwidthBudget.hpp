@@ -0,0 +1,148 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** BandwidthBudget
+*/
+
+#ifndef BANDWIDTHBUDGET_HPP_
+#define BANDWIDTHBUDGET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "Server/InterestManager.hpp"
+
+/**
+ * @file BandwidthBudget.hpp
+ * @brief Per-client byte budget and the priority accumulator sharing it between entity updates.
+ */
+
+/**
+ * @class BandwidthBudget
+ * @brief Token bucket limiting the bytes a room sends to one client.
+ *
+ * Every tick adds rate * tick duration bytes, up to BURST_SECONDS worth.
+ * Messages the game cannot skip (player states, spawns, destructions,
+ * snapshots) are always charged, possibly putting the bucket in debt; entity
+ * updates are only sent while tokens remain. Sizes are message payloads,
+ * before bundling and IP/UDP headers.
+ */
+class BandwidthBudget {
+public:
+    static constexpr uint32_t DEFAULT_KBPS = 256; /**< Budget of a client when none is configured */
+    static constexpr uint32_t UNLIMITED = 0; /**< Rate meaning no budget */
+    static constexpr float BURST_SECONDS = 0.1f; /**< Tokens saved at most, in seconds of rate */
+    static constexpr float DEBT_SECONDS = 1.0f; /**< Debt allowed at most, in seconds of rate */
+
+    /**
+     * @brief Starts a tick: adds the tokens earned and rolls the usage window.
+     * @param kbps Budget in kilobits per second, UNLIMITED for none.
+     * @param seconds Duration of the tick.
+     */
+    void refill(uint32_t kbps, float seconds);
+
+    /**
+     * @brief Charges a message the game cannot skip.
+     * @param bytes Size of the message.
+     */
+    void charge(size_t bytes);
+
+    /**
+     * @brief Charges an optional message if the tokens cover it.
+     * @param bytes Size of the message.
+     * @return true if charged and the message must be sent, false if it has to wait.
+     */
+    bool tryCharge(size_t bytes);
+
+    /**
+     * @brief Counts an optional message that had to wait for tokens.
+     */
+    void recordThrottled() { ++_throttled; }
+
+    /**
+     * @brief Returns the budget in use.
+     * @return uint32_t Kilobits per second, UNLIMITED for none.
+     */
+    uint32_t getKbps() const { return _kbps; }
+
+    /**
+     * @brief Returns the rate measured over the last full second.
+     * @return float Kilobits per second.
+     */
+    float getUsedKbps() const { return _usedKbps; }
+
+    /**
+     * @brief Returns the bytes charged since the client joined.
+     * @return uint64_t The bytes.
+     */
+    uint64_t getBytes() const { return _bytes; }
+
+    /**
+     * @brief Returns how many optional messages had to wait for tokens.
+     * @return uint64_t The count since the client joined.
+     */
+    uint64_t getThrottled() const { return _throttled; }
+
+private:
+    uint32_t _kbps = UNLIMITED; /**< Rate of the last refill */
+    float _tokens = 0.0f; /**< Bytes that may still be sent, negative when in debt */
+    float _windowSeconds = 0.0f; /**< Time covered by _windowBytes */
+    uint64_t _windowBytes = 0; /**< Bytes charged in the current usage window */
+    float _usedKbps = 0.0f; /**< Rate of the last complete window */
+    uint64_t _bytes = 0; /**< Bytes charged in total */
+    uint64_t _throttled = 0; /**< Optional messages that waited */
+};
+
+/**
+ * @class PriorityAccumulator
+ * @brief Per-client entity priorities that grow until the entity is sent.
+ *
+ * Every tick each entity's relevance is added to its priority. An entity
+ * becomes pending when its relevance tier says it is due; pending entities
+ * are sent by decreasing priority while the client's budget lasts, and a sent
+ * entity starts again from 0. An entity that keeps missing the budget stays
+ * pending and keeps gaining priority, so it eventually goes ahead of fresher
+ * but less starved ones.
+ */
+class PriorityAccumulator {
+public:
+    static constexpr float MIN_GAIN = 0.05f; /**< Added every tick on top of the relevance, so irrelevant entities still age */
+
+    /**
+     * @struct Entry
+     * @brief Scheduling state of one entity.
+     */
+    struct Entry {
+        float priority = 0.0f; ///< Relevance accumulated since the entity was last sent
+        bool pending = false; ///< Due and waiting for budget
+        RelevanceTier tier = RelevanceTier::LOW; ///< Tier the entity was last due in
+        uint32_t lastSeen = 0; ///< Last tick the entity was accumulated
+    };
+
+    /**
+     * @brief Adds this tick's relevance to an entity.
+     * @param entityId The entity.
+     * @param relevance Its relevance for the client.
+     * @param tick The room tick, used to forget destroyed entities.
+     * @return Entry& The entity's entry.
+     */
+    Entry& accumulate(uint32_t entityId, float relevance, uint32_t tick);
+
+    /**
+     * @brief Marks an entity as sent: its priority starts again from 0.
+     * @param entry The entity's entry.
+     */
+    static void sent(Entry& entry);
+
+    /**
+     * @brief Forgets the entities not accumulated since @p tick.
+     * @param tick The current tick.
+     */
+    void prune(uint32_t tick);
+
+private:
+    std::unordered_map<uint32_t, Entry> _entries; /**< Entity id -> entry */
+};
+
+#endif /* !BANDWIDTHBUDGET_HPP_ */
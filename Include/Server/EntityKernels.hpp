@@ -0,0 +1,82 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** EntityKernels
+*/
+
+#ifndef ENTITYKERNELS_HPP_
+#define ENTITYKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file EntityKernels.hpp
+ * @brief Vectorized passes over the EntityStore arrays, selected at runtime.
+ */
+
+/**
+ * @struct IntegrationBatch
+ * @brief Arrays and parameters of one integration pass.
+ */
+struct IntegrationBatch {
+    float* x;                  ///< X positions, updated in place
+    float* y;                  ///< Y positions, updated in place
+    const float* velocityX;    ///< Horizontal velocities
+    const float* velocityY;    ///< Vertical velocities
+    const uint8_t* flags;      ///< Entity flags
+    size_t count;              ///< Number of entities
+    float timeScale;           ///< Velocity multiplier for this tick (1 when velocities are per tick)
+    float minX;                ///< Entities left of this X are destroyed
+    float maxX;                ///< Entities right of this X are destroyed
+    uint8_t destroyFlags;      ///< Entities with any of these flags are destroyed
+    uint64_t* destroyMask;     ///< Output, (count + 63) / 64 words: bit i set when entity i must be destroyed
+};
+
+/**
+ * @brief Signature of an integration kernel.
+ * Moves every entity by its velocity times batch.timeScale, then fills batch.destroyMask.
+ * @return size_t Number of entities flagged for destruction.
+ */
+using IntegrateFunction = size_t (*)(const IntegrationBatch& batch);
+
+namespace EntityKernels {
+
+/**
+ * @brief Portable reference implementation.
+ */
+size_t integrateScalar(const IntegrationBatch& batch);
+
+/**
+ * @brief SSE2 implementation, 4 entities per step. Scalar on non-x86 targets.
+ */
+size_t integrateSse2(const IntegrationBatch& batch);
+
+/**
+ * @brief AVX2 implementation, 8 entities per step. Only call it when hasAvx2() is true.
+ */
+size_t integrateAvx2(const IntegrationBatch& batch);
+
+/**
+ * @brief Tells whether the CPU and the compiler support the AVX2 kernel.
+ * @return true if integrateAvx2() can be used.
+ */
+bool hasAvx2();
+
+/**
+ * @brief Runs the fastest kernel supported by the CPU, chosen on the first call.
+ * @param batch The arrays to process.
+ * @return size_t Number of entities flagged for destruction.
+ */
+size_t integrate(const IntegrationBatch& batch);
+
+/**
+ * @brief Name of the kernel used by integrate().
+ * @return const char* "avx2", "sse2" or "scalar".
+ */
+const char* integrateBackend();
+
+}
+
+#endif /* !ENTITYKERNELS_HPP_ */
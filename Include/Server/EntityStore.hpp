@@ -0,0 +1,130 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** EntityStore
+*/
+
+#ifndef ENTITYSTORE_HPP_
+#define ENTITYSTORE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @file EntityStore.hpp
+ * @brief Structure-of-arrays storage for the server-side entities.
+ */
+
+/**
+ * @struct Entity
+ * @brief Represents a game entity (enemy, projectile, etc.).
+ * Used to spawn entities and to read one back from an EntityStore.
+ */
+struct Entity {
+    uint32_t id;             ///< Unique entity identifier
+    uint16_t type;           ///< Entity type
+    float x;                 ///< X position
+    float y;                 ///< Y position
+    float velocityX = 10.0f; ///< Horizontal velocity
+    float velocityY = 0.0f;  ///< Vertical velocity
+    int height = 0;          ///< Hitbox height
+    int width = 0;           ///< Hitbox width
+    bool is_collide = false; ///< Flag indicating if the entity has collided and should be destroyed.
+};
+
+/**
+ * @class EntityStore
+ * @brief Keeps every entity field in its own contiguous array.
+ *
+ * Index i of every array describes the same entity, so simulation passes
+ * stream through the fields they need and simple loops (position integration,
+ * velocity updates) vectorize. Removal swaps the last entity into the freed
+ * index, so indexes are only stable until the next remove(). An id -> index
+ * sparse set, paged because ids only grow, finds an entity in O(1).
+ */
+class EntityStore {
+public:
+    static constexpr uint8_t COLLIDED = 1 << 0;          /**< Flag: the entity was hit and is destroyed on the next update */
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX; /**< Returned by indexOf() for unknown ids */
+
+    /**
+     * @brief Adds an entity at the end of the arrays.
+     * @param entity The entity to add. Its id must not be in the store.
+     * @return uint32_t The index of the new entity.
+     */
+    uint32_t add(const Entity& entity);
+
+    /**
+     * @brief Removes the entity at @p index by moving the last entity into its place.
+     * @param index Index of the entity to remove.
+     */
+    void remove(uint32_t index);
+
+    /**
+     * @brief Finds the index of an entity.
+     * @param id The entity id.
+     * @return uint32_t Its index, or INVALID_INDEX if the id is not in the store.
+     */
+    uint32_t indexOf(uint32_t id) const;
+
+    /**
+     * @brief Copies one entity out of the arrays.
+     * @param index Index of the entity.
+     * @return Entity The entity.
+     */
+    Entity get(uint32_t index) const;
+
+    /**
+     * @brief Removes every entity.
+     */
+    void clear();
+
+    size_t size() const { return _id.size(); }
+    bool empty() const { return _id.empty(); }
+
+    const uint32_t* id() const { return _id.data(); }
+    uint16_t* type() { return _type.data(); }
+    const uint16_t* type() const { return _type.data(); }
+    float* x() { return _x.data(); }
+    const float* x() const { return _x.data(); }
+    float* y() { return _y.data(); }
+    const float* y() const { return _y.data(); }
+    float* velocityX() { return _velocityX.data(); }
+    const float* velocityX() const { return _velocityX.data(); }
+    float* velocityY() { return _velocityY.data(); }
+    const float* velocityY() const { return _velocityY.data(); }
+    const int* width() const { return _width.data(); }
+    const int* height() const { return _height.data(); }
+    uint8_t* flags() { return _flags.data(); }
+    const uint8_t* flags() const { return _flags.data(); }
+
+private:
+    static constexpr size_t PAGE_SIZE = 4096; /**< Ids per sparse page */
+    using Page = std::array<uint32_t, PAGE_SIZE>;
+
+    /**
+     * @brief Sets the sparse entry of an id, allocating its page if needed.
+     * @param id The entity id.
+     * @param index The index to store.
+     */
+    void setIndex(uint32_t id, uint32_t index);
+
+    std::vector<uint32_t> _id;
+    std::vector<uint16_t> _type;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<int> _width;
+    std::vector<int> _height;
+    std::vector<uint8_t> _flags;
+
+    std::vector<std::unique_ptr<Page>> _sparse; /**< id -> index, one page per PAGE_SIZE ids */
+    std::vector<uint16_t> _pageLive;            /**< Entities alive in each page, the page is freed at 0 */
+};
+
+#endif /* !ENTITYSTORE_HPP_ */
@@ -8,15 +8,28 @@
 #ifndef GAME_HPP_
 #define GAME_HPP_
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <mutex>
 #include <iostream>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <string>
+#include <utility>
 
 #include "CrossPlatformSocket.hpp"
+#include "Network/Protocole/ProtocoleTCP.hpp"
 #include "Network/Protocole/ProtocoleUDP.hpp"
+#include "Network/LockFreeRingBuffer.hpp"
+#include "Network/Snapshot.hpp"
+#include "Network/ReliableChannel.hpp"
+#include "Server/EntityStore.hpp"
+#include "Server/InterestManager.hpp"
+#include "Server/BandwidthBudget.hpp"
+#include "Server/SpatialGrid.hpp"
+#include "Server/TickProfiler.hpp"
 class UDPServer;
 
 /**
@@ -43,25 +56,26 @@ struct Player {
     uint64_t lostInputs = 0;         ///< Total number of input packets estimated as lost from this player.
     bool firstInputReceived = true;  ///< Flag to handle the first input packet differently for stats.
     uint32_t statePacketSequence = 0;///< The sequence number for the next state packet to be sent to this player.
+    Network::SnapshotHistory snapshots; ///< Snapshots sent to this player, used as delta baselines once acknowledged.
+    BandwidthBudget budget;          ///< Bytes the room may still send this player.
+    PriorityAccumulator priorities;  ///< Entity update priorities for this player.
+    uint8_t protocolVersion = PROTOCOL_VERSION_LEGACY; ///< UDP protocol negotiated at connection, PROTOCOL_VERSION_PACKED for bit-packed updates
+    Network::ReliableSender reliable; ///< Reliable channel to the player, used from PROTOCOL_VERSION_RELIABLE
 
     int height = 17;                 ///< Hitbox height
     int width = 33;                  ///< Hitbox width
 };
 
 /**
- * @struct Entity
- * @brief Represents a game entity (enemy, projectile, etc.).
+ * @struct ClientBandwidth
+ * @brief Budget use of one player, as shown by the budget command.
  */
-struct Entity {
-    uint32_t id;             ///< Unique entity identifier
-    uint16_t type;           ///< Entity type
-    float x;                 ///< X position
-    float y;                 ///< Y position
-    float velocityX = 10.0f; ///< Horizontal velocity
-    float velocityY = 0.0f;  ///< Vertical velocity
-    int height = 0;          ///< Hitbox height
-    int width = 0;           ///< Hitbox width
-    bool is_collide = false; ///< Flag indicating if the entity has collided and should be destroyed.
+struct ClientBandwidth {
+    uint32_t playerId;   ///< Player identifier
+    uint32_t kbps;       ///< Budget, BandwidthBudget::UNLIMITED for none
+    float usedKbps;      ///< Rate over the last second
+    uint64_t bytes;      ///< Bytes sent since the player joined
+    uint64_t throttled;  ///< Entity updates held back by the budget
 };
 
 /**
@@ -88,8 +102,10 @@ public:
     /**
      * @brief Adds a new player to the game.
      * @param playerId The unique ID of the player.
+     * @param username The username of the player.
+     * @param protocolVersion UDP protocol version negotiated with the player.
      */
-    void addPlayer(uint32_t playerId, const char* username);
+    void addPlayer(uint32_t playerId, const char* username, uint8_t protocolVersion);
 
     /**
      * @brief Updates the UDP address associated with a player.
@@ -99,24 +115,76 @@ public:
     void updatePlayerUdpAddr(uint32_t playerId, const sockaddr_in& udpAddr);
 
     /**
-     * @brief Retrieves a player by ID.
-     * @param playerId The player's ID.
-     * @return Pointer to the Player struct, or nullptr if not found.
+     * @brief Broadcasts the current game state to all connected players via UDP.
+     * @param udpServer Reference to the UDP server instance.
      */
-    Player* getPlayer(uint32_t playerId);
+    void broadcastGameState(UDPServer& udpServer);
 
     /**
-     * @brief Retrieves a player by ID (const version).
-     * @param playerId The player's ID.
-     * @return Const pointer to the Player struct, or nullptr if not found.
+     * @brief Queues a player input, applied at the start of the next update().
+     * Safe to call from the network thread while the room is ticking.
+     * @param pkt The received player input packet.
+     * @return true if queued, false if the queue is full and the input was dropped.
      */
-    const Player* getPlayer(uint32_t playerId) const;
+    bool queueInput(const PlayerInputPacket& pkt);
 
     /**
-     * @brief Broadcasts the current game state to all connected players via UDP.
-     * @param udpServer Reference to the UDP server instance.
+     * @brief Queues the departure of a player who left, applied by the next update().
+     * Safe to call from any thread while the room is ticking.
+     * @param playerId The ID of the player to disconnect.
      */
-    void broadcastGameState(UDPServer& udpServer);
+    void queueDisconnect(uint32_t playerId);
+
+    /**
+     * @brief Queues the kick of a player, applied by the next update().
+     * Safe to call from any thread while the room is ticking.
+     * @param playerId The ID of the player to kick.
+     */
+    void queueKick(uint32_t playerId);
+
+    /**
+     * @brief Tells whether update() removed players since the last call, and clears the flag.
+     * @return true if the room must be published again.
+     */
+    bool takeDepartures() { return _departed.exchange(false, std::memory_order_acq_rel); }
+
+    /**
+     * @brief Moves out the players the tick removed whose route can be dropped.
+     * A kicked player is only listed once its departing reliable channel is
+     * done, so its acknowledgements keep reaching the room until then.
+     * @param playerIds Receives the player IDs, appended.
+     */
+    void takeReleasedPlayers(std::vector<uint32_t>& playerIds);
+
+    /**
+     * @brief Returns the number of inputs dropped because the input queue was full.
+     * @return uint64_t The count since the room was created.
+     */
+    uint64_t getDroppedInputs() const { return _droppedInputs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the phase timings of this room's ticks.
+     * @return const TickProfiler& The histograms, safe to read while the room ticks.
+     */
+    const TickProfiler& getProfiler() const { return _profiler; }
+
+    /**
+     * @brief Returns the entity update filter of this room.
+     * @return const InterestManager& The filter, whose counters are safe to read while the room ticks.
+     */
+    const InterestManager& getInterestManager() const { return _interest; }
+
+    /**
+     * @brief Sets the bandwidth budget of every player of the room, from the next tick.
+     * @param kbps Kilobits per second, BandwidthBudget::UNLIMITED for none.
+     */
+    void setBandwidthBudget(uint32_t kbps);
+
+    /**
+     * @brief Returns the budget use of each player.
+     * @return std::vector<ClientBandwidth> One entry per player.
+     */
+    std::vector<ClientBandwidth> getBandwidthUsage();
 
     /**
      * @brief Handles a player input packet, updating state and calculating packet loss.
@@ -125,6 +193,27 @@ public:
      */
     void handlePlayerInput(const PlayerInputPacket& pkt, UDPServer& udpServer);
 
+    /**
+     * @brief Records that a player received a snapshot, making it usable as delta baseline.
+     * @param playerId The player's ID.
+     * @param snapshotId The acknowledged snapshot.
+     */
+    void acknowledgeSnapshot(uint32_t playerId, uint32_t snapshotId);
+
+    /**
+     * @brief Applies the reliable channel acknowledgement carried by a player input.
+     * @param playerId The player's ID.
+     * @param ack PlayerInputPacket::reliableAck.
+     * @param ackBits PlayerInputPacket::reliableAckBits.
+     */
+    void acknowledgeReliable(uint32_t playerId, uint16_t ack, uint32_t ackBits);
+
+    /**
+     * @brief Sums the reliable channel counters of the players in the room.
+     * @param total Receives the sums; rttMs and rtoMs are averaged over the players with an RTT sample.
+     */
+    void getReliableCounters(Network::ReliableStats& total);
+
     /**
      * @brief Updates the last processed input tick for a player.
      * @param playerId The player's ID.
@@ -148,9 +237,14 @@ public:
 
     /**
      * @brief Updates positions and states of all entities.
+     * Positions are integrated by the SIMD kernel selected at startup, which
+     * also flags out-of-bounds and collided entities in _destroyMask; packets
+     * and removals then walk the mask bits. Entity updates are then sent by
+     * replicateEntities() for each player.
      * @param udpServer Reference to the UDP server for updates.
+     * @param deltaTime Simulated time of the tick, in seconds.
      */
-    void updateEntities(UDPServer& udpServer);
+    void updateEntities(UDPServer& udpServer, float deltaTime);
 
     /**
      * @brief Spawns a new enemy entity.
@@ -158,13 +252,6 @@ public:
      */
     void createEnemy(UDPServer& udpServer);
 
-    /**
-     * @brief Removes a player from the game.
-     * @param playerId The ID of the player to disconnect.
-     * @param udpServer Reference to the UDP server for notification.
-     */
-    void disconnectPlayer(uint32_t playerId, UDPServer& udpServer);
-
     /**
      * @brief Removes a player from the lobby (without UDP notification).
      * @param playerId The ID of the player to remove.
@@ -177,8 +264,17 @@ public:
      */
     int getPlayerCount();
 
+    /**
+     * @brief Sums the input counters of the players in the room.
+     * @param received Set to the inputs received.
+     * @param lost Set to the inputs estimated as lost.
+     */
+    void getInputCounters(uint64_t& received, uint64_t& lost);
+
     /**
      * @brief Checks and resolves collisions between entities and players.
+     * Hittable entities are bucketed in _collisionGrid, so each projectile and
+     * player is only tested against the entities of the cells it overlaps.
      */
     void handleCollision(UDPServer& udpServer);
     /**
@@ -190,8 +286,15 @@ public:
     /**
      * @brief Updates the game state (entities, collisions, spawning).
      * @param udpServer Reference to the UDP server.
+     * @param deltaTime Simulated time of the tick, in seconds (1 / tick rate).
      */
-    void update(UDPServer& udpServer);
+    void update(UDPServer& udpServer, float deltaTime);
+
+    /**
+     * @brief Spawns the bosses when their time comes and makes the live one shoot.
+     * @param udpServer Reference to the UDP server.
+     */
+    void updateBoss(UDPServer& udpServer);
 
     /**
      * @brief Gets the current status of the game (Lobby or Playing).
@@ -210,25 +313,140 @@ public:
      */
     uint32_t getHostId() const;
     /**
-     * @brief Gets a constant reference to the list of players in the game.
-     * @return A const reference to the vector of players.
+     * @brief Lists the players in the game, copied under the lock since the tick may remove some.
+     * @return std::vector<std::pair<uint32_t, std::string>> The ID and username of each player, host first.
      */
-    const std::vector<Player>& getPlayers() const;
-
-    /**
-     * @brief Kicks a player from the game instance.
-     * Notifies the kicked player and all other players in the room.
-     * @param playerId The ID of the player to kick.
-     * @param udpServer Reference to the UDP server for sending notifications.
-     */
-    void kickPlayer(uint32_t playerId, UDPServer& udpServer);
+    std::vector<std::pair<uint32_t, std::string>> getPlayerNames();
 
 private:
     std::vector<Player> _players; /**< List of players in the game. */
     std::mutex _playersMutex; /**< Mutex to protect access to the _players vector. */
 
-    std::vector<Entity> _entities; /**< List of all entities in the game (enemies, projectiles). */
-    std::mutex _entitiesMutex; /**< Mutex to protect access to the _entities vector. */
+    EntityStore _entities; /**< All entities in the game (enemies, projectiles), stored as structure of arrays. */
+    std::mutex _entitiesMutex; /**< Mutex to protect access to the _entities store. */
+    static constexpr size_t INPUT_QUEUE_SIZE = 1024; /**< Inputs buffered between two ticks. */
+    Network::LockFreeRingBuffer<PlayerInputPacket, INPUT_QUEUE_SIZE> _inputQueue; /**< Inputs pushed by the network thread, drained by update(). */
+    std::array<PlayerInputPacket, 64> _inputBatch; /**< Scratch buffer used to drain _inputQueue. */
+    std::atomic<uint64_t> _droppedInputs{0}; /**< Inputs rejected because _inputQueue was full. */
+
+    /**
+     * @enum RoomCommandType
+     * @brief Player removals requested from outside the tick.
+     */
+    enum class RoomCommandType : uint8_t {
+        DISCONNECT, ///< The player left
+        KICK        ///< The player was kicked from the shell
+    };
+
+    /**
+     * @struct RoomCommand
+     * @brief A player removal waiting for the next tick.
+     */
+    struct RoomCommand {
+        RoomCommandType type; ///< What to do
+        uint32_t playerId;    ///< The player concerned
+    };
+    std::vector<RoomCommand> _commands; /**< Removals queued by the network and shell threads. */
+    std::vector<RoomCommand> _commandBatch; /**< Removals being applied, swapped with _commands by update(). */
+    std::mutex _commandsMutex; /**< Mutex to protect access to _commands. */
+    std::vector<uint32_t> _released; /**< Removed players whose route can be dropped, protected by _commandsMutex. */
+    std::atomic<bool> _departed{false}; /**< Set when applyQueuedCommands() removed a player, cleared by takeDepartures(). */
+    TickProfiler _profiler; /**< Per-phase timings of update(), read by the stats command. */
+    InterestManager _interest; /**< Picks the entity updates each player receives. */
+    uint32_t _tick = 0; /**< Ticks played, staggers the reduced-rate entity updates. */
+    std::atomic<uint32_t> _budgetKbps{BandwidthBudget::DEFAULT_KBPS}; /**< Bandwidth budget of each player. */
+    static constexpr uint32_t PRIORITY_PRUNE_INTERVAL = 64; /**< Ticks between two cleanups of the destroyed entities' priorities. */
+    std::vector<uint32_t> _aliveIndices; /**< Entities surviving the current tick, scratch reused between ticks. */
+
+    /**
+     * @struct ReplicationCandidate
+     * @brief An entity update due for the player being replicated.
+     */
+    struct ReplicationCandidate {
+        PriorityAccumulator::Entry* entry; ///< The entity's priority for the player
+        uint32_t index;                    ///< The entity's index in _entities
+    };
+    std::vector<ReplicationCandidate> _replicationQueue; /**< Due updates of one player, scratch reused between players. */
+    std::vector<EntityUpdatePacket> _packedUpdates; /**< Updates of one protocol 2 player, packed once the budget is spent. */
+    static constexpr size_t PACKED_UPDATE_CAPACITY = MAX_UDP_PACKET_SIZE / 2; /**< Largest ENTITY_UPDATE_PACKED message, so it shares bundles with other messages. */
+
+    /**
+     * @brief Sends a player the entity updates it is due, most starved first, within its budget.
+     * Protocol 2 players get them bit-packed in ENTITY_UPDATE_PACKED messages.
+     * Called with _entitiesMutex and _playersMutex held.
+     * @param destPlayer The player.
+     * @param udpServer Reference to the UDP server.
+     */
+    void replicateEntities(Player& destPlayer, UDPServer& udpServer);
+
+    /**
+     * @brief Queues a message for a player and charges it to the player's budget.
+     * @param destPlayer The recipient.
+     * @param data The message.
+     * @param length Its size.
+     * @param udpServer Reference to the UDP server.
+     */
+    void sendTo(Player& destPlayer, const char* data, size_t length, UDPServer& udpServer);
+
+    /**
+     * @brief Queues a fixed-size message for a player and charges it to the player's budget.
+     * @tparam T Type of the message structure.
+     * @param destPlayer The recipient.
+     * @param msg The message.
+     * @param udpServer Reference to the UDP server.
+     */
+    template<typename T>
+    void sendTo(Player& destPlayer, const T& msg, UDPServer& udpServer)
+    {
+        sendTo(destPlayer, reinterpret_cast<const char*>(&msg), sizeof(T), udpServer);
+    }
+
+    /**
+     * @brief Queues a message on the player's reliable channel.
+     * Players before PROTOCOL_VERSION_RELIABLE get it through sendTo(), as do
+     * the others when their channel is full. Called with _playersMutex held.
+     * @param destPlayer The recipient.
+     * @param data The message.
+     * @param length Its size, at most Network::MAX_RELIABLE_MESSAGE_SIZE.
+     * @param udpServer Reference to the UDP server.
+     */
+    void sendReliable(Player& destPlayer, const char* data, size_t length, UDPServer& udpServer);
+
+    /**
+     * @brief Queues a fixed-size message on the player's reliable channel.
+     * @tparam T Type of the message structure.
+     * @param destPlayer The recipient.
+     * @param msg The message.
+     * @param udpServer Reference to the UDP server.
+     */
+    template<typename T>
+    void sendReliable(Player& destPlayer, const T& msg, UDPServer& udpServer)
+    {
+        sendReliable(destPlayer, reinterpret_cast<const char*>(&msg), sizeof(T), udpServer);
+    }
+
+    /**
+     * @brief Sends the reliable messages not acknowledged in time, and those waiting for room in the window.
+     * Also serves the channels of kicked players, dropped once idle or past their deadline.
+     * @param udpServer Reference to the UDP server.
+     */
+    void resendReliable(UDPServer& udpServer);
+
+    /**
+     * @struct DepartingChannel
+     * @brief Reliable channel of a kicked player, kept to deliver YOU_HAVE_BEEN_KICKED.
+     */
+    struct DepartingChannel {
+        uint32_t playerId;                                     ///< The kicked player
+        sockaddr_in udpAddr;                                   ///< Where its messages go
+        Network::ReliableSender reliable;                      ///< Its channel, the kick notice last
+        Network::ReliableSender::Clock::time_point deadline;   ///< When to give up on the acknowledgements
+    };
+    std::vector<DepartingChannel> _departing; /**< Channels of kicked players, protected by _playersMutex. */
+    static constexpr std::chrono::seconds KICK_LINGER{3}; /**< How long a kicked player's channel is kept at most. */
+    static constexpr float REFERENCE_TICK_RATE = 60.0f; /**< Entity velocities are in pixels per tick at this rate. */
+    std::vector<uint64_t> _destroyMask; /**< One bit per entity, set by the integration kernel for entities to destroy. */
+    SpatialGrid _collisionGrid{1920.0f, 1080.0f}; /**< Collision broadphase over the playfield, rebuilt every tick. */
     uint32_t _nextEntityId = 1; /**< Counter for assigning unique entity IDs. */
     /**
      * @brief Checks for AABB collision between two rectangular objects.
@@ -243,13 +461,76 @@ private:
      * @return true if the objects are colliding, false otherwise.
      */
     bool checkCollision(float x1, float y1, int w1, int h1, float x2, float y2, int w2, int h2);
+
+    /**
+     * @brief Applies the inputs queued since the last tick, in arrival order.
+     * @param udpServer Reference to the UDP server for creating shots.
+     */
+    void applyQueuedInputs(UDPServer& udpServer);
+
+    /**
+     * @brief Applies the removals queued since the last tick, after the inputs.
+     * Players are only erased here, so the tick never sees one vanish.
+     * @param udpServer Reference to the UDP server for notifications.
+     * @return size_t The number of players removed.
+     */
+    size_t applyQueuedCommands(UDPServer& udpServer);
+
+    /**
+     * @brief Lists a removed player for takeReleasedPlayers().
+     * @param playerId The player's ID.
+     */
+    void releasePlayer(uint32_t playerId);
+
+    /**
+     * @brief Finds a player by ID. Called with _playersMutex held.
+     * @param playerId The player's ID.
+     * @return Pointer to the Player struct, valid while the lock is held, or nullptr if not found.
+     */
+    Player* findPlayer(uint32_t playerId);
+
+    /**
+     * @brief Removes a player from the game.
+     * @param playerId The ID of the player to disconnect.
+     * @param udpServer Reference to the UDP server for notification.
+     * @return true if the player was in the room.
+     */
+    bool disconnectPlayer(uint32_t playerId, UDPServer& udpServer);
+
+    /**
+     * @brief Kicks a player from the game instance.
+     * Notifies the kicked player and all other players in the room.
+     * @param playerId The ID of the player to kick.
+     * @param udpServer Reference to the UDP server for sending notifications.
+     * @return true if the player was in the room.
+     */
+    bool kickPlayer(uint32_t playerId, UDPServer& udpServer);
     float _gameTime = 0.0f; /**< Total time the game has been running in the PLAYING state. */
     std::chrono::steady_clock::time_point _lastEnemySpawnTime = std::chrono::steady_clock::now(); /**< Time point of the last enemy spawn. */
     std::chrono::steady_clock::time_point _lastGlobalSyncTime = std::chrono::steady_clock::now(); /**< Time point of the last global state synchronization. */
     static constexpr std::chrono::milliseconds GLOBAL_SYNC_INTERVAL = std::chrono::milliseconds(100); /**< Interval for global state synchronization. */
-    GameStatus _status; /**< Current status of the game (Lobby/Playing). */
+    static constexpr uint32_t RELIABLE_SYNC_DIVIDER = 10; /**< Protocol 3 players get one snapshot in this many, once one was acknowledged. */
+    std::atomic<GameStatus> _status; /**< Current status of the game (Lobby/Playing), set by the lobby and read by the tick. */
+
+    int _bossHP = 0; /**< Health of the current boss. */
+    int _bossLevel = 0; /**< 0: None, 1: Boss1, 2: Cooldown, 3: Boss2, 4: Victory. */
+    uint32_t _bossEntityId = 0; /**< Entity id of the last boss spawned, looked up in _entities by id. */
+    float _lastBossShootTime = 0.0f; /**< Game time of the last boss shot. */
+    float _bossDeathTime = 0.0f; /**< Game time at which the first boss died. */
 
-    void sendGlobalStateSync(UDPServer& udpServer); /**< Sends a global state synchronization packet to all clients. */
+    static constexpr size_t MAX_SNAPSHOT_SIZE = 4 * FRAGMENT_PAYLOAD_SIZE; /**< Largest snapshot sent, split into up to 4 fragments. */
+    uint32_t _nextSnapshotId = 1; /**< Id of the next entity snapshot. */
+    std::vector<SyncedEntityState> _snapshotEntities; /**< Scratch list of the current entity states, reused between syncs. */
+
+    /**
+     * @brief Sends each client a SNAPSHOT delta-encoded against the last snapshot it acknowledged.
+     * Falls back to a full snapshot when the client has no usable baseline.
+     * Protocol 2 clients get a SNAPSHOT_PACKED instead. Protocol 3 clients, whose
+     * spawns and destroys come on the reliable channel, only get every
+     * RELIABLE_SYNC_DIVIDER-th snapshot once they acknowledged one.
+     * @param udpServer Reference to the UDP server.
+     */
+    void sendGlobalStateSync(UDPServer& udpServer);
 };
 
 
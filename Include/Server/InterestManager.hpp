@@ -0,0 +1,134 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** InterestManager
+*/
+
+#ifndef INTERESTMANAGER_HPP_
+#define INTERESTMANAGER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file InterestManager.hpp
+ * @brief Per-recipient relevance of entities, used to thin out ENTITY_UPDATE traffic.
+ */
+
+/**
+ * @enum RelevanceTier
+ * @brief How often an entity's position is sent to a player.
+ */
+enum class RelevanceTier : uint8_t {
+    HIGH,   ///< Every tick
+    MEDIUM, ///< Every InterestManager::MEDIUM_INTERVAL ticks
+    LOW     ///< Every InterestManager::LOW_INTERVAL ticks
+};
+
+static constexpr size_t RELEVANCE_TIER_COUNT = 3; ///< Number of RelevanceTier values
+
+/**
+ * @enum ReplicationOutcome
+ * @brief What happened to an entity update on a tick.
+ */
+enum class ReplicationOutcome : uint8_t {
+    SENT,      ///< Queued for the client
+    DEFERRED,  ///< Not due yet in its tier
+    THROTTLED  ///< Due, but the client's bandwidth budget was spent
+};
+
+/**
+ * @struct ReplicatedEntity
+ * @brief The state of an entity the relevance score is computed from.
+ */
+struct ReplicatedEntity {
+    uint32_t id;       ///< Entity id, staggers the ticks reduced-rate entities are sent on
+    uint16_t type;     ///< Entity type (1/4 player shots, 2/3 enemies, 10 boss, 11 boss projectile)
+    float x;           ///< Left edge
+    float y;           ///< Top edge
+    float velocityX;   ///< Pixels per tick
+    float velocityY;   ///< Pixels per tick
+    int width;         ///< Hitbox width
+    int height;        ///< Hitbox height
+};
+
+/**
+ * @struct ReplicationStats
+ * @brief Entity updates sent and deferred, by tier.
+ */
+struct ReplicationStats {
+    std::array<uint64_t, RELEVANCE_TIER_COUNT> sent{};      ///< Updates queued
+    std::array<uint64_t, RELEVANCE_TIER_COUNT> deferred{};  ///< Updates skipped until the entity's next slot
+    std::array<uint64_t, RELEVANCE_TIER_COUNT> throttled{}; ///< Due updates held back by the bandwidth budget
+};
+
+/**
+ * @class InterestManager
+ * @brief Decides when each player is due an ENTITY_UPDATE of each entity.
+ *
+ * Each (entity, player) pair gets a relevance score from the entity type,
+ * its distance to the player's ship and, for hostile entities, how soon it
+ * reaches the ship's row. The score picks a tier: high relevance entities are
+ * due every tick, the others at a reduced rate, on ticks staggered by entity
+ * id so the load stays even. Due updates then go through the client's
+ * BandwidthBudget. Spawns and destructions are never filtered, and the
+ * periodic snapshot still carries every entity, which bounds how stale a low
+ * relevance entity can get.
+ */
+class InterestManager {
+public:
+    static constexpr uint32_t MEDIUM_INTERVAL = 2; /**< Ticks between two updates of a MEDIUM entity */
+    static constexpr uint32_t LOW_INTERVAL = 4; /**< Ticks between two updates of a LOW entity */
+    static constexpr float FAR_DISTANCE = 1200.0f; /**< Distance at which proximity stops counting */
+    static constexpr float THREAT_HORIZON = 90.0f; /**< Ticks ahead an approaching hostile counts as a threat */
+    static constexpr float THREAT_LANE = 150.0f; /**< Vertical gap within which a hostile is on the ship's row */
+    static constexpr float HIGH_RELEVANCE = 0.5f; /**< Lowest score of the HIGH tier */
+    static constexpr float MEDIUM_RELEVANCE = 0.25f; /**< Lowest score of the MEDIUM tier */
+
+    /**
+     * @brief Scores an entity for one player.
+     * @param entity The entity.
+     * @param playerX Left edge of the player's ship.
+     * @param playerY Top edge of the player's ship.
+     * @return float The score, higher is more relevant. The boss always scores 1.
+     */
+    static float relevance(const ReplicatedEntity& entity, float playerX, float playerY);
+
+    /**
+     * @brief Maps a score to its tier.
+     * @param score A relevance() result.
+     * @return RelevanceTier The tier.
+     */
+    static RelevanceTier tierOf(float score);
+
+    /**
+     * @brief Tells whether an entity of a given tier is due on this tick.
+     * @param tier The entity's tier for the player.
+     * @param entityId The entity, staggers the reduced-rate ticks.
+     * @param tick The room tick number.
+     * @return true if an update is due.
+     */
+    static bool isDue(RelevanceTier tier, uint32_t entityId, uint32_t tick);
+
+    /**
+     * @brief Counts what happened to an entity update.
+     * @param tier The entity's tier for the player.
+     * @param outcome Sent, deferred or throttled.
+     */
+    void record(RelevanceTier tier, ReplicationOutcome outcome);
+
+    /**
+     * @brief Adds the counters of this room to @p out.
+     * @param out Accumulated stats, safe to call while the room ticks.
+     */
+    void addTo(ReplicationStats& out) const;
+
+private:
+    std::array<std::atomic<uint64_t>, RELEVANCE_TIER_COUNT> _sent{}; /**< Updates queued, by tier */
+    std::array<std::atomic<uint64_t>, RELEVANCE_TIER_COUNT> _deferred{}; /**< Updates skipped, by tier */
+    std::array<std::atomic<uint64_t>, RELEVANCE_TIER_COUNT> _throttled{}; /**< Updates held back by the budget, by tier */
+};
+
+#endif /* !INTERESTMANAGER_HPP_ */
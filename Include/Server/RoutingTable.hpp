@@ -0,0 +1,130 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** RoutingTable
+*/
+
+#ifndef ROUTINGTABLE_HPP_
+#define ROUTINGTABLE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include "CrossPlatformSocket.hpp"
+
+class Game;
+
+/**
+ * @file RoutingTable.hpp
+ * @brief Index used to dispatch incoming UDP packets to their room.
+ */
+
+/**
+ * @class RoutingTable
+ * @brief Concurrent playerId -> room and address -> playerId maps.
+ *
+ * Both maps are split into SHARD_COUNT shards, each with its own
+ * std::shared_mutex, so the UDP thread only takes a shared lock on one shard
+ * per lookup while the lobby updates other shards. Lookups return a
+ * shared_ptr, so a room deleted during dispatch stays alive until the packet
+ * has been handled.
+ */
+class RoutingTable {
+public:
+    static constexpr size_t SHARD_COUNT = 16; /**< Number of shards of each map */
+    static constexpr uint32_t NO_PLAYER = std::numeric_limits<uint32_t>::max(); /**< Returned by findPlayer() when the address is unknown */
+
+    /**
+     * @brief Routes a player to a room, replacing any previous route and address.
+     * @param playerId The player.
+     * @param roomId Id of the room in ServerManager.
+     * @param game The room.
+     */
+    void bindPlayer(uint32_t playerId, int roomId, std::shared_ptr<Game> game);
+
+    /**
+     * @brief Removes the route and the address of a player.
+     * @param playerId The player.
+     */
+    void unbindPlayer(uint32_t playerId);
+
+    /**
+     * @brief Removes the routes and addresses of every player of a room.
+     * @param roomId Id of the room.
+     * @return size_t Number of players unbound.
+     */
+    size_t unbindRoom(int roomId);
+
+    /**
+     * @brief Finds the room of a player.
+     * @param playerId The player.
+     * @return std::shared_ptr<Game> The room, or nullptr if the player is not routed.
+     */
+    std::shared_ptr<Game> findRoom(uint32_t playerId) const;
+
+    /**
+     * @brief Associates the UDP address of a player, the first time it is seen.
+     * Like Game::updatePlayerUdpAddr(), the first address wins.
+     * @param addr Source address of the packet.
+     * @param playerId The player the packet claims to come from.
+     * @return true if the address was just bound, false if the player is unknown or already has one.
+     */
+    bool bindAddress(const sockaddr_in& addr, uint32_t playerId);
+
+    /**
+     * @brief Finds the player bound to a UDP address.
+     * @param addr Source address of a packet.
+     * @return uint32_t The player, or NO_PLAYER.
+     */
+    uint32_t findPlayer(const sockaddr_in& addr) const;
+
+    /**
+     * @brief Number of routed players.
+     * @return size_t The count, summed over the shards.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @struct Route
+     * @brief Where a player's packets go.
+     */
+    struct Route {
+        int roomId;
+        std::shared_ptr<Game> game;
+        uint64_t addressKey = 0;
+        bool hasAddress = false;
+    };
+
+    struct PlayerShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint32_t, Route> routes;
+    };
+
+    struct AddressShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, uint32_t> players;
+    };
+
+    static uint64_t addressKey(const sockaddr_in& addr);
+
+    PlayerShard& playerShard(uint32_t playerId) { return _players[playerId % SHARD_COUNT]; }
+    const PlayerShard& playerShard(uint32_t playerId) const { return _players[playerId % SHARD_COUNT]; }
+    AddressShard& addressShard(uint64_t key) { return _addresses[key % SHARD_COUNT]; }
+    const AddressShard& addressShard(uint64_t key) const { return _addresses[key % SHARD_COUNT]; }
+
+    /**
+     * @brief Removes an address. Called with the owning player shard locked.
+     */
+    void eraseAddress(uint64_t key, uint32_t playerId);
+
+    std::array<PlayerShard, SHARD_COUNT> _players;
+    std::array<AddressShard, SHARD_COUNT> _addresses;
+};
+
+#endif /* !ROUTINGTABLE_HPP_ */
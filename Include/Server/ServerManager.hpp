@@ -16,6 +16,11 @@
 #include "Network/TCP/TCPServer.hpp"
 #include "Network/ITCPHandler.hpp"
 #include "Network/UDP/UDPServer.hpp"
+#include "Server/RoutingTable.hpp"
+#include "Server/TickScheduler.hpp"
+#include "Server/WorkStealingPool.hpp"
+#include "Network/Metrics/MetricsRegistry.hpp"
+#include "Network/Metrics/MetricsExporter.hpp"
 #include "Clock.hpp"
 
 /**
@@ -37,8 +42,15 @@ public:
     /**
      * @brief Construct a new ServerManager object.
      * Initializes the TCP and UDP servers and the clock.
+     * @param tickRate Game loop rate in Hz (30, 60 or 120).
+     * @param metricsPort Loopback port of the Prometheus endpoint, 0 to disable it.
+     * @param backpressure What the UDP server drops when its outgoing queue fills up.
+     * @param clientKbps Bandwidth budget of each player, BandwidthBudget::UNLIMITED for none.
      */
-    ServerManager();
+    explicit ServerManager(uint32_t tickRate = TickScheduler::DEFAULT_TICK_RATE,
+                           unsigned short metricsPort = Network::MetricsExporter::DEFAULT_PORT,
+                           Network::BackpressurePolicy backpressure = Network::BackpressurePolicy::DROP_BY_PRIORITY,
+                           uint32_t clientKbps = BandwidthBudget::DEFAULT_KBPS);
 
     /**
      * @brief Destroy the ServerManager object.
@@ -77,9 +89,10 @@ public:
      * @param roomId The ID of the room to join.
      * @param playerId The ID of the player.
      * @param username The username of the player.
+     * @param protocolVersion UDP protocol version negotiated with the player.
      * @return true if the join was successful, false otherwise.
      */
-    bool onJoinRoom(int roomId, uint32_t playerId, const std::string& username) override;
+    bool onJoinRoom(int roomId, uint32_t playerId, const std::string& username, uint8_t protocolVersion) override;
 
     /**
      * @brief Handles a player disconnecting from a room.
@@ -120,12 +133,75 @@ public:
 private:
     Clock _clock; /**< Clock for managing game time. */
     std::map<int, std::shared_ptr<Game>> _rooms; /**< Map of active game rooms. */
+    RoutingTable _routes; /**< Routes incoming UDP packets to the room of their player. */
     TCPServer _tcpServer; /**< The TCP server instance. */
     UDPServer _udpServer; /**< The UDP server instance. */
     std::atomic<bool> _running; /**< Flag indicating if the server manager is running. */
+    TickScheduler _scheduler; /**< Paces the game loop at a fixed tick rate. */
+    WorkStealingPool _roomPool; /**< Runs the room ticks in parallel. */
+    std::vector<std::pair<int, std::shared_ptr<Game>>> _tickRooms; /**< Rooms updated by the current tick, by ID, kept alive until it ends. */
+    std::vector<uint32_t> _releasedPlayers; /**< Players whose route is dropped after the current tick, scratch reused between ticks. */
     int _nextRoomId = 0; /**< Counter for assigning unique room IDs. */
     std::mutex _serverMutex; /**< Mutex for thread-safe access to shared resources. */
     std::thread _shellThread; /**< Thread for handling the interactive server shell. */
+    Network::MetricsRegistry _metrics; /**< Counters and gauges served by _metricsExporter. */
+    Network::Counter& _droppedInputs; /**< Inputs rejected by a full room input queue, over all rooms. */
+    unsigned short _metricsPort; /**< Port of the metrics endpoint, 0 when disabled. */
+    Network::MetricsExporter _metricsExporter; /**< Serves _metrics over HTTP. */
+    std::atomic<uint32_t> _clientKbps; /**< Bandwidth budget given to the players of every room. */
+
+    /**
+     * @struct RoomMetrics
+     * @brief Room gauges, summed over all rooms at scrape time.
+     */
+    struct RoomMetrics {
+        uint64_t rooms = 0;
+        uint64_t playing = 0;
+        uint64_t players = 0;
+        uint64_t inputsReceived = 0;
+        uint64_t inputsLost = 0;
+        uint64_t bytesSent = 0;
+        uint64_t updatesThrottled = 0;
+        Network::ReliableStats reliable; ///< Reliable channel counters; rttMs and rtoMs are averaged over the rooms
+    };
+
+    RoomMetrics _scrapedRooms; /**< Room sums of the current scrape, written and read under the registry lock. */
+    UDPServerStats _scrapedUdp; /**< UDP counters of the current scrape, written and read under the registry lock. */
+
+    /**
+     * @brief Registers the server metrics, read from the servers and rooms at scrape time.
+     */
+    void registerMetrics();
+
+    /**
+     * @brief Sums the room gauges. Copies the room list under _serverMutex.
+     * @return RoomMetrics The sums.
+     */
+    RoomMetrics collectRoomMetrics();
+
+    /**
+     * @brief Finds the room a UDP packet must be handled by.
+     * @param playerId The player the packet claims to come from.
+     * @param clientAddr Source address of the packet.
+     * @return std::shared_ptr<Game> The room, or nullptr if the player is not routed or the address belongs to another player.
+     */
+    std::shared_ptr<Game> routePacket(uint32_t playerId, const sockaddr_in& clientAddr);
+
+    /**
+     * @brief Pushes the state of a room to the TCP clients: room list delta and lobby state.
+     * Must be called with _serverMutex held, which keeps the pushes in the order of the changes.
+     * @param roomId The room that changed, or was deleted.
+     */
+    void publishRoom(int roomId);
+
+    /**
+     * @brief Publishes the rooms of the tick that just ended whose players left during it,
+     * and drops the routes of the players they released.
+     * Disconnects and kicks in a game are applied by the room tick, so the room
+     * is only published once the players are really gone.
+     */
+    void publishDepartures();
+
     /**
      * @brief The loop that reads and processes shell commands from stdin.
      */
@@ -0,0 +1,118 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** SpatialGrid
+*/
+
+#ifndef SPATIALGRID_HPP_
+#define SPATIALGRID_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file SpatialGrid.hpp
+ * @brief Uniform grid broadphase used by Game::handleCollision.
+ */
+
+/**
+ * @class SpatialGrid
+ * @brief Buckets axis-aligned boxes into fixed-size cells covering the playfield.
+ *
+ * The grid is rebuilt every tick: clear(), insert() every candidate, build(),
+ * then query() with the boxes to test. Boxes overlapping several cells are
+ * stored in each of them, and boxes outside the playfield are clamped into
+ * the border cells, so a query returns every box that may overlap. The
+ * caller still runs the exact AABB test. Buffers keep their capacity between
+ * ticks, so a rebuild does not allocate once the entity count is stable.
+ */
+class SpatialGrid {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 128.0f; /**< Cell side, larger than every regular hitbox */
+
+    /**
+     * @brief Construct a new SpatialGrid covering [0, width) x [0, height).
+     * @param width Playfield width.
+     * @param height Playfield height.
+     * @param cellSize Side of a cell.
+     */
+    SpatialGrid(float width, float height, float cellSize = DEFAULT_CELL_SIZE);
+
+    /**
+     * @brief Removes every box, keeping the allocated memory.
+     */
+    void clear();
+
+    /**
+     * @brief Adds a box. It becomes visible to query() after build().
+     * @param index Value returned to query() callbacks, usually an index in the entity vector.
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param w Width.
+     * @param h Height.
+     */
+    void insert(uint32_t index, float x, float y, int w, int h);
+
+    /**
+     * @brief Sorts the inserted boxes into their cells.
+     */
+    void build();
+
+    /**
+     * @brief Calls @p visit with the index of every box sharing a cell with the query box.
+     * An index can be visited more than once when both boxes span several cells.
+     * @tparam Visitor Callable taking a uint32_t index.
+     * @param x Left edge.
+     * @param y Top edge.
+     * @param w Width.
+     * @param h Height.
+     * @param visit The callback.
+     */
+    template<typename Visitor>
+    void query(float x, float y, int w, int h, Visitor&& visit) const
+    {
+        int x0 = cellX(x);
+        int x1 = cellX(x + w);
+        int y0 = cellY(y);
+        int y1 = cellY(y + h);
+
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                size_t cell = static_cast<size_t>(cy * _columns + cx);
+                for (uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+                    visit(_cellItems[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of boxes inserted since the last clear().
+     * @return size_t The number of boxes.
+     */
+    size_t size() const { return _boxes.size(); }
+
+private:
+    /**
+     * @struct Box
+     * @brief Inserted box, stored as its range of cells.
+     */
+    struct Box {
+        uint32_t index;
+        int x0, y0, x1, y1;
+    };
+
+    int cellX(float x) const { return std::clamp(static_cast<int>(std::floor(x * _inverseCellSize)), 0, _columns - 1); }
+    int cellY(float y) const { return std::clamp(static_cast<int>(std::floor(y * _inverseCellSize)), 0, _rows - 1); }
+
+    float _inverseCellSize;          /**< 1 / cell size */
+    int _columns;                    /**< Number of cells along X */
+    int _rows;                       /**< Number of cells along Y */
+    std::vector<Box> _boxes;         /**< Boxes inserted this tick */
+    std::vector<uint32_t> _cellStart; /**< Offset of each cell in _cellItems, plus a final end offset */
+    std::vector<uint32_t> _cellItems; /**< Box indexes grouped by cell */
+};
+
+#endif /* !SPATIALGRID_HPP_ */
@@ -0,0 +1,163 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** TickProfiler
+*/
+
+#ifndef TICKPROFILER_HPP_
+#define TICKPROFILER_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file TickProfiler.hpp
+ * @brief Per-phase timing histograms of a room tick.
+ */
+
+/**
+ * @enum TickPhase
+ * @brief The parts of Game::update() that are timed.
+ */
+enum class TickPhase : uint8_t {
+    INPUTS,      /**< applyQueuedInputs */
+    ENTITIES,    /**< updateEntities */
+    COLLISIONS,  /**< handleCollision */
+    BROADCAST,   /**< broadcastGameState */
+    LEVEL,       /**< updateGameLevel */
+    BOSS,        /**< Boss spawn and shots */
+    SPAWN,       /**< createEnemy */
+    GLOBAL_SYNC, /**< sendGlobalStateSync */
+    TICK,        /**< The whole update() of a playing room */
+    COUNT
+};
+
+static constexpr size_t TICK_PHASE_COUNT = static_cast<size_t>(TickPhase::COUNT);
+
+/**
+ * @class PhaseHistogram
+ * @brief Log-linear histogram of durations in microseconds, in the spirit of HdrHistogram.
+ *
+ * Values below SUB_BUCKETS get one bucket each. Above that, every power of two
+ * is split into SUB_BUCKETS linear buckets, so any value is reported within
+ * 1 / SUB_BUCKETS (about 6 %) of its real value, from 1 us to over a minute,
+ * in a fixed array of counters. record() is a relaxed atomic increment, so
+ * the room worker records while the shell reads without a lock.
+ */
+class PhaseHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4; /**< log2 of the buckets per power of two */
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_VALUE_BITS = 27; /**< Larger values (over 134 s) are clamped */
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @struct Snapshot
+     * @brief Plain copy of histogram counters, which can be merged and queried.
+     */
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        uint64_t samples = 0;
+        uint64_t maxUs = 0;
+
+        /**
+         * @brief Value at a percentile.
+         * @param p The percentile, in [0, 100].
+         * @return uint64_t Upper bound of the bucket holding it, in microseconds, 0 without samples.
+         */
+        uint64_t percentile(double p) const;
+    };
+
+    /**
+     * @brief Adds a sample.
+     * @param us Duration in microseconds.
+     */
+    void record(uint64_t us);
+
+    /**
+     * @brief Adds the counters of this histogram to a snapshot.
+     * @param out The snapshot, possibly holding other histograms already.
+     */
+    void addTo(Snapshot& out) const;
+
+    /**
+     * @brief Index of the bucket holding a value.
+     */
+    static size_t bucketIndex(uint64_t us);
+
+    /**
+     * @brief Highest value held by a bucket.
+     */
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> _counts{};
+    std::atomic<uint64_t> _maxUs{0};
+};
+
+/**
+ * @brief One snapshot per TickPhase.
+ */
+using TickProfile = std::array<PhaseHistogram::Snapshot, TICK_PHASE_COUNT>;
+
+/**
+ * @class TickProfiler
+ * @brief The phase histograms of one room.
+ */
+class TickProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Records the time elapsed since @p start in a phase.
+     * @param phase The phase.
+     * @param start When the phase began.
+     */
+    void record(TickPhase phase, Clock::time_point start)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        _phases[static_cast<size_t>(phase)].record(static_cast<uint64_t>(elapsed));
+    }
+
+    /**
+     * @brief Adds the counters of every phase to a profile.
+     * @param out The profile, possibly holding other rooms already.
+     */
+    void addTo(TickProfile& out) const;
+
+    /**
+     * @brief Name of a phase, as printed by the stats command.
+     */
+    static const char* phaseName(TickPhase phase);
+
+private:
+    std::array<PhaseHistogram, TICK_PHASE_COUNT> _phases;
+};
+
+/**
+ * @class ScopedPhaseTimer
+ * @brief Records the lifetime of a scope in a TickProfiler phase.
+ */
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(TickProfiler& profiler, TickPhase phase, TickProfiler::Clock::time_point start = TickProfiler::Clock::now())
+        : _profiler(profiler), _phase(phase), _start(start)
+    {
+    }
+
+    ~ScopedPhaseTimer() { _profiler.record(_phase, _start); }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    TickProfiler& _profiler;
+    TickPhase _phase;
+    TickProfiler::Clock::time_point _start;
+};
+
+#endif /* !TICKPROFILER_HPP_ */
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** TickScheduler
+*/
+
+#ifndef TICKSCHEDULER_HPP_
+#define TICKSCHEDULER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file TickScheduler.hpp
+ * @brief Fixed-timestep pacing of the server game loop.
+ */
+
+/**
+ * @struct TickStats
+ * @brief Snapshot of the TickScheduler counters.
+ */
+struct TickStats {
+    uint32_t tickRate = 0;      /**< Current tick rate in Hz */
+    uint64_t ticks = 0;         /**< Ticks run since startup */
+    uint64_t overruns = 0;      /**< Ticks whose work took longer than one period */
+    uint64_t catchUpTicks = 0;  /**< Extra ticks run back-to-back because the loop woke up late */
+    uint64_t droppedTicks = 0;  /**< Ticks skipped because the loop fell more than MAX_CATCH_UP_TICKS behind */
+    uint64_t lastTickUs = 0;    /**< Duration of the last tick */
+    uint64_t maxTickUs = 0;     /**< Longest tick */
+    uint64_t totalTickUs = 0;   /**< Sum of all tick durations */
+
+    /**
+     * @brief Average tick duration.
+     * @return double The average in microseconds, 0 before the first tick.
+     */
+    double averageTickUs() const { return ticks ? static_cast<double>(totalTickUs) / ticks : 0.0; }
+};
+
+/**
+ * @class TickScheduler
+ * @brief Runs the game loop at a fixed rate on std::chrono::steady_clock.
+ *
+ * Elapsed wall time is added to an accumulator and consumed one period per
+ * tick, so a late wakeup is caught up with extra ticks instead of slowing the
+ * simulation down, and sleep jitter never accumulates into drift. When the
+ * loop falls more than MAX_CATCH_UP_TICKS behind, the backlog is dropped
+ * rather than replayed in a burst.
+ */
+class TickScheduler {
+public:
+    static constexpr uint32_t DEFAULT_TICK_RATE = 60;  /**< Tick rate used when none is configured */
+    static constexpr uint32_t MAX_CATCH_UP_TICKS = 5;  /**< Most ticks run for a single wakeup */
+
+    /**
+     * @brief Construct a new TickScheduler.
+     * @param tickRate Ticks per second, see isSupportedTickRate().
+     */
+    explicit TickScheduler(uint32_t tickRate = DEFAULT_TICK_RATE);
+
+    /**
+     * @brief Tells whether a tick rate can be used (30, 60 or 120 Hz).
+     * @param tickRate Ticks per second.
+     * @return true if the rate is supported.
+     */
+    static bool isSupportedTickRate(uint32_t tickRate);
+
+    /**
+     * @brief Changes the tick rate. Safe to call from any thread, applied on the next waitForTicks().
+     * @param tickRate Ticks per second.
+     * @return true if the rate is supported and was applied.
+     */
+    bool setTickRate(uint32_t tickRate);
+
+    /**
+     * @brief Returns the configured tick rate.
+     * @return uint32_t Ticks per second.
+     */
+    uint32_t getTickRate() const { return _tickRate.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Sleeps until at least one tick is due.
+     * @return uint32_t Number of ticks to run now, between 1 and MAX_CATCH_UP_TICKS.
+     */
+    uint32_t waitForTicks();
+
+    /**
+     * @brief Simulated time covered by one tick at the rate used by the last waitForTicks().
+     * @return float The tick duration in seconds.
+     */
+    float getTickDelta() const { return 1.0f / static_cast<float>(_activeRate); }
+
+    /**
+     * @brief Records how long a tick took to run.
+     * @param duration Time spent in the tick.
+     */
+    void recordTick(std::chrono::steady_clock::duration duration);
+
+    /**
+     * @brief Returns a snapshot of the counters. Safe to call from any thread.
+     * @return TickStats The current counters.
+     */
+    TickStats getStats() const;
+
+private:
+    std::atomic<uint32_t> _tickRate;                 /**< Requested rate */
+    uint32_t _activeRate;                            /**< Rate the accumulator currently runs at */
+    std::chrono::nanoseconds _period;                /**< Duration of one tick at _activeRate */
+    std::chrono::nanoseconds _accumulator{0};        /**< Wall time not yet consumed by ticks */
+    std::chrono::steady_clock::time_point _lastWake; /**< Last time the accumulator was updated */
+    bool _started = false;                           /**< False until the first waitForTicks() */
+
+    std::atomic<uint64_t> _ticks{0};
+    std::atomic<uint64_t> _overruns{0};
+    std::atomic<uint64_t> _catchUpTicks{0};
+    std::atomic<uint64_t> _droppedTicks{0};
+    std::atomic<uint64_t> _lastTickUs{0};
+    std::atomic<uint64_t> _maxTickUs{0};
+    std::atomic<uint64_t> _totalTickUs{0};
+};
+
+#endif /* !TICKSCHEDULER_HPP_ */
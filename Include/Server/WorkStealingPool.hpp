@@ -0,0 +1,127 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** WorkStealingPool
+*/
+
+#ifndef WORKSTEALINGPOOL_HPP_
+#define WORKSTEALINGPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file WorkStealingPool.hpp
+ * @brief Thread pool used to run the room ticks in parallel.
+ */
+
+/**
+ * @struct PoolStats
+ * @brief Snapshot of the WorkStealingPool counters.
+ */
+struct PoolStats {
+    size_t workers = 0;    /**< Worker threads, the thread calling wait() comes on top */
+    uint64_t executed = 0; /**< Tasks run since startup */
+    uint64_t stolen = 0;   /**< Tasks run by another thread than the one they were queued on */
+};
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed set of threads that run independent tasks in batches.
+ *
+ * Every worker owns a queue, plus one for the thread calling wait(). submit()
+ * spreads the tasks round-robin over those queues. A thread pops the newest
+ * task of its own queue and, once it is empty, steals the oldest task of the
+ * others, so a slow task only delays the tasks queued behind it until an idle
+ * thread picks them up. wait() runs tasks on the calling thread until the whole
+ * batch is done.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Number of workers used by default: one per core, minus the thread calling wait().
+     * @return size_t The worker count, 0 on a single-core host.
+     */
+    static size_t defaultWorkerCount();
+
+    /**
+     * @brief Construct a new WorkStealingPool and start its workers.
+     * @param workers Number of worker threads.
+     */
+    explicit WorkStealingPool(size_t workers = defaultWorkerCount());
+
+    /**
+     * @brief Stops and joins the workers. Tasks still queued are dropped.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queues a task. Exceptions thrown by the task are logged and swallowed.
+     * @param task The task to run.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Runs queued tasks on the calling thread and blocks until every submitted task is done.
+     */
+    void wait();
+
+    /**
+     * @brief Returns a snapshot of the counters. Safe to call from any thread.
+     * @return PoolStats The current counters.
+     */
+    PoolStats getStats() const;
+
+private:
+    /**
+     * @struct Queue
+     * @brief Tasks queued for one thread.
+     */
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief Runs one task, from queue @p home first, then stolen from the others.
+     * @param home Index of the calling thread's queue.
+     * @return true if a task was run.
+     */
+    bool runOne(size_t home);
+
+    /**
+     * @brief Main loop of worker @p index.
+     */
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> _queues; /**< One per worker, the last one belongs to the caller of wait() */
+    std::vector<std::thread> _workers;
+    std::atomic<size_t> _nextQueue{0};           /**< Round-robin cursor of submit() */
+    std::atomic<size_t> _queued{0};              /**< Tasks sitting in a queue */
+    std::atomic<size_t> _pending{0};             /**< Tasks submitted and not finished yet */
+    std::atomic<bool> _stopping{false};
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;      /**< Signals idle workers that tasks were queued */
+    std::mutex _doneMutex;
+    std::condition_variable _doneCondition;      /**< Signals wait() that _pending reached 0 */
+
+    std::atomic<uint64_t> _executed{0};
+    std::atomic<uint64_t> _stolen{0};
+};
+
+#endif /* !WORKSTEALINGPOOL_HPP_ */
@@ -0,0 +1,157 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** BitPackBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Network/PackedUpdate.hpp"
+#include "Network/Snapshot.hpp"
+
+/**
+ * @file BitPackBenchmark.cpp
+ * @brief Compares the raw and bit-packed encodings of snapshots and entity updates.
+ *
+ * Entities are spread over the playfield with ids growing by small random
+ * steps, like the ids the game hands out. Every benchmark reports the bytes
+ * each entity takes on the wire and the time spent per entity.
+ */
+
+static constexpr size_t SNAPSHOT_CAPACITY = 64 * 1024;
+
+static std::vector<SyncedEntityState> buildEntities(size_t count)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> x(-20.0f, 1920.0f);
+    std::uniform_real_distribution<float> y(0.0f, 1080.0f);
+    std::vector<SyncedEntityState> entities;
+    uint32_t id = 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        id += 1 + rng() % 4;
+        entities.push_back({id, static_cast<uint16_t>(1 + rng() % 11), x(rng), y(rng)});
+    }
+    return entities;
+}
+
+static void reportPerEntity(benchmark::State& state, size_t entities, size_t bytes)
+{
+    state.counters["bytes_per_entity"] = static_cast<double>(bytes) / static_cast<double>(entities);
+    state.counters["time_per_entity"] = benchmark::Counter(static_cast<double>(state.iterations() * entities),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void runSnapshotEncode(benchmark::State& state, bool packed)
+{
+    const auto entities = buildEntities(static_cast<size_t>(state.range(0)));
+    std::vector<char> buffer(SNAPSHOT_CAPACITY);
+    std::vector<SyncedEntityState> view;
+    auto encode = packed ? Network::encodeSnapshotPacked : Network::encodeSnapshot;
+    size_t length = 0;
+
+    for (auto _ : state) {
+        length = encode(1, nullptr, entities, buffer.data(), buffer.size(), view);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    if (view.size() != entities.size())
+        state.SkipWithError("Snapshot did not fit");
+    reportPerEntity(state, entities.size(), length);
+}
+
+static void runSnapshotDecode(benchmark::State& state, bool packed)
+{
+    const auto entities = buildEntities(static_cast<size_t>(state.range(0)));
+    std::vector<char> buffer(SNAPSHOT_CAPACITY);
+    std::vector<SyncedEntityState> view;
+    auto encode = packed ? Network::encodeSnapshotPacked : Network::encodeSnapshot;
+    auto decode = packed ? Network::decodeSnapshotPacked : Network::decodeSnapshot;
+    size_t length = encode(1, nullptr, entities, buffer.data(), buffer.size(), view);
+    Network::SnapshotHistory history;
+    std::vector<SyncedEntityState> out;
+
+    for (auto _ : state) {
+        if (!decode(buffer.data(), length, history, out))
+            state.SkipWithError("Snapshot did not decode");
+        benchmark::DoNotOptimize(out.data());
+    }
+    reportPerEntity(state, entities.size(), length);
+}
+
+static void BM_SnapshotEncodeRaw(benchmark::State& state) { runSnapshotEncode(state, false); }
+static void BM_SnapshotEncodePacked(benchmark::State& state) { runSnapshotEncode(state, true); }
+static void BM_SnapshotDecodeRaw(benchmark::State& state) { runSnapshotDecode(state, false); }
+static void BM_SnapshotDecodePacked(benchmark::State& state) { runSnapshotDecode(state, true); }
+
+static std::vector<EntityUpdatePacket> buildUpdates(size_t count)
+{
+    std::vector<EntityUpdatePacket> updates;
+    for (const auto& entity : buildEntities(count)) {
+        EntityUpdatePacket update;
+        update.entityId = entity.entityId;
+        update.timestamp = 0;
+        update.x = entity.x;
+        update.y = entity.y;
+        updates.push_back(update);
+    }
+    return updates;
+}
+
+static void BM_UpdateEncodePacked(benchmark::State& state)
+{
+    const auto updates = buildUpdates(static_cast<size_t>(state.range(0)));
+    std::vector<char> buffer(SNAPSHOT_CAPACITY);
+    size_t length = 0;
+    size_t encoded = 0;
+
+    for (auto _ : state) {
+        length = Network::encodeEntityUpdates(updates.data(), updates.size(), buffer.data(), buffer.size(), encoded);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    if (encoded != updates.size())
+        state.SkipWithError("Updates did not fit");
+    reportPerEntity(state, updates.size(), length);
+}
+
+static void BM_UpdateDecodePacked(benchmark::State& state)
+{
+    const auto updates = buildUpdates(static_cast<size_t>(state.range(0)));
+    std::vector<char> buffer(SNAPSHOT_CAPACITY);
+    size_t encoded = 0;
+    size_t length = Network::encodeEntityUpdates(updates.data(), updates.size(), buffer.data(), buffer.size(), encoded);
+    std::vector<EntityUpdatePacket> out;
+
+    for (auto _ : state) {
+        if (!Network::decodeEntityUpdates(buffer.data(), length, out))
+            state.SkipWithError("Updates did not decode");
+        benchmark::DoNotOptimize(out.data());
+    }
+    reportPerEntity(state, updates.size(), length);
+}
+
+/** One raw ENTITY_UPDATE message per entity, copied the way UDPServer::queueMessage bundles them. */
+static void BM_UpdateEncodeRaw(benchmark::State& state)
+{
+    const auto updates = buildUpdates(static_cast<size_t>(state.range(0)));
+    std::vector<char> buffer(updates.size() * sizeof(EntityUpdatePacket));
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < updates.size(); ++i)
+            std::memcpy(buffer.data() + i * sizeof(EntityUpdatePacket), &updates[i], sizeof(EntityUpdatePacket));
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    reportPerEntity(state, updates.size(), buffer.size());
+}
+
+BENCHMARK(BM_SnapshotEncodeRaw)->Arg(64)->Arg(512);
+BENCHMARK(BM_SnapshotEncodePacked)->Arg(64)->Arg(512);
+BENCHMARK(BM_SnapshotDecodeRaw)->Arg(64)->Arg(512);
+BENCHMARK(BM_SnapshotDecodePacked)->Arg(64)->Arg(512);
+BENCHMARK(BM_UpdateEncodeRaw)->Arg(64)->Arg(512);
+BENCHMARK(BM_UpdateEncodePacked)->Arg(64)->Arg(512);
+BENCHMARK(BM_UpdateDecodePacked)->Arg(64)->Arg(512);
@@ -0,0 +1,118 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** CollisionBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Server/Game.hpp"
+#include "Server/SpatialGrid.hpp"
+
+/**
+ * @file CollisionBenchmark.cpp
+ * @brief Compares the nested-loop collision pass with the SpatialGrid broadphase.
+ *
+ * A third of the entities are player shots and the rest are enemies, spread
+ * over the 1920x1080 playfield. Both passes look for the first enemy hit by
+ * each shot, the query Game::handleCollision runs every tick; the grid pass
+ * includes the rebuild.
+ */
+
+static bool overlaps(const Entity& a, const Entity& b)
+{
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+static std::vector<Entity> makeEntities(size_t count)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> xs(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> ys(0.0f, 1080.0f);
+    std::vector<Entity> entities;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i % 3 == 0)
+            entities.push_back({i, 1, xs(rng), ys(rng), 10.0f, 0.0f, 5, 10});
+        else
+            entities.push_back({i, 2, xs(rng), ys(rng), -5.0f, 0.0f, 32, 32});
+    }
+    return entities;
+}
+
+static void bruteForce(const std::vector<Entity>& entities, std::vector<uint32_t>& hits)
+{
+    hits.clear();
+    for (const auto& projectile : entities) {
+        if (projectile.type != 1) continue;
+        uint32_t hit = UINT32_MAX;
+        for (uint32_t i = 0; i < entities.size(); ++i) {
+            if (entities[i].type == 2 && overlaps(projectile, entities[i])) {
+                hit = i;
+                break;
+            }
+        }
+        hits.push_back(hit);
+    }
+}
+
+static void spatialGrid(SpatialGrid& grid, const std::vector<Entity>& entities, std::vector<uint32_t>& hits)
+{
+    hits.clear();
+    grid.clear();
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        if (entities[i].type == 2)
+            grid.insert(i, entities[i].x, entities[i].y, entities[i].width, entities[i].height);
+    }
+    grid.build();
+
+    for (const auto& projectile : entities) {
+        if (projectile.type != 1) continue;
+        uint32_t hit = UINT32_MAX;
+        grid.query(projectile.x, projectile.y, projectile.width, projectile.height, [&](uint32_t index) {
+            if (index < hit && overlaps(projectile, entities[index]))
+                hit = index;
+        });
+        hits.push_back(hit);
+    }
+}
+
+static void BM_CollisionBruteForce(benchmark::State& state)
+{
+    const auto entities = makeEntities(static_cast<size_t>(state.range(0)));
+    std::vector<uint32_t> hits;
+
+    for (auto _ : state) {
+        bruteForce(entities, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * entities.size()));
+}
+
+static void BM_CollisionSpatialGrid(benchmark::State& state)
+{
+    const auto entities = makeEntities(static_cast<size_t>(state.range(0)));
+    SpatialGrid grid(1920.0f, 1080.0f);
+    std::vector<uint32_t> hits;
+    std::vector<uint32_t> expected;
+
+    bruteForce(entities, expected);
+    spatialGrid(grid, entities, hits);
+    if (hits != expected) {
+        state.SkipWithError("SpatialGrid disagrees with the nested loop");
+        return;
+    }
+
+    for (auto _ : state) {
+        spatialGrid(grid, entities, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * entities.size()));
+}
+
+BENCHMARK(BM_CollisionBruteForce)->Arg(100)->Arg(300)->Arg(1000)->Arg(3000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CollisionSpatialGrid)->Arg(100)->Arg(300)->Arg(1000)->Arg(3000)->Arg(10000)->Unit(benchmark::kMicrosecond);
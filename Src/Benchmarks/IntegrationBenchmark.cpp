@@ -0,0 +1,127 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** IntegrationBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "Server/EntityKernels.hpp"
+
+/**
+ * @file IntegrationBenchmark.cpp
+ * @brief Compares the scalar, SSE2 and AVX2 entity integration kernels.
+ *
+ * Positions are reset outside the timed region every RESET_INTERVAL passes
+ * so entities keep crossing the bounds at a steady rate, and about 2% of
+ * them carry the collided flag.
+ */
+
+static constexpr size_t RESET_INTERVAL = 64;
+
+/**
+ * @struct Arrays
+ * @brief SoA buffers shaped like EntityStore.
+ */
+struct Arrays {
+    std::vector<float> x, y, velocityX, velocityY, startX, startY;
+    std::vector<uint8_t> flags;
+    std::vector<uint64_t> mask;
+
+    explicit Arrays(size_t count)
+        : x(count), y(count), velocityX(count), velocityY(count), startX(count), startY(count),
+          flags(count), mask((count + 63) / 64)
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> xs(-20.0f, 1920.0f);
+        std::uniform_real_distribution<float> ys(0.0f, 1080.0f);
+        std::uniform_real_distribution<float> vs(-15.0f, 15.0f);
+        for (size_t i = 0; i < count; ++i) {
+            startX[i] = xs(rng);
+            startY[i] = ys(rng);
+            velocityX[i] = vs(rng);
+            velocityY[i] = vs(rng) * 0.3f;
+            flags[i] = (rng() % 50 == 0) ? 1 : 0;
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        x = startX;
+        y = startY;
+    }
+
+    IntegrationBatch batch()
+    {
+        return {x.data(), y.data(), velocityX.data(), velocityY.data(), flags.data(), x.size(), 1.0f, -20.0f, 1920.0f, 1, mask.data()};
+    }
+};
+
+static void runKernel(benchmark::State& state, IntegrateFunction kernel)
+{
+    Arrays arrays(static_cast<size_t>(state.range(0)));
+    IntegrationBatch batch = arrays.batch();
+    size_t passes = 0;
+
+    for (auto _ : state) {
+        if (++passes % RESET_INTERVAL == 0) {
+            state.PauseTiming();
+            arrays.reset();
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(kernel(batch));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * arrays.x.size()));
+}
+
+/**
+ * @brief Checks that a kernel produces the same positions and mask as the scalar one.
+ */
+static bool matchesScalar(IntegrateFunction kernel, size_t count)
+{
+    Arrays reference(count);
+    Arrays candidate(count);
+    for (int pass = 0; pass < 100; ++pass) {
+        size_t expected = EntityKernels::integrateScalar(reference.batch());
+        if (kernel(candidate.batch()) != expected || candidate.mask != reference.mask
+            || candidate.x != reference.x || candidate.y != reference.y)
+            return false;
+    }
+    return true;
+}
+
+static void BM_IntegrateScalar(benchmark::State& state)
+{
+    runKernel(state, EntityKernels::integrateScalar);
+}
+
+static void BM_IntegrateSse2(benchmark::State& state)
+{
+    if (!matchesScalar(EntityKernels::integrateSse2, 1003)) {
+        state.SkipWithError("SSE2 kernel disagrees with the scalar kernel");
+        return;
+    }
+    runKernel(state, EntityKernels::integrateSse2);
+}
+
+static void BM_IntegrateAvx2(benchmark::State& state)
+{
+    if (!EntityKernels::hasAvx2()) {
+        state.SkipWithError("AVX2 not supported on this CPU");
+        return;
+    }
+    if (!matchesScalar(EntityKernels::integrateAvx2, 1003)) {
+        state.SkipWithError("AVX2 kernel disagrees with the scalar kernel");
+        return;
+    }
+    runKernel(state, EntityKernels::integrateAvx2);
+}
+
+BENCHMARK(BM_IntegrateScalar)->RangeMultiplier(4)->Range(256, 65536);
+BENCHMARK(BM_IntegrateSse2)->RangeMultiplier(4)->Range(256, 65536);
+BENCHMARK(BM_IntegrateAvx2)->RangeMultiplier(4)->Range(256, 65536);
@@ -0,0 +1,134 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** PacketPoolBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+#include "CrossPlatformSocket.hpp"
+#include "Network/Log.hpp"
+#include "Network/PacketPool.hpp"
+#include "Network/UDP/UDPServer.hpp"
+
+/**
+ * @file PacketPoolBenchmark.cpp
+ * @brief Measures PacketPool and checks its counters and the copies of UDPServer.
+ *
+ * BM_PoolAcquireRelease and BM_PoolExhaustion time the free stack alone and
+ * fail when acquired, exhausted or inUse differ from the calls made.
+ * BM_QueueMessage and BM_QueueMessageBatched queue ENTITY_DESTROY messages,
+ * which are never dropped, on a running UDPServer, and fail unless
+ * payloadCopies grew by exactly one per message. The batched run keeps at
+ * least two messages per bundle, so no bundle is shifted. All counts are
+ * reported as benchmark counters.
+ */
+
+static constexpr size_t POOL_CAPACITY = 256;
+static constexpr size_t MESSAGES_PER_ROUND = 32;
+
+static void BM_PoolAcquireRelease(benchmark::State& state)
+{
+    Network::PacketPool pool(POOL_CAPACITY);
+
+    for (auto _ : state) {
+        Network::Packet* pkt = pool.acquire();
+        benchmark::DoNotOptimize(pkt);
+        pool.release(pkt);
+    }
+    Network::PacketPoolStats stats = pool.getStats();
+    if (stats.acquired != static_cast<uint64_t>(state.iterations()) || stats.exhausted != 0 || stats.inUse != 0)
+        state.SkipWithError("Pool counters do not match the calls made");
+    state.counters["acquired"] = static_cast<double>(stats.acquired);
+    state.counters["exhausted"] = static_cast<double>(stats.exhausted);
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_PoolExhaustion(benchmark::State& state)
+{
+    const auto extra = static_cast<size_t>(state.range(0));
+    Network::PacketPool pool(POOL_CAPACITY);
+    std::vector<Network::Packet*> held;
+    held.reserve(POOL_CAPACITY);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < POOL_CAPACITY + extra; ++i) {
+            if (Network::Packet* pkt = pool.acquire())
+                held.push_back(pkt);
+        }
+        for (Network::Packet* pkt : held)
+            pool.release(pkt);
+        held.clear();
+    }
+    Network::PacketPoolStats stats = pool.getStats();
+    auto rounds = static_cast<uint64_t>(state.iterations());
+    if (stats.acquired != rounds * POOL_CAPACITY || stats.exhausted != rounds * extra || stats.inUse != 0)
+        state.SkipWithError("Pool counters do not match the calls made");
+    state.counters["acquired"] = static_cast<double>(stats.acquired);
+    state.counters["exhausted"] = static_cast<double>(stats.exhausted);
+    state.SetItemsProcessed(static_cast<int64_t>(rounds * (POOL_CAPACITY + extra)));
+}
+
+/**
+ * @brief Queues MESSAGES_PER_ROUND messages per iteration on a running server.
+ * @param batched Whether each round is queued inside a TickBatch.
+ */
+static void runQueueMessage(benchmark::State& state, bool batched)
+{
+    Network::setLogEnabled(false);
+    Clock clock;
+    UDPServer server(0, nullptr, clock);
+    asio::io_context context;
+    asio::ip::udp::socket sink(context, asio::ip::udp::endpoint(asio::ip::make_address("127.0.0.1"), 0));
+
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(sink.local_endpoint().port());
+    inet_pton(AF_INET, "127.0.0.1", &dest.sin_addr);
+
+    EntityDestroyPacket destroyPkt;
+    destroyPkt.entityId = 1;
+    server.start();
+    UDPServerStats before = server.getStats();
+
+    for (auto _ : state) {
+        if (batched) {
+            UDPServer::TickBatch batch(server);
+            for (size_t i = 0; i < MESSAGES_PER_ROUND; ++i)
+                server.queueMessage(destroyPkt, dest);
+        } else {
+            for (size_t i = 0; i < MESSAGES_PER_ROUND; ++i)
+                server.queueMessage(destroyPkt, dest);
+        }
+    }
+    UDPServerStats after = server.getStats();
+    server.stop();
+
+    uint64_t messages = static_cast<uint64_t>(state.iterations()) * MESSAGES_PER_ROUND;
+    uint64_t copies = after.payloadCopies - before.payloadCopies;
+    uint64_t acquired = after.outgoingPool.acquired - before.outgoingPool.acquired;
+    if (copies != messages)
+        state.SkipWithError("Queued messages were not copied exactly once");
+    state.counters["copies/msg"] = static_cast<double>(copies) / static_cast<double>(messages);
+    state.counters["packets/msg"] = static_cast<double>(acquired) / static_cast<double>(messages);
+    state.counters["exhausted"] = static_cast<double>(after.outgoingPool.exhausted - before.outgoingPool.exhausted);
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+}
+
+static void BM_QueueMessage(benchmark::State& state)
+{
+    runQueueMessage(state, false);
+}
+
+static void BM_QueueMessageBatched(benchmark::State& state)
+{
+    runQueueMessage(state, true);
+}
+
+BENCHMARK(BM_PoolAcquireRelease);
+BENCHMARK(BM_PoolExhaustion)->Arg(0)->Arg(16)->Arg(256);
+BENCHMARK(BM_QueueMessage)->UseRealTime();
+BENCHMARK(BM_QueueMessageBatched)->UseRealTime();
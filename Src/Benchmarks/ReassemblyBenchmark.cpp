@@ -0,0 +1,85 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** ReassemblyBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Network/FragmentReassembler.hpp"
+
+/**
+ * @file ReassemblyBenchmark.cpp
+ * @brief Measures FragmentReassembler throughput for several message sizes.
+ *
+ * Fragments are built once, the same way UDPServer::queueFragmented cuts a
+ * message. The timed loop only feeds them to the reassembler, in order or
+ * shuffled across MESSAGES_PER_ROUND interleaved messages.
+ */
+
+static constexpr size_t MESSAGES_PER_ROUND = 4;
+
+static std::vector<std::vector<char>> buildFragments(size_t messageSize, bool shuffled)
+{
+    std::vector<std::vector<char>> fragments;
+    std::vector<char> message(messageSize, 'x');
+
+    for (uint16_t id = 0; id < MESSAGES_PER_ROUND; ++id) {
+        FragmentHeader header;
+        header.messageId = id;
+        header.totalSize = static_cast<uint16_t>(messageSize);
+        header.fragmentCount = static_cast<uint8_t>((messageSize + FRAGMENT_PAYLOAD_SIZE - 1) / FRAGMENT_PAYLOAD_SIZE);
+        for (uint8_t i = 0; i < header.fragmentCount; ++i) {
+            size_t offset = i * FRAGMENT_PAYLOAD_SIZE;
+            size_t payload = std::min(FRAGMENT_PAYLOAD_SIZE, messageSize - offset);
+            header.fragmentIndex = i;
+            std::vector<char> fragment(sizeof(header) + payload);
+            std::memcpy(fragment.data(), &header, sizeof(header));
+            std::memcpy(fragment.data() + sizeof(header), message.data() + offset, payload);
+            fragments.push_back(std::move(fragment));
+        }
+    }
+    if (shuffled) {
+        std::mt19937 rng(42);
+        std::shuffle(fragments.begin(), fragments.end(), rng);
+    }
+    return fragments;
+}
+
+static void runReassembly(benchmark::State& state, bool shuffled)
+{
+    const size_t messageSize = static_cast<size_t>(state.range(0));
+    const auto fragments = buildFragments(messageSize, shuffled);
+    Network::FragmentReassembler reassembler;
+    uint32_t now = 0;
+
+    for (auto _ : state) {
+        for (const auto& fragment : fragments) {
+            auto message = reassembler.push(fragment.data(), fragment.size(), now);
+            benchmark::DoNotOptimize(message.data());
+        }
+        ++now;
+    }
+    if (reassembler.getStats().completed != state.iterations() * MESSAGES_PER_ROUND)
+        state.SkipWithError("Some messages were not reassembled");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * MESSAGES_PER_ROUND * messageSize));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fragments.size()));
+}
+
+static void BM_ReassemblyInOrder(benchmark::State& state)
+{
+    runReassembly(state, false);
+}
+
+static void BM_ReassemblyShuffled(benchmark::State& state)
+{
+    runReassembly(state, true);
+}
+
+BENCHMARK(BM_ReassemblyInOrder)->Arg(2 * 1024)->Arg(8 * 1024)->Arg(MAX_FRAGMENTED_MESSAGE_SIZE);
+BENCHMARK(BM_ReassemblyShuffled)->Arg(2 * 1024)->Arg(8 * 1024)->Arg(MAX_FRAGMENTED_MESSAGE_SIZE);
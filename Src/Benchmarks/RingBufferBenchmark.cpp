@@ -0,0 +1,97 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** RingBufferBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Network/RingBuffer.hpp"
+#include "Network/LockFreeRingBuffer.hpp"
+#include "Network/Packet.hpp"
+
+/**
+ * @file RingBufferBenchmark.cpp
+ * @brief Compares the mutex RingBuffer with the LockFreeRingBuffer under 1, 2 and 4 producers.
+ *
+ * Each iteration moves ITEMS_PER_ITERATION packets from the producer threads
+ * to a single consumer, the same shape as UDPServer::_outgoing.
+ */
+
+static constexpr size_t ITEMS_PER_ITERATION = 100000;
+static constexpr size_t POP_BATCH = 32;
+
+template<typename Queue>
+static size_t drain(Queue& queue, std::vector<Network::Packet>& batch, bool batched)
+{
+    if constexpr (requires { queue.pop_n(batch.data(), batch.size()); }) {
+        if (batched)
+            return queue.pop_n(batch.data(), batch.size());
+    }
+    auto pkt = queue.pop();
+    if (!pkt)
+        return 0;
+    batch[0] = *pkt;
+    return 1;
+}
+
+template<typename Queue>
+static void runTransfer(benchmark::State& state, bool batched)
+{
+    const size_t producers = static_cast<size_t>(state.range(0));
+    const size_t perProducer = ITEMS_PER_ITERATION / producers;
+
+    for (auto _ : state) {
+        auto queue = std::make_unique<Queue>();
+        std::vector<std::thread> threads;
+
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, perProducer, p]() {
+                Network::Packet pkt{};
+                pkt.length = 17;
+                for (size_t i = 0; i < perProducer; ++i) {
+                    pkt.data[0] = static_cast<char>(p);
+                    while (!queue->push(pkt))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        std::vector<Network::Packet> batch(POP_BATCH);
+        size_t received = 0;
+        while (received < perProducer * producers) {
+            size_t count = drain(*queue, batch, batched);
+            if (count == 0)
+                std::this_thread::yield();
+            received += count;
+            benchmark::DoNotOptimize(batch.data());
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * perProducer * producers));
+}
+
+static void BM_MutexRingBuffer(benchmark::State& state)
+{
+    runTransfer<Network::RingBuffer<Network::Packet, 1024>>(state, false);
+}
+
+static void BM_LockFreeRingBuffer(benchmark::State& state)
+{
+    runTransfer<Network::LockFreeRingBuffer<Network::Packet, 1024>>(state, false);
+}
+
+static void BM_LockFreeRingBufferPopN(benchmark::State& state)
+{
+    runTransfer<Network::LockFreeRingBuffer<Network::Packet, 1024>>(state, true);
+}
+
+BENCHMARK(BM_MutexRingBuffer)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LockFreeRingBuffer)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LockFreeRingBufferPopN)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,177 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** TcpSoakBenchmark
+*/
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
+
+#include "Network/Log.hpp"
+#include "Network/TCP/TCPServer.hpp"
+
+/**
+ * @file TcpSoakBenchmark.cpp
+ * @brief Holds thousands of idle lobby connections against a TCPServer.
+ *
+ * BM_ConnectionSoak measures how fast N clients complete the CONNECT
+ * handshake and reports the process thread count once they are all idle,
+ * which stays flat with the async server. BM_ListRoomsUnderSoak measures a
+ * LIST_ROOMS round trip on one client while N others stay connected.
+ * Both ends run in this process, so each connection costs two descriptors.
+ * The server's per-connection log lines are turned off with Network::setLogEnabled().
+ */
+
+/**
+ * @class SoakHandler
+ * @brief Lobby handler with a few fixed rooms.
+ */
+class SoakHandler : public Network::ITCPHandler {
+public:
+    int onCreateRoom() override { return 0; }
+    bool onJoinRoom(int, uint32_t, const std::string&, uint8_t) override { return false; }
+    void onGetLobbyState(int, uint32_t&, std::vector<std::pair<uint32_t, std::string>>&) override {}
+    void onStartGame(int, uint32_t) override {}
+    void onPlayerDisconnect(uint32_t, int) override {}
+    std::vector<Network::RoomSimpleInfo> onGetRooms() override { return {{0, 1}, {1, 3}, {2, 0}, {3, 4}}; }
+    std::vector<uint32_t> onGetPlayersInRoom(int) override { return {}; }
+    bool isGameStarting(int) override { return false; }
+};
+
+/**
+ * @brief Raises the descriptor limit so @p connections fit.
+ * @return true if the limit is high enough.
+ */
+static bool reserveDescriptors(size_t connections)
+{
+    size_t needed = connections * 2 + 64;
+#ifndef _WIN32
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return false;
+    if (limit.rlim_cur < needed) {
+        limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, needed);
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    return limit.rlim_cur >= needed;
+#else
+    (void)needed;
+    return true;
+#endif
+}
+
+/**
+ * @brief Thread count of this process, or 0 when it cannot be read.
+ */
+static double processThreads()
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+
+    while (status >> key) {
+        if (key == "Threads:") {
+            double threads = 0;
+            status >> threads;
+            return threads;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Opens a connection and completes the CONNECT handshake.
+ */
+static std::unique_ptr<asio::ip::tcp::socket> connectClient(asio::io_context& context, unsigned short port)
+{
+    auto socket = std::make_unique<asio::ip::tcp::socket>(context);
+    socket->connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+
+    ConnectRequest request{};
+    std::snprintf(request.username, sizeof(request.username), "soak");
+    asio::write(*socket, asio::buffer(&request, sizeof(request)));
+
+    ConnectResponse response{};
+    asio::read(*socket, asio::buffer(&response, sizeof(response)));
+    return socket;
+}
+
+static void BM_ConnectionSoak(benchmark::State& state)
+{
+    const size_t connections = static_cast<size_t>(state.range(0));
+    if (!reserveDescriptors(connections)) {
+        state.SkipWithError("RLIMIT_NOFILE too low for this many connections");
+        return;
+    }
+
+    Network::setLogEnabled(false);
+    for (auto _ : state) {
+        state.PauseTiming();
+        SoakHandler handler;
+        Clock clock;
+        TCPServer server(0, &handler, clock);
+        server.start();
+        asio::io_context context;
+        std::vector<std::unique_ptr<asio::ip::tcp::socket>> clients;
+        clients.reserve(connections);
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < connections; ++i)
+            clients.push_back(connectClient(context, server.getPort()));
+
+        state.PauseTiming();
+        state.counters["sessions"] = static_cast<double>(server.getSessionCount());
+        state.counters["threads"] = processThreads();
+        clients.clear();
+        server.stop();
+        state.ResumeTiming();
+    }
+    state.counters["connections/s"] = benchmark::Counter(static_cast<double>(connections) * state.iterations(),
+                                                         benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ConnectionSoak)->Arg(1000)->Arg(5000)->Arg(10000)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+static void BM_ListRoomsUnderSoak(benchmark::State& state)
+{
+    const size_t idle = static_cast<size_t>(state.range(0));
+    if (!reserveDescriptors(idle + 1)) {
+        state.SkipWithError("RLIMIT_NOFILE too low for this many connections");
+        return;
+    }
+
+    Network::setLogEnabled(false);
+    SoakHandler handler;
+    Clock clock;
+    TCPServer server(0, &handler, clock);
+    server.start();
+    asio::io_context context;
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> clients;
+    clients.reserve(idle);
+    for (size_t i = 0; i < idle; ++i)
+        clients.push_back(connectClient(context, server.getPort()));
+    auto active = connectClient(context, server.getPort());
+
+    std::vector<RoomInfo> rooms(handler.onGetRooms().size());
+    for (auto _ : state) {
+        uint8_t request = TCPMessageType::LIST_ROOMS;
+        asio::write(*active, asio::buffer(&request, sizeof(request)));
+        ListRoomsResponse response{};
+        asio::read(*active, asio::buffer(&response, sizeof(response)));
+        asio::read(*active, asio::buffer(rooms.data(), sizeof(RoomInfo) * response.count));
+        benchmark::DoNotOptimize(rooms.data());
+    }
+    state.counters["threads"] = processThreads();
+    clients.clear();
+    active.reset();
+    server.stop();
+}
+BENCHMARK(BM_ListRoomsUnderSoak)->Arg(0)->Arg(1000)->Arg(5000)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -16,8 +16,6 @@ ClientManager::ClientManager(const std::string& serverIp)
       _dummyState(),
       _currentState(ClientState::USERNAME_INPUT),
       _tcpClient(serverIp, 4242),
-      _lastRoomUpdate(0),
-      _lastLobbyUpdate(0),
       _connected(false),
       _createRoomInitiated(false),
       _joinRoomInitiated(false),
@@ -105,11 +103,7 @@ void ClientManager::run()
                     _connected = true;
                 }
 
-                double now = GetTime();
-                if (now - _lastRoomUpdate > 1.0 && !_createRoomInitiated && !_joinRoomInitiated) {
-                    _rooms = _tcpClient.getRooms();
-                    _lastRoomUpdate = now;
-                }
+                _rooms = _tcpClient.getRooms();
 
                 int action = _renderer->drawRoomMenu(_rooms);
 
@@ -156,12 +150,9 @@ void ClientManager::run()
                 break;
             }
             case ClientState::LOBBY: {
-                if (GetTime() - _lastLobbyUpdate > 0.5) {
-                    _lobbyState = _tcpClient.getLobbyState();
-                    _lastLobbyUpdate = GetTime();
-                }
+                _lobbyState = _tcpClient.getLobbyState();
 
-                if (_tcpClient.getLobbyState().gameIsStarting) {
+                if (_lobbyState.gameIsStarting) {
                     _currentState = ClientState::IN_GAME;
                     break;
                 }
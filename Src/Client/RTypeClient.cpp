@@ -8,6 +8,8 @@
 #include "Client/Ray.hpp"
 #include "Client/RTypeClient.hpp"
 #include "Network/Protocole/ProtocoleUDP.hpp"
+#include "Network/PackedUpdate.hpp"
+#include <cstring>
 
 RTypeClient::RTypeClient(const std::string& serverIp, TCPClient& tcpClient, const ConnectResponse& connectResponse, const std::map<std::string, int>& keybinds)
     : _udpClient(serverIp, connectResponse.udpPort),
@@ -16,6 +18,7 @@ RTypeClient::RTypeClient(const std::string& serverIp, TCPClient& tcpClient, cons
         _tick(connectResponse.serverTimeMs),
         _clock(),
         _keybinds(keybinds),
+        _protocolVersion(connectResponse.protocolVersion),
         _packetLossPercentage(0.0f),
         _lastServerSeq(0),
         _isFirstServerPacket(true)
@@ -24,7 +27,7 @@ RTypeClient::RTypeClient(const std::string& serverIp, TCPClient& tcpClient, cons
 
     PlayerInputPacket packet{};
     packet.playerId = _gameState.myPlayerId;
-    _udpClient.sendMessage(packet);
+    sendInput(packet);
 }
 
 void RTypeClient::tick()
@@ -226,6 +229,17 @@ void RTypeClient::handleInput()
         applyInput(packet);
         _pendingInputs.push_back(packet);
     }
+    sendInput(packet);
+}
+
+void RTypeClient::sendInput(PlayerInputPacket& packet)
+{
+    if (_protocolVersion < PROTOCOL_VERSION_RELIABLE) {
+        _udpClient.sendMessage(&packet, LEGACY_PLAYER_INPUT_SIZE);
+        return;
+    }
+    packet.reliableAck = _reliable.ack();
+    packet.reliableAckBits = _reliable.ackBits();
     _udpClient.sendMessage(packet);
 }
 
@@ -246,139 +260,233 @@ void RTypeClient::update()
         const auto& data = *received;
         uint8_t type = data[0];
 
-        if (type == UDPMessageType::PLAYER_STATE && data.size() >= sizeof(PlayerStatePacket)) {
-            const auto* serverState = reinterpret_cast<const PlayerStatePacket*>(data.data());
+        if (type != UDPMessageType::BUNDLE) {
+            handleMessage(data.data(), data.size());
+            continue;
+        }
 
-            if (serverState->playerId == _gameState.myPlayerId) {
-                if (_status == InGameStatus::GAME_OVER) continue;
+        const auto* bundle = reinterpret_cast<const BundleHeader*>(data.data());
+        size_t offset = sizeof(BundleHeader);
+        for (uint8_t i = 0; i < bundle->messageCount; ++i) {
+            if (offset + sizeof(BundledMessageHeader) > data.size())
+                break;
+            const auto* entry = reinterpret_cast<const BundledMessageHeader*>(data.data() + offset);
+            offset += sizeof(BundledMessageHeader);
+            if (entry->length == 0 || offset + entry->length > data.size()) {
+                std::cerr << "Malformed BUNDLE packet: message " << static_cast<int>(i) << " overflows the datagram" << std::endl;
+                break;
+            }
+            if (static_cast<uint8_t>(data[offset]) != UDPMessageType::BUNDLE)
+                handleMessage(data.data() + offset, entry->length);
+            offset += entry->length;
+        }
+    }
+    // The kick notice comes on the reliable channel: acknowledge it before the game closes.
+    if (_status == InGameStatus::KICKED && _protocolVersion >= PROTOCOL_VERSION_RELIABLE) {
+        PlayerInputPacket packet{};
+        packet.playerId = _gameState.myPlayerId;
+        sendInput(packet);
+    }
+}
 
-                uint32_t nowMs = _clock.getElapsedTimeMs();
+void RTypeClient::handleMessage(const char* data, size_t size)
+{
+    uint8_t type = data[0];
 
-                if (_isFirstServerPacket) {
-                    _lastServerSeq = serverState->sequence;
-                    _packetEvents.push_back({PacketStatus::RECEIVED, nowMs});
-                    _isFirstServerPacket = false;
-                } else if (serverState->sequence > _lastServerSeq) {
-                    uint32_t lostCount = serverState->sequence - _lastServerSeq - 1;
-                    for (uint32_t i = 0; i < lostCount; ++i) {
-                        _packetEvents.push_back({PacketStatus::LOST, nowMs});
-                    }
-                    _packetEvents.push_back({PacketStatus::RECEIVED, nowMs});
-                    _lastServerSeq = serverState->sequence;
-                }
+    if (type == UDPMessageType::FRAGMENT) {
+        std::span<const char> message = _udpClient.reassemble(data, size);
+        if (!message.empty() && static_cast<uint8_t>(message[0]) != UDPMessageType::FRAGMENT)
+            handleMessage(message.data(), message.size());
+        return;
+    }
 
-                uint32_t cutoffTime = nowMs - (PACKET_LOSS_WINDOW_SECONDS * 1000);
-                while (!_packetEvents.empty() && _packetEvents.front().timestamp < cutoffTime) {
-                    _packetEvents.pop_front();
-                }
+    if (type == UDPMessageType::RELIABLE) {
+        _reliable.receive(data, size, [this](const char* message, size_t length) {
+            uint8_t inner = static_cast<uint8_t>(message[0]);
+            if (inner != UDPMessageType::RELIABLE && inner != UDPMessageType::BUNDLE && inner != UDPMessageType::FRAGMENT)
+                handleMessage(message, length);
+        });
+        return;
+    }
 
-                size_t lostInWindow = 0;
-                for (const auto& event : _packetEvents) {
-                    if (event.status == PacketStatus::LOST)
-                        lostInWindow++;
-                }
-                _packetLossPercentage = _packetEvents.empty() ? 0.0f : (static_cast<float>(lostInWindow) / _packetEvents.size()) * 100.0f;
+    if (type == UDPMessageType::PLAYER_STATE && size >= sizeof(PlayerStatePacket)) {
+        const auto* serverState = reinterpret_cast<const PlayerStatePacket*>(data);
 
-                _gameState.players[serverState->playerId] = {serverState->x, serverState->y};
+        if (serverState->playerId == _gameState.myPlayerId) {
+            if (_status == InGameStatus::GAME_OVER) return;
 
-                while (!_pendingInputs.empty() && _pendingInputs.front().tick <= serverState->lastProcessedTick) {
-                    _pendingInputs.pop_front();
-                }
+            uint32_t nowMs = _clock.getElapsedTimeMs();
 
-                for (const auto& input : _pendingInputs) {
-                    applyInput(input);
-                }
-            } else {
-                float vy = 0.0f;
-                auto it = _gameState.players.find(serverState->playerId);
-                if (it != _gameState.players.end()) {
-                    vy = serverState->y - it->second.y;
+            if (_isFirstServerPacket) {
+                _lastServerSeq = serverState->sequence;
+                _packetEvents.push_back({PacketStatus::RECEIVED, nowMs});
+                _isFirstServerPacket = false;
+            } else if (serverState->sequence > _lastServerSeq) {
+                uint32_t lostCount = serverState->sequence - _lastServerSeq - 1;
+                for (uint32_t i = 0; i < lostCount; ++i) {
+                    _packetEvents.push_back({PacketStatus::LOST, nowMs});
                 }
-                _gameState.players[serverState->playerId] = {serverState->x, serverState->y, vy};
+                _packetEvents.push_back({PacketStatus::RECEIVED, nowMs});
+                _lastServerSeq = serverState->sequence;
             }
-        }
 
-        if (type == UDPMessageType::ENTITY_SPAWN && data.size() >= sizeof(EntitySpawnPacket)) {
-            const auto* spawnPkt = reinterpret_cast<const EntitySpawnPacket*>(data.data());
-            _gameState.entities[spawnPkt->entityId] = {spawnPkt->x, spawnPkt->y, spawnPkt->entityType};
-        }
+            uint32_t cutoffTime = nowMs - (PACKET_LOSS_WINDOW_SECONDS * 1000);
+            while (!_packetEvents.empty() && _packetEvents.front().timestamp < cutoffTime) {
+                _packetEvents.pop_front();
+            }
 
-        if (type == UDPMessageType::ENTITY_UPDATE && data.size() >= sizeof(EntityUpdatePacket)) {
-            const auto* updatePkt = reinterpret_cast<const EntityUpdatePacket*>(data.data());
-            if (_gameState.entities.count(updatePkt->entityId)) {
-                _gameState.entities[updatePkt->entityId].x = updatePkt->x;
-                _gameState.entities[updatePkt->entityId].y = updatePkt->y;
+            size_t lostInWindow = 0;
+            for (const auto& event : _packetEvents) {
+                if (event.status == PacketStatus::LOST)
+                    lostInWindow++;
             }
-        }
+            _packetLossPercentage = _packetEvents.empty() ? 0.0f : (static_cast<float>(lostInWindow) / _packetEvents.size()) * 100.0f;
 
-        if (type == UDPMessageType::ENTITY_DESTROY && data.size() >= sizeof(EntityDestroyPacket)) {
-            const auto* destroyPkt = reinterpret_cast<const EntityDestroyPacket*>(data.data());
-            if (_gameState.entities.count(destroyPkt->entityId)) {
-                const auto& entity = _gameState.entities[destroyPkt->entityId];
-                if (entity.type == 2) _score += 50;
-                else if (entity.type == 3) _score += 100;
-                if (entity.x > -20.0f) {
-                    _renderer.addExplosion(entity.x, entity.y);
-                }
+            _gameState.players[serverState->playerId] = {serverState->x, serverState->y};
+
+            while (!_pendingInputs.empty() && _pendingInputs.front().tick <= serverState->lastProcessedTick) {
+                _pendingInputs.pop_front();
             }
-            _gameState.entities.erase(destroyPkt->entityId);
-        }
 
-        if (type == UDPMessageType::PLAYER_DISCONNECT && data.size() >= sizeof(PlayerDisconnectPacket)) {
-            const auto* disconnectPkt = reinterpret_cast<const PlayerDisconnectPacket*>(data.data());
-            if (_gameState.players.count(disconnectPkt->playerId)) {
-                _renderer.addExplosion(_gameState.players[disconnectPkt->playerId].x, _gameState.players[disconnectPkt->playerId].y);
+            for (const auto& input : _pendingInputs) {
+                applyInput(input);
             }
-            _gameState.players.erase(disconnectPkt->playerId);
-            std::cout << "[Game] Player " << disconnectPkt->playerId << " disconnected." << std::endl;
+        } else {
+            float vy = 0.0f;
+            auto it = _gameState.players.find(serverState->playerId);
+            if (it != _gameState.players.end()) {
+                vy = serverState->y - it->second.y;
+            }
+            _gameState.players[serverState->playerId] = {serverState->x, serverState->y, vy};
+        }
+    }
+
+    if (type == UDPMessageType::ENTITY_SPAWN && size >= sizeof(EntitySpawnPacket)) {
+        const auto* spawnPkt = reinterpret_cast<const EntitySpawnPacket*>(data);
+        // A retransmitted spawn may come after a snapshot already placed the entity.
+        _gameState.entities.insert({spawnPkt->entityId, {spawnPkt->x, spawnPkt->y, spawnPkt->entityType}});
+    }
 
-            if (disconnectPkt->playerId == _gameState.myPlayerId) {
-                _status = InGameStatus::GAME_OVER;
+    if (type == UDPMessageType::ENTITY_UPDATE && size >= sizeof(EntityUpdatePacket)) {
+        const auto* updatePkt = reinterpret_cast<const EntityUpdatePacket*>(data);
+        if (_gameState.entities.count(updatePkt->entityId)) {
+            _gameState.entities[updatePkt->entityId].x = updatePkt->x;
+            _gameState.entities[updatePkt->entityId].y = updatePkt->y;
+        }
+    }
+
+    if (type == UDPMessageType::ENTITY_DESTROY && size >= sizeof(EntityDestroyPacket)) {
+        const auto* destroyPkt = reinterpret_cast<const EntityDestroyPacket*>(data);
+        if (_gameState.entities.count(destroyPkt->entityId)) {
+            const auto& entity = _gameState.entities[destroyPkt->entityId];
+            if (entity.type == 2) _score += 50;
+            else if (entity.type == 3) _score += 100;
+            if (entity.x > -20.0f) {
+                _renderer.addExplosion(entity.x, entity.y);
             }
         }
+        _gameState.entities.erase(destroyPkt->entityId);
+    }
 
-        if (type == UDPMessageType::PONG && data.size() >= sizeof(PongPacket)) {
-            const auto* pongPkt = reinterpret_cast<const PongPacket*>(data.data());
-            uint32_t currentTime = _clock.getElapsedTimeMs();
-            _gameState.rtt = currentTime - pongPkt->timestamp;
+    if (type == UDPMessageType::PLAYER_DISCONNECT && size >= sizeof(PlayerDisconnectPacket)) {
+        const auto* disconnectPkt = reinterpret_cast<const PlayerDisconnectPacket*>(data);
+        if (_gameState.players.count(disconnectPkt->playerId)) {
+            _renderer.addExplosion(_gameState.players[disconnectPkt->playerId].x, _gameState.players[disconnectPkt->playerId].y);
         }
+        _gameState.players.erase(disconnectPkt->playerId);
+        std::cout << "[Game] Player " << disconnectPkt->playerId << " disconnected." << std::endl;
 
-        if (type == UDPMessageType::GLOBAL_STATE_SYNC && data.size() >= sizeof(GlobalStateSyncPacket)) {
-            const auto* syncPkt = reinterpret_cast<const GlobalStateSyncPacket*>(data.data());
-            size_t offset = sizeof(GlobalStateSyncPacket);
+        if (disconnectPkt->playerId == _gameState.myPlayerId) {
+            _status = InGameStatus::GAME_OVER;
+        }
+    }
 
-            std::vector<std::pair<uint32_t, EntityState>> localEntities;
-            for (const auto& pair : _gameState.entities) {
-                if (pair.first >= 9999) {
-                    localEntities.push_back(pair);
-                }
-            }
+    if (type == UDPMessageType::PONG && size >= sizeof(PongPacket)) {
+        const auto* pongPkt = reinterpret_cast<const PongPacket*>(data);
+        uint32_t currentTime = _clock.getElapsedTimeMs();
+        _gameState.rtt = currentTime - pongPkt->timestamp;
+    }
 
-            _gameState.entities.clear();
-            for (const auto& pair : localEntities)
-                _gameState.entities[pair.first] = pair.second;
-
-            for (uint32_t i = 0; i < syncPkt->entityCount; ++i) {
-                if (offset + sizeof(SyncedEntityState) <= data.size()) {
-                    const auto* entityState = reinterpret_cast<const SyncedEntityState*>(data.data() + offset);
-                    _gameState.entities[entityState->entityId] = {entityState->x, entityState->y, entityState->entityType};
-                    offset += sizeof(SyncedEntityState);
-                } else {
-                    std::cerr << "Malformed GLOBAL_STATE_SYNC packet: not enough data for entity " << i << std::endl;
-                    break;
-                }
+    if (type == UDPMessageType::GLOBAL_STATE_SYNC && size >= sizeof(GlobalStateSyncPacket)) {
+        const auto* syncPkt = reinterpret_cast<const GlobalStateSyncPacket*>(data);
+        size_t offset = sizeof(GlobalStateSyncPacket);
+
+        std::vector<std::pair<uint32_t, EntityState>> localEntities;
+        for (const auto& pair : _gameState.entities) {
+            if (pair.first >= 9999) {
+                localEntities.push_back(pair);
             }
         }
 
-        if (type == UDPMessageType::YOU_HAVE_BEEN_KICKED) {
-            std::cout << "[Game] You have been kicked." << std::endl;
-            _status = InGameStatus::KICKED;
+        _gameState.entities.clear();
+        for (const auto& pair : localEntities)
+            _gameState.entities[pair.first] = pair.second;
+
+        for (uint32_t i = 0; i < syncPkt->entityCount; ++i) {
+            if (offset + sizeof(SyncedEntityState) <= size) {
+                const auto* entityState = reinterpret_cast<const SyncedEntityState*>(data + offset);
+                _gameState.entities[entityState->entityId] = {entityState->x, entityState->y, entityState->entityType};
+                offset += sizeof(SyncedEntityState);
+            } else {
+                std::cerr << "Malformed GLOBAL_STATE_SYNC packet: not enough data for entity " << i << std::endl;
+                break;
+            }
         }
+    }
 
-        if (type == UDPMessageType::BOSS_STATE && data.size() >= sizeof(BossStatePacket)) {
-            const auto* bossPkt = reinterpret_cast<const BossStatePacket*>(data.data());
-            _bossHP = bossPkt->hp;
-            _bossMaxHP = bossPkt->maxHp;
+    if (type == UDPMessageType::ENTITY_UPDATE_PACKED && Network::decodeEntityUpdates(data, size, _updateScratch)) {
+        for (const auto& update : _updateScratch) {
+            auto it = _gameState.entities.find(update.entityId);
+            if (it != _gameState.entities.end()) {
+                it->second.x = update.x;
+                it->second.y = update.y;
+            }
         }
     }
+
+    if (type == UDPMessageType::SNAPSHOT || type == UDPMessageType::SNAPSHOT_PACKED) {
+        applySnapshot(data, size);
+    }
+
+    if (type == UDPMessageType::YOU_HAVE_BEEN_KICKED) {
+        std::cout << "[Game] You have been kicked." << std::endl;
+        _status = InGameStatus::KICKED;
+    }
+
+    if (type == UDPMessageType::BOSS_STATE && size >= sizeof(BossStatePacket)) {
+        const auto* bossPkt = reinterpret_cast<const BossStatePacket*>(data);
+        _bossHP = bossPkt->hp;
+        _bossMaxHP = bossPkt->maxHp;
+    }
+}
+
+void RTypeClient::applySnapshot(const char* data, size_t size)
+{
+    bool decoded = static_cast<uint8_t>(data[0]) == UDPMessageType::SNAPSHOT_PACKED
+        ? Network::decodeSnapshotPacked(data, size, _snapshots, _snapshotScratch)
+        : Network::decodeSnapshot(data, size, _snapshots, _snapshotScratch);
+    if (!decoded)
+        return;
+
+    SnapshotPacket header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.snapshotId <= _lastSnapshotId)
+        return;
+    _lastSnapshotId = header.snapshotId;
+    Network::SnapshotRecord& record = _snapshots.push(header.snapshotId);
+    record.entities.swap(_snapshotScratch);
+
+    for (auto it = _gameState.entities.begin(); it != _gameState.entities.end(); ) {
+        if (it->first >= 9999)
+            ++it;
+        else
+            it = _gameState.entities.erase(it);
+    }
+    for (const auto& state : record.entities)
+        _gameState.entities[state.entityId] = {state.x, state.y, state.entityType};
+
+    SnapshotAckPacket ack;
+    ack.playerId = _gameState.myPlayerId;
+    ack.snapshotId = header.snapshotId;
+    _udpClient.sendMessage(ack);
 }
@@ -0,0 +1,247 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Bot
+*/
+
+#include "LoadGen/Bot.hpp"
+#include <iostream>
+
+Bot::Bot(const std::string& serverIp, uint16_t tcpPort, std::string name, uint32_t seed)
+    : _serverIp(serverIp), _name(std::move(name)), _tcpClient(serverIp, tcpPort), _rng(seed)
+{
+}
+
+bool Bot::connect()
+{
+    ConnectResponse response{};
+
+    if (!_tcpClient.connectToServer() || !_tcpClient.sendConnectRequest(_name, response)) {
+        _state = State::FAILED;
+        return false;
+    }
+    _playerId = response.playerId;
+    _protocolVersion = response.protocolVersion;
+    try {
+        _udpClient = std::make_unique<UDPClient>(_serverIp, response.udpPort);
+    } catch (const std::exception& e) {
+        std::cerr << "[LoadGen] " << _name << ": UDP socket failed: " << e.what() << std::endl;
+        _state = State::FAILED;
+        return false;
+    }
+    _state = State::CONNECTED;
+    return true;
+}
+
+void Bot::hostRoom()
+{
+    if (_state != State::CONNECTED)
+        return;
+    if (_tcpClient.createRoom() == std::optional<int>(-1)) {
+        _state = State::FAILED;
+        return;
+    }
+    _state = State::CREATING_ROOM;
+}
+
+void Bot::joinRoom(int roomId)
+{
+    if (_state != State::CONNECTED && _state != State::CREATING_ROOM)
+        return;
+    _roomId = roomId;
+    if (_tcpClient.joinRoom(roomId) == std::optional<bool>(false)) {
+        _state = State::FAILED;
+        return;
+    }
+    _state = State::JOINING_ROOM;
+}
+
+void Bot::startGame()
+{
+    if (_state == State::LOBBY)
+        _tcpClient.sendStartGameRequest();
+}
+
+void Bot::update(uint32_t nowMs)
+{
+    switch (_state) {
+        case State::CREATING_ROOM: {
+            std::optional<int> roomId = _tcpClient.createRoom();
+            if (!roomId.has_value())
+                break;
+            if (*roomId < 0) {
+                _state = State::FAILED;
+                break;
+            }
+            joinRoom(*roomId);
+            break;
+        }
+        case State::JOINING_ROOM: {
+            std::optional<bool> joined = _tcpClient.joinRoom(_roomId);
+            if (joined.has_value())
+                _state = *joined ? State::LOBBY : State::FAILED;
+            break;
+        }
+        case State::LOBBY:
+            _lobby = _tcpClient.getLobbyState();
+            if (_lobby.disconnected)
+                _state = State::FAILED;
+            else if (_lobby.gameIsStarting)
+                _state = State::IN_GAME;
+            break;
+        case State::IN_GAME:
+            updateInGame(nowMs);
+            break;
+        default:
+            break;
+    }
+}
+
+void Bot::poll(uint32_t nowMs)
+{
+    if (_state == State::IN_GAME)
+        receive(nowMs);
+}
+
+void Bot::updateInGame(uint32_t nowMs)
+{
+    // Drains chat and keeps the lobby connection checked.
+    _tcpClient.receiveChatMessages();
+
+    if (nowMs - _lastPingMs >= PING_INTERVAL_MS) {
+        PingPacket ping;
+        ping.timestamp = nowMs;
+        _udpClient->sendMessage(ping);
+        _lastPingMs = nowMs;
+        _stats.pingsSent++;
+    }
+    sendInput(nowMs);
+    receive(nowMs);
+}
+
+void Bot::sendInput(uint32_t nowMs)
+{
+    static constexpr uint8_t MOVES[] = {0, UP, DOWN, LEFT, RIGHT, UP | LEFT, UP | RIGHT, DOWN | LEFT, DOWN | RIGHT};
+
+    if (_holdFrames == 0) {
+        _heldInputs = MOVES[_rng() % std::size(MOVES)];
+        _holdFrames = 5 + _rng() % 30;
+    }
+    _holdFrames--;
+
+    PlayerInputPacket packet;
+    packet.playerId = _playerId;
+    packet.tick = _inputTick;
+    packet.inputs = _heldInputs;
+    if (_rng() % 8 == 0)
+        packet.inputs |= PRESSED;
+
+    _inputSentAt[_inputTick % INPUT_HISTORY] = nowMs;
+    _inputTick++;
+    bool sent;
+    if (_protocolVersion >= PROTOCOL_VERSION_RELIABLE) {
+        packet.reliableAck = _reliable.ack();
+        packet.reliableAckBits = _reliable.ackBits();
+        sent = _udpClient->sendMessage(packet);
+    } else {
+        sent = _udpClient->sendMessage(&packet, LEGACY_PLAYER_INPUT_SIZE);
+    }
+    if (sent)
+        _stats.inputsSent++;
+}
+
+void Bot::receive(uint32_t nowMs)
+{
+    while (auto received = _udpClient->receiveMessage<1024>()) {
+        const auto& data = *received;
+
+        if (static_cast<uint8_t>(data[0]) != UDPMessageType::BUNDLE) {
+            handleMessage(data.data(), data.size(), nowMs);
+            continue;
+        }
+
+        const auto* bundle = reinterpret_cast<const BundleHeader*>(data.data());
+        size_t offset = sizeof(BundleHeader);
+        for (uint8_t i = 0; i < bundle->messageCount; ++i) {
+            if (offset + sizeof(BundledMessageHeader) > data.size())
+                break;
+            const auto* entry = reinterpret_cast<const BundledMessageHeader*>(data.data() + offset);
+            offset += sizeof(BundledMessageHeader);
+            if (entry->length == 0 || offset + entry->length > data.size())
+                break;
+            if (static_cast<uint8_t>(data[offset]) != UDPMessageType::BUNDLE)
+                handleMessage(data.data() + offset, entry->length, nowMs);
+            offset += entry->length;
+        }
+    }
+}
+
+void Bot::handleMessage(const char* data, size_t size, uint32_t nowMs)
+{
+    switch (static_cast<uint8_t>(data[0])) {
+        case UDPMessageType::FRAGMENT: {
+            std::span<const char> message = _udpClient->reassemble(data, size);
+            if (!message.empty() && static_cast<uint8_t>(message[0]) != UDPMessageType::FRAGMENT)
+                handleMessage(message.data(), message.size(), nowMs);
+            break;
+        }
+        case UDPMessageType::RELIABLE:
+            _reliable.receive(data, size, [this, nowMs](const char* message, size_t length) {
+                _stats.reliableReceived++;
+                if (static_cast<uint8_t>(message[0]) != UDPMessageType::RELIABLE)
+                    handleMessage(message, length, nowMs);
+            });
+            break;
+        case UDPMessageType::PLAYER_STATE:
+            if (size >= sizeof(PlayerStatePacket))
+                onPlayerState(*reinterpret_cast<const PlayerStatePacket*>(data), nowMs);
+            break;
+        case UDPMessageType::PONG:
+            if (size >= sizeof(PongPacket))
+                _stats.rttMs.push_back(nowMs - reinterpret_cast<const PongPacket*>(data)->timestamp);
+            break;
+        case UDPMessageType::SNAPSHOT:
+        case UDPMessageType::SNAPSHOT_PACKED:
+            if (size >= sizeof(SnapshotPacket)) {
+                // Acknowledged without being decoded, so the server keeps sending deltas as to a real client.
+                SnapshotAckPacket ack;
+                ack.playerId = _playerId;
+                ack.snapshotId = reinterpret_cast<const SnapshotPacket*>(data)->snapshotId;
+                _udpClient->sendMessage(ack);
+            }
+            break;
+        case UDPMessageType::PLAYER_DISCONNECT:
+            if (size >= sizeof(PlayerDisconnectPacket)
+                && reinterpret_cast<const PlayerDisconnectPacket*>(data)->playerId == _playerId)
+                _state = State::DONE;
+            break;
+        case UDPMessageType::YOU_HAVE_BEEN_KICKED:
+            _state = State::DONE;
+            break;
+        default:
+            break;
+    }
+}
+
+void Bot::onPlayerState(const PlayerStatePacket& state, uint32_t nowMs)
+{
+    if (state.playerId != _playerId)
+        return;
+
+    if (!_receivedState) {
+        _receivedState = true;
+        _lastStateSequence = state.sequence;
+        _stats.statesReceived++;
+    } else if (state.sequence > _lastStateSequence) {
+        _stats.statesLost += state.sequence - _lastStateSequence - 1;
+        _lastStateSequence = state.sequence;
+        _stats.statesReceived++;
+    }
+
+    uint32_t tick = state.lastProcessedTick;
+    if (tick > _lastAckedTick && tick < _inputTick && _inputTick - tick <= INPUT_HISTORY) {
+        _stats.inputLatencyMs.push_back(nowMs - _inputSentAt[tick % INPUT_HISTORY]);
+        _lastAckedTick = tick;
+    }
+}
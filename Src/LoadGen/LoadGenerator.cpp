@@ -0,0 +1,191 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** LoadGenerator
+*/
+
+#include "LoadGen/LoadGenerator.hpp"
+#include "Network/Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Nearest-rank percentile.
+ * @param sorted The samples, sorted.
+ * @param p The percentile, in [0, 100].
+ * @return uint32_t The sample, or 0 if there are none.
+ */
+static uint32_t percentile(const std::vector<uint32_t>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+/**
+ * @brief Formats p50/p95/p99 of some samples.
+ */
+static std::string percentiles(std::vector<uint32_t> samples)
+{
+    std::ostringstream out;
+
+    std::sort(samples.begin(), samples.end());
+    out << percentile(samples, 50) << "/" << percentile(samples, 95) << "/" << percentile(samples, 99);
+    return out.str();
+}
+
+static const char* stateName(Bot::State state)
+{
+    switch (state) {
+        case Bot::State::CONNECTED: return "connected";
+        case Bot::State::CREATING_ROOM: return "creating";
+        case Bot::State::JOINING_ROOM: return "joining";
+        case Bot::State::LOBBY: return "lobby";
+        case Bot::State::IN_GAME: return "in game";
+        case Bot::State::DONE: return "done";
+        case Bot::State::FAILED: return "failed";
+    }
+    return "?";
+}
+
+LoadGenerator::LoadGenerator(const LoadGenConfig& config)
+    : _config(config)
+{
+}
+
+bool LoadGenerator::connectBots()
+{
+    for (size_t i = 0; i < _config.bots; ++i) {
+        auto bot = std::make_unique<Bot>(_config.serverIp, _config.tcpPort, "bot" + std::to_string(i),
+                                         _config.seed + static_cast<uint32_t>(i));
+        if (!bot->connect())
+            std::cerr << "[LoadGen] " << bot->getName() << " could not connect." << std::endl;
+        _bots.push_back(std::move(bot));
+    }
+    for (size_t first = 0; first < _bots.size(); first += _config.botsPerRoom)
+        _rooms.push_back(Room{first, std::min(_config.botsPerRoom, _bots.size() - first)});
+    for (const Room& room : _rooms)
+        _bots[room.first]->hostRoom();
+    return std::any_of(_bots.begin(), _bots.end(), [](const auto& bot) { return bot->getState() != Bot::State::FAILED; });
+}
+
+void LoadGenerator::updateRooms(uint32_t nowMs)
+{
+    for (Room& room : _rooms) {
+        Bot& host = *_bots[room.first];
+
+        // The others wait until the host is in, so the host is the room's first player and may start it.
+        if (!room.joinsSent && host.getState() == Bot::State::LOBBY) {
+            for (size_t i = 1; i < room.count; ++i)
+                _bots[room.first + i]->joinRoom(host.getRoomId());
+            room.joinsSent = true;
+            room.joinsSentMs = nowMs;
+        }
+        if (room.joinsSent && !room.startSent && host.getState() == Bot::State::LOBBY
+            && (host.getLobbySize() >= room.count || nowMs - room.joinsSentMs > LOBBY_TIMEOUT_MS)) {
+            host.startGame();
+            room.startSent = true;
+        }
+    }
+}
+
+bool LoadGenerator::allSettled() const
+{
+    return std::all_of(_bots.begin(), _bots.end(), [](const auto& bot) {
+        Bot::State state = bot->getState();
+        return state == Bot::State::IN_GAME || state == Bot::State::DONE || state == Bot::State::FAILED;
+    });
+}
+
+int LoadGenerator::run()
+{
+    using namespace std::chrono;
+
+    std::cerr << "[LoadGen] " << _config.bots << " bots against " << _config.serverIp << ":" << _config.tcpPort
+              << ", " << _config.botsPerRoom << " per room, " << _config.durationSeconds << " s at "
+              << _config.rate << " Hz" << std::endl;
+    Network::setLogEnabled(_config.verbose);
+
+    if (!connectBots()) {
+        std::cerr << "[LoadGen] No bot could connect." << std::endl;
+        return 84;
+    }
+
+    const auto period = duration_cast<steady_clock::duration>(duration<double>(1.0 / _config.rate));
+    auto nextFrame = steady_clock::now();
+    uint32_t lobbyDeadline = _clock.getElapsedTimeMs() + LOBBY_TIMEOUT_MS * 2;
+    bool playing = false;
+    uint32_t endMs = 0;
+
+    while (true) {
+        uint32_t nowMs = _clock.getElapsedTimeMs();
+        for (auto& bot : _bots)
+            bot->update(nowMs);
+        updateRooms(nowMs);
+
+        if (!playing && (allSettled() || nowMs > lobbyDeadline)) {
+            playing = true;
+            endMs = nowMs + _config.durationSeconds * 1000;
+            std::cerr << "[LoadGen] Lobby phase over after " << nowMs << " ms, playing..." << std::endl;
+        }
+        if (playing && nowMs >= endMs)
+            break;
+
+        // Receiving between frames keeps RTT and tick latency samples at millisecond precision.
+        nextFrame += period;
+        while (steady_clock::now() < nextFrame) {
+            nowMs = _clock.getElapsedTimeMs();
+            for (auto& bot : _bots)
+                bot->poll(nowMs);
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+    }
+    printReport();
+
+    bool anyPlayed = std::any_of(_bots.begin(), _bots.end(), [](const auto& bot) { return bot->getStats().statesReceived > 0; });
+    return anyPlayed ? 0 : 84;
+}
+
+void LoadGenerator::printReport() const
+{
+    BotStats total;
+
+    std::cout << std::left << std::setw(8) << "bot" << std::setw(8) << "player" << std::setw(6) << "room"
+              << std::setw(10) << "state" << std::right << std::setw(8) << "inputs" << std::setw(8) << "states"
+              << std::setw(7) << "lost" << std::setw(8) << "loss%" << std::setw(10) << "reliable" << std::setw(18) << "rtt ms p50/95/99"
+              << std::setw(18) << "tick ms p50/95/99" << std::endl;
+
+    for (const auto& bot : _bots) {
+        const BotStats& stats = bot->getStats();
+        uint32_t expected = stats.statesReceived + stats.statesLost;
+        double loss = expected ? 100.0 * stats.statesLost / expected : 0.0;
+
+        std::cout << std::left << std::setw(8) << bot->getName() << std::setw(8) << bot->getPlayerId()
+                  << std::setw(6) << bot->getRoomId() << std::setw(10) << stateName(bot->getState()) << std::right
+                  << std::setw(8) << stats.inputsSent << std::setw(8) << stats.statesReceived << std::setw(7)
+                  << stats.statesLost << std::setw(8) << std::fixed << std::setprecision(2) << loss
+                  << std::setw(10) << stats.reliableReceived << std::setw(18) << percentiles(stats.rttMs) << std::setw(18) << percentiles(stats.inputLatencyMs)
+                  << std::endl;
+
+        total.inputsSent += stats.inputsSent;
+        total.statesReceived += stats.statesReceived;
+        total.statesLost += stats.statesLost;
+        total.reliableReceived += stats.reliableReceived;
+        total.rttMs.insert(total.rttMs.end(), stats.rttMs.begin(), stats.rttMs.end());
+        total.inputLatencyMs.insert(total.inputLatencyMs.end(), stats.inputLatencyMs.begin(), stats.inputLatencyMs.end());
+    }
+
+    uint32_t expected = total.statesReceived + total.statesLost;
+    double loss = expected ? 100.0 * total.statesLost / expected : 0.0;
+    std::cout << std::left << std::setw(32) << "total" << std::right << std::setw(8) << total.inputsSent
+              << std::setw(8) << total.statesReceived << std::setw(7) << total.statesLost << std::setw(8)
+              << std::fixed << std::setprecision(2) << loss << std::setw(10) << total.reliableReceived
+              << std::setw(18) << percentiles(total.rttMs)
+              << std::setw(18) << percentiles(total.inputLatencyMs) << std::endl;
+}
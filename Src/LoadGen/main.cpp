@@ -0,0 +1,58 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** main
+*/
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "LoadGen/LoadGenerator.hpp"
+
+static int usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--host ip] [--port tcp_port] [--bots n] [--per-room n]"
+              << " [--duration seconds] [--rate hz] [--seed n] [--verbose]" << std::endl;
+    return 84;
+}
+
+int main(int argc, char **argv)
+{
+    LoadGenConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--verbose") {
+            config.verbose = true;
+        } else if (arg == "--host" && hasValue) {
+            config.serverIp = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            config.tcpPort = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--bots" && hasValue) {
+            config.bots = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--per-room" && hasValue) {
+            config.botsPerRoom = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--duration" && hasValue) {
+            config.durationSeconds = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--rate" && hasValue) {
+            config.rate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (config.bots == 0 || config.botsPerRoom == 0 || config.rate == 0)
+        return usage(argv[0]);
+
+    try {
+        LoadGenerator generator(config);
+        return generator.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 84;
+    }
+}
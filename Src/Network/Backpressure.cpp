@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Backpressure
+*/
+
+#include "Network/UDP/Backpressure.hpp"
+#include <algorithm>
+
+namespace Network {
+
+MessagePriority messagePriority(uint8_t type)
+{
+    switch (type) {
+        case ENTITY_DESTROY:
+        case BOSS_STATE:
+        case YOU_HAVE_BEEN_KICKED:
+            return MessagePriority::CRITICAL;
+        case PLAYER_STATE:
+        case ENTITY_UPDATE:
+        case SNAPSHOT:
+        case ENTITY_UPDATE_PACKED:
+        case SNAPSHOT_PACKED:
+            return MessagePriority::LOW;
+        default:
+            return MessagePriority::NORMAL;
+    }
+}
+
+MessagePriority packetPriority(const Packet& pkt)
+{
+    MessagePriority priority = MessagePriority::LOW;
+    forEachMessageType(pkt, [&priority](uint8_t type) {
+        priority = std::max(priority, messagePriority(type));
+    });
+    return priority;
+}
+
+const char* messageTypeName(uint8_t type)
+{
+    switch (type) {
+        case PLAYER_INPUT: return "player_input";
+        case PLAYER_STATE: return "player_state";
+        case ENTITY_SPAWN: return "entity_spawn";
+        case ENTITY_UPDATE: return "entity_update";
+        case ENTITY_DESTROY: return "entity_destroy";
+        case PING: return "ping";
+        case PONG: return "pong";
+        case PLAYER_DISCONNECT: return "player_disconnect";
+        case GLOBAL_STATE_SYNC: return "global_state_sync";
+        case YOU_HAVE_BEEN_KICKED: return "kicked";
+        case BOSS_STATE: return "boss_state";
+        case BUNDLE: return "bundle";
+        case SNAPSHOT: return "snapshot";
+        case SNAPSHOT_ACK: return "snapshot_ack";
+        case FRAGMENT: return "fragment";
+        case ENTITY_UPDATE_PACKED: return "entity_update_packed";
+        case SNAPSHOT_PACKED: return "snapshot_packed";
+        case RELIABLE: return "reliable";
+        default: return "unknown";
+    }
+}
+
+const char* backpressurePolicyName(BackpressurePolicy policy)
+{
+    switch (policy) {
+        case BackpressurePolicy::DROP_NEWEST: return "drop-newest";
+        case BackpressurePolicy::DROP_OLDEST: return "drop-oldest";
+        case BackpressurePolicy::DROP_BY_PRIORITY: return "priority";
+        case BackpressurePolicy::FAIR_SHARE: return "fair-share";
+        default: return "?";
+    }
+}
+
+bool parseBackpressurePolicy(const std::string& name, BackpressurePolicy& policy)
+{
+    for (auto candidate : {BackpressurePolicy::DROP_NEWEST, BackpressurePolicy::DROP_OLDEST,
+                           BackpressurePolicy::DROP_BY_PRIORITY, BackpressurePolicy::FAIR_SHARE}) {
+        if (name == backpressurePolicyName(candidate)) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** FragmentReassembler
+*/
+
+#include "Network/FragmentReassembler.hpp"
+#include <cstring>
+
+namespace Network {
+
+FragmentReassembler::FragmentReassembler()
+    : _buffers(SLOT_COUNT * MAX_FRAGMENTED_MESSAGE_SIZE)
+{
+}
+
+size_t FragmentReassembler::slotFor(uint16_t messageId, uint32_t nowMs)
+{
+    size_t freeSlot = SLOT_COUNT;
+    size_t oldest = SLOT_COUNT;
+
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        Slot& slot = _slots[i];
+        if (slot.active && nowMs - slot.startedMs > TIMEOUT_MS) {
+            slot.active = false;
+            ++_stats.expired;
+        }
+        if (!slot.active) {
+            if (freeSlot == SLOT_COUNT)
+                freeSlot = i;
+            continue;
+        }
+        if (slot.messageId == messageId)
+            return i;
+        if (oldest == SLOT_COUNT || static_cast<int32_t>(slot.startedMs - _slots[oldest].startedMs) < 0)
+            oldest = i;
+    }
+    if (freeSlot != SLOT_COUNT)
+        return freeSlot;
+
+    _slots[oldest].active = false;
+    ++_stats.expired;
+    return oldest;
+}
+
+std::span<const char> FragmentReassembler::push(const char* data, size_t size, uint32_t nowMs)
+{
+    if (size < sizeof(FragmentHeader)) {
+        ++_stats.malformed;
+        return {};
+    }
+
+    FragmentHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.fragmentCount == 0 || header.fragmentCount > MAX_FRAGMENT_COUNT
+        || header.fragmentIndex >= header.fragmentCount
+        || header.totalSize <= (header.fragmentCount - 1u) * FRAGMENT_PAYLOAD_SIZE
+        || header.totalSize > header.fragmentCount * FRAGMENT_PAYLOAD_SIZE) {
+        ++_stats.malformed;
+        return {};
+    }
+    size_t payloadSize = header.fragmentIndex + 1 == header.fragmentCount
+        ? header.totalSize - (header.fragmentCount - 1u) * FRAGMENT_PAYLOAD_SIZE
+        : FRAGMENT_PAYLOAD_SIZE;
+    if (size - sizeof(FragmentHeader) < payloadSize) {
+        ++_stats.malformed;
+        return {};
+    }
+
+    size_t index = slotFor(header.messageId, nowMs);
+    Slot& slot = _slots[index];
+    if (!slot.active) {
+        slot.active = true;
+        slot.messageId = header.messageId;
+        slot.totalSize = header.totalSize;
+        slot.fragmentCount = header.fragmentCount;
+        slot.received = 0;
+        slot.receivedMask = 0;
+        slot.startedMs = nowMs;
+    } else if (slot.totalSize != header.totalSize || slot.fragmentCount != header.fragmentCount) {
+        ++_stats.malformed;
+        return {};
+    }
+
+    uint32_t bit = 1u << header.fragmentIndex;
+    if (slot.receivedMask & bit) {
+        ++_stats.duplicates;
+        return {};
+    }
+
+    char* message = _buffers.data() + index * MAX_FRAGMENTED_MESSAGE_SIZE;
+    std::memcpy(message + header.fragmentIndex * FRAGMENT_PAYLOAD_SIZE, data + sizeof(FragmentHeader), payloadSize);
+    slot.receivedMask |= bit;
+    ++slot.received;
+    ++_stats.fragments;
+
+    if (slot.received < slot.fragmentCount)
+        return {};
+    slot.active = false;
+    ++_stats.completed;
+    return {message, slot.totalSize};
+}
+
+}
@@ -0,0 +1,31 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Log
+*/
+
+#include "Network/Log.hpp"
+#include <atomic>
+#include <iostream>
+
+namespace Network {
+
+static std::atomic<bool> s_logEnabled{true};
+
+void setLogEnabled(bool enabled)
+{
+    s_logEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::ostream& log()
+{
+    // No stream buffer: every write fails and is dropped. One per thread, as a failed write sets the stream state.
+    thread_local std::ostream discard(nullptr);
+
+    if (s_logEnabled.load(std::memory_order_relaxed))
+        return std::cout;
+    return discard;
+}
+
+}
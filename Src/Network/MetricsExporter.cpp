@@ -0,0 +1,144 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** MetricsExporter
+*/
+
+#include "Network/Metrics/MetricsExporter.hpp"
+#include "Network/Log.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace Network {
+
+/**
+ * @class MetricsExporter::Connection
+ * @brief One scrape: read the request headers, write the response, close.
+ */
+class MetricsExporter::Connection : public std::enable_shared_from_this<MetricsExporter::Connection> {
+public:
+    Connection(const MetricsRegistry& registry, asio::ip::tcp::socket socket)
+        : _registry(registry), _socket(std::move(socket)), _request(MAX_REQUEST_SIZE)
+    {
+    }
+
+    void start()
+    {
+        auto self = shared_from_this();
+        asio::async_read_until(_socket, _request, "\r\n\r\n",
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    close();
+                    return;
+                }
+                respond();
+            });
+    }
+
+private:
+    void respond()
+    {
+        std::istream stream(&_request);
+        std::string method;
+        std::string target;
+        stream >> method >> target;
+
+        std::string body;
+        std::string status;
+        if (method == "GET" && (target == "/metrics" || target.rfind("/metrics?", 0) == 0)) {
+            status = "200 OK";
+            body = _registry.render();
+        } else {
+            status = "404 Not Found";
+            body = "Metrics are served on /metrics\n";
+        }
+        _response = "HTTP/1.0 " + status + "\r\n"
+                    "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                    "Connection: close\r\n\r\n" + body;
+
+        auto self = shared_from_this();
+        asio::async_write(_socket, asio::buffer(_response),
+            [this, self](const asio::error_code&, size_t) { close(); });
+    }
+
+    void close()
+    {
+        asio::error_code ec;
+        _socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+        _socket.close(ec);
+    }
+
+    const MetricsRegistry& _registry;
+    asio::ip::tcp::socket _socket;
+    asio::streambuf _request;
+    std::string _response;
+};
+
+MetricsExporter::MetricsExporter(const MetricsRegistry& registry, unsigned short port)
+    : _registry(registry), _port(port), _acceptor(_io_context)
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    stop();
+}
+
+bool MetricsExporter::start()
+{
+    if (_running)
+        return true;
+    try {
+        asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), _port);
+        _acceptor.open(endpoint.protocol());
+        _acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+        _acceptor.bind(endpoint);
+        _acceptor.listen();
+    } catch (const std::exception& e) {
+        std::cerr << "[Metrics] Cannot listen on port " << _port << ": " << e.what() << std::endl;
+        asio::error_code ec;
+        _acceptor.close(ec);
+        return false;
+    }
+    _running = true;
+    _io_context.restart();
+    startAccept();
+    _thread = std::thread([this] { _io_context.run(); });
+    Network::log() << "[Metrics] Serving http://127.0.0.1:" << getPort() << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsExporter::stop()
+{
+    bool expected = true;
+    if (!_running.compare_exchange_strong(expected, false))
+        return;
+    _io_context.stop();
+    if (_thread.joinable())
+        _thread.join();
+    asio::error_code ec;
+    _acceptor.close(ec);
+}
+
+unsigned short MetricsExporter::getPort() const
+{
+    asio::error_code ec;
+    auto endpoint = _acceptor.local_endpoint(ec);
+    return ec ? _port : endpoint.port();
+}
+
+void MetricsExporter::startAccept()
+{
+    _acceptor.async_accept([this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+        if (!_running || !_acceptor.is_open())
+            return;
+        if (!ec)
+            std::make_shared<Connection>(_registry, std::move(socket))->start();
+        startAccept();
+    });
+}
+
+}
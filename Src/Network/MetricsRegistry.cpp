@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** MetricsRegistry
+*/
+
+#include "Network/Metrics/MetricsRegistry.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace Network {
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Counter& counter = _counters.emplace_back();
+    _metrics.push_back({name, help, "counter", [&counter] { return static_cast<double>(counter.value()); }, std::string()});
+    return counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Gauge& gauge = _gauges.emplace_back();
+    _metrics.push_back({name, help, "gauge", [&gauge] { return static_cast<double>(gauge.value()); }, std::string()});
+    return gauge;
+}
+
+void MetricsRegistry::counterFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                                      const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.push_back({name, help, "counter", std::move(read), labels});
+}
+
+void MetricsRegistry::gaugeFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                                    const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.push_back({name, help, "gauge", std::move(read), labels});
+}
+
+void MetricsRegistry::onRender(std::function<void()> refresh)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _refresh = std::move(refresh);
+}
+
+std::string MetricsRegistry::render() const
+{
+    std::ostringstream out;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_refresh)
+        _refresh();
+
+    // 17 significant digits print every counter below 2^53 exactly, without an exponent.
+    out << std::setprecision(17);
+    const std::string* previous = nullptr;
+    for (const Metric& metric : _metrics) {
+        if (!previous || *previous != metric.name) {
+            out << "# HELP " << metric.name << " " << metric.help << "\n"
+                << "# TYPE " << metric.name << " " << metric.type << "\n";
+        }
+        out << metric.name;
+        if (!metric.labels.empty())
+            out << "{" << metric.labels << "}";
+        out << " " << metric.read() << "\n";
+        previous = &metric.name;
+    }
+    return out.str();
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** PackedUpdate
+*/
+
+#include "Network/PackedUpdate.hpp"
+#include "Network/BitStream.hpp"
+
+namespace Network {
+
+uint32_t packedUpdateBits(uint32_t entityId)
+{
+    return varUintBits(entityId) + POSITION_X.bits + POSITION_Y.bits;
+}
+
+PackedUpdateSizer::PackedUpdateSizer(size_t capacity)
+    : _bitsLeft(capacity > 1 ? (capacity - 1) * 8 : 0)
+{
+}
+
+size_t PackedUpdateSizer::grownBits(uint32_t entityId) const
+{
+    if (_count == 0)
+        return 0;
+    // Same arithmetic as encodeEntityUpdates(): the count is a varint and may grow by a byte.
+    size_t bits = _bits - varUintBits(_count) + varUintBits(_count + 1) + packedUpdateBits(entityId);
+    return bits <= _bitsLeft ? bits : 0;
+}
+
+size_t PackedUpdateSizer::cost(uint32_t entityId) const
+{
+    size_t bits = grownBits(entityId);
+    if (bits != 0)
+        return (bits + 7) / 8 - (_bits + 7) / 8;
+    return 1 + (varUintBits(1) + packedUpdateBits(entityId) + 7) / 8;
+}
+
+void PackedUpdateSizer::add(uint32_t entityId)
+{
+    size_t bits = grownBits(entityId);
+    if (bits != 0) {
+        _bits = bits;
+        ++_count;
+        return;
+    }
+    _bits = varUintBits(1) + packedUpdateBits(entityId);
+    _count = 1;
+}
+
+size_t encodeEntityUpdates(const EntityUpdatePacket* updates, size_t count, char* out, size_t capacity, size_t& encoded)
+{
+    encoded = 0;
+    if (capacity < 2)
+        return 0;
+
+    // The count goes first, so measure the entries that fit before writing anything.
+    size_t bitsLeft = (capacity - 1) * 8;
+    size_t fitting = 0;
+    size_t bits = varUintBits(0);
+    while (fitting < count) {
+        size_t next = bits - varUintBits(static_cast<uint32_t>(fitting)) + varUintBits(static_cast<uint32_t>(fitting + 1))
+                    + packedUpdateBits(updates[fitting].entityId);
+        if (next > bitsLeft)
+            break;
+        bits = next;
+        ++fitting;
+    }
+    if (fitting == 0)
+        return 0;
+
+    out[0] = static_cast<char>(ENTITY_UPDATE_PACKED);
+    BitWriter writer(out + 1, capacity - 1);
+    writer.writeVarUint(static_cast<uint32_t>(fitting));
+    for (size_t i = 0; i < fitting; ++i) {
+        writer.writeVarUint(updates[i].entityId);
+        writer.writeQuantized(updates[i].x, POSITION_X);
+        writer.writeQuantized(updates[i].y, POSITION_Y);
+    }
+    encoded = fitting;
+    return 1 + writer.finish();
+}
+
+bool decodeEntityUpdates(const char* data, size_t size, std::vector<EntityUpdatePacket>& out)
+{
+    out.clear();
+    if (size < 2)
+        return false;
+
+    BitReader reader(data + 1, size - 1);
+    uint32_t count = reader.readVarUint();
+    // Every entry takes at least 37 bits, anything larger is malformed.
+    if (count > (size - 1) * 8 / packedUpdateBits(0))
+        return false;
+    out.reserve(count);
+    for (uint32_t k = 0; k < count && reader.ok(); ++k) {
+        EntityUpdatePacket update;
+        update.entityId = reader.readVarUint();
+        update.timestamp = 0;
+        update.x = reader.readQuantized(POSITION_X);
+        update.y = reader.readQuantized(POSITION_Y);
+        out.push_back(update);
+    }
+    return reader.ok();
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** ReliableChannel
+*/
+
+#include "Network/ReliableChannel.hpp"
+#include <bit>
+#include <cmath>
+
+namespace Network {
+
+void ReliableSender::acknowledge(uint16_t ack, uint32_t ackBits, Clock::time_point now)
+{
+    if (_pending.empty())
+        return;
+    auto cumulative = static_cast<int16_t>(ack - _pending.front().sequence);
+    if (cumulative < 0 || static_cast<size_t>(cumulative) > _pending.size())
+        return;
+    // Transmitted messages are a prefix of _pending, so checking the last one is enough.
+    if (cumulative > 0 && _pending[cumulative - 1].transmissions == 0)
+        return;
+
+    for (int16_t i = 0; i < cumulative; ++i) {
+        markAcked(_pending.front(), now);
+        _pending.pop_front();
+    }
+    // _pending now starts at ack, bit i is the message at index i + 1.
+    for (; ackBits != 0; ackBits &= ackBits - 1) {
+        size_t index = 1 + static_cast<size_t>(std::countr_zero(ackBits));
+        if (index >= _pending.size())
+            break;
+        if (_pending[index].transmissions > 0)
+            markAcked(_pending[index], now);
+    }
+}
+
+void ReliableSender::markAcked(Entry& entry, Clock::time_point now)
+{
+    if (entry.acked)
+        return;
+    entry.acked = true;
+    ++_stats.acked;
+    if (entry.transmissions != 1)
+        return;
+
+    float sample = std::chrono::duration<float, std::milli>(now - entry.sentAt).count();
+    if (!_hasRtt) {
+        _srttMs = sample;
+        _rttVarMs = sample / 2.0f;
+        _hasRtt = true;
+    } else {
+        _rttVarMs = 0.75f * _rttVarMs + 0.25f * std::fabs(_srttMs - sample);
+        _srttMs = 0.875f * _srttMs + 0.125f * sample;
+    }
+    auto rto = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float, std::milli>(_srttMs + 4.0f * _rttVarMs));
+    _rto = std::clamp<Clock::duration>(rto, MIN_RTO, MAX_RTO);
+}
+
+ReliableSender::Clock::duration ReliableSender::timeout(uint8_t transmissions) const
+{
+    int doublings = std::min(transmissions - 1, 5);
+    return std::min<Clock::duration>(_rto * (1 << doublings), MAX_RTO);
+}
+
+ReliableStats ReliableSender::getStats() const
+{
+    ReliableStats stats = _stats;
+    stats.pending = _pending.size();
+    stats.rttMs = _srttMs;
+    stats.rtoMs = std::chrono::duration<float, std::milli>(_rto).count();
+    return stats;
+}
+
+}
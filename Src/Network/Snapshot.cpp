@@ -0,0 +1,363 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** Snapshot
+*/
+
+#include "Network/Snapshot.hpp"
+#include "Network/BitStream.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Network {
+
+SnapshotRecord& SnapshotHistory::push(uint32_t id)
+{
+    SnapshotRecord& record = _records[id % CAPACITY];
+    record.id = id;
+    record.entities.clear();
+    return record;
+}
+
+const SnapshotRecord* SnapshotHistory::find(uint32_t id) const
+{
+    if (id == 0)
+        return nullptr;
+    const SnapshotRecord& record = _records[id % CAPACITY];
+    return record.id == id ? &record : nullptr;
+}
+
+const SnapshotRecord* SnapshotHistory::baselineFor(uint32_t nextId) const
+{
+    if (_lastAcked == 0 || nextId - _lastAcked >= CAPACITY)
+        return nullptr;
+    return find(_lastAcked);
+}
+
+void SnapshotHistory::acknowledge(uint32_t id)
+{
+    if (id > _lastAcked && find(id))
+        _lastAcked = id;
+}
+
+static bool sameState(const SyncedEntityState& a, const SyncedEntityState& b)
+{
+    return a.entityType == b.entityType && a.x == b.x && a.y == b.y;
+}
+
+size_t encodeSnapshot(uint32_t snapshotId, const SnapshotRecord* baseline, const std::vector<SyncedEntityState>& current,
+    char* out, size_t capacity, std::vector<SyncedEntityState>& view)
+{
+    static const std::vector<SyncedEntityState> empty;
+    const std::vector<SyncedEntityState>& base = baseline ? baseline->entities : empty;
+
+    view.clear();
+    if (capacity < sizeof(SnapshotPacket))
+        return 0;
+
+    size_t removedTotal = 0;
+    size_t changedTotal = 0;
+    for (size_t i = 0, j = 0; i < current.size() || j < base.size(); ) {
+        if (j == base.size() || (i < current.size() && current[i].entityId < base[j].entityId)) {
+            ++changedTotal;
+            ++i;
+        } else if (i == current.size() || base[j].entityId < current[i].entityId) {
+            ++removedTotal;
+            ++j;
+        } else {
+            if (!sameState(current[i], base[j]))
+                ++changedTotal;
+            ++i;
+            ++j;
+        }
+    }
+
+    size_t room = capacity - sizeof(SnapshotPacket);
+    size_t removedBudget = std::min(removedTotal, std::min(room / sizeof(uint32_t), static_cast<size_t>(UINT16_MAX)));
+    room -= removedBudget * sizeof(uint32_t);
+    size_t changedBudget = std::min(changedTotal, std::min(room / sizeof(SyncedEntityState), static_cast<size_t>(UINT16_MAX)));
+
+    char* removedOut = out + sizeof(SnapshotPacket);
+    char* changedOut = removedOut + removedBudget * sizeof(uint32_t);
+    size_t removedCount = 0;
+    size_t changedCount = 0;
+
+    for (size_t i = 0, j = 0; i < current.size() || j < base.size(); ) {
+        if (j == base.size() || (i < current.size() && current[i].entityId < base[j].entityId)) {
+            if (changedCount < changedBudget) {
+                std::memcpy(changedOut + changedCount * sizeof(SyncedEntityState), &current[i], sizeof(SyncedEntityState));
+                ++changedCount;
+                view.push_back(current[i]);
+            }
+            ++i;
+        } else if (i == current.size() || base[j].entityId < current[i].entityId) {
+            if (removedCount < removedBudget) {
+                std::memcpy(removedOut + removedCount * sizeof(uint32_t), &base[j].entityId, sizeof(uint32_t));
+                ++removedCount;
+            } else {
+                view.push_back(base[j]);
+            }
+            ++j;
+        } else {
+            if (!sameState(current[i], base[j]) && changedCount < changedBudget) {
+                std::memcpy(changedOut + changedCount * sizeof(SyncedEntityState), &current[i], sizeof(SyncedEntityState));
+                ++changedCount;
+                view.push_back(current[i]);
+            } else {
+                view.push_back(base[j]);
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    SnapshotPacket header;
+    header.snapshotId = snapshotId;
+    header.baselineId = baseline ? baseline->id : 0;
+    header.removedCount = static_cast<uint16_t>(removedCount);
+    header.changedCount = static_cast<uint16_t>(changedCount);
+    std::memcpy(out, &header, sizeof(header));
+
+    return sizeof(SnapshotPacket) + removedCount * sizeof(uint32_t) + changedCount * sizeof(SyncedEntityState);
+}
+
+bool decodeSnapshot(const char* data, size_t size, const SnapshotHistory& history, std::vector<SyncedEntityState>& out)
+{
+    if (size < sizeof(SnapshotPacket))
+        return false;
+
+    SnapshotPacket header;
+    std::memcpy(&header, data, sizeof(header));
+    size_t needed = sizeof(SnapshotPacket) + header.removedCount * sizeof(uint32_t) + header.changedCount * sizeof(SyncedEntityState);
+    if (header.snapshotId == 0 || size < needed)
+        return false;
+
+    const SnapshotRecord* baseline = nullptr;
+    if (header.baselineId != 0) {
+        baseline = history.find(header.baselineId);
+        if (!baseline)
+            return false;
+    }
+
+    const char* removedIn = data + sizeof(SnapshotPacket);
+    const char* changedIn = removedIn + header.removedCount * sizeof(uint32_t);
+
+    out.clear();
+    if (baseline) {
+        out.reserve(baseline->entities.size() + header.changedCount);
+        // Removed ids are written in ascending order, like the baseline entities.
+        uint16_t k = 0;
+        for (const auto& state : baseline->entities) {
+            uint32_t removedId = 0;
+            while (k < header.removedCount) {
+                std::memcpy(&removedId, removedIn + k * sizeof(uint32_t), sizeof(removedId));
+                if (removedId >= state.entityId)
+                    break;
+                ++k;
+            }
+            if (k < header.removedCount && removedId == state.entityId)
+                continue;
+            out.push_back(state);
+        }
+    }
+
+    size_t baseCount = out.size();
+    for (uint16_t k = 0; k < header.changedCount; ++k) {
+        SyncedEntityState state;
+        std::memcpy(&state, changedIn + k * sizeof(SyncedEntityState), sizeof(state));
+        auto it = std::lower_bound(out.begin(), out.begin() + baseCount, state.entityId,
+            [](const SyncedEntityState& e, uint32_t id) { return e.entityId < id; });
+        if (it != out.begin() + baseCount && it->entityId == state.entityId)
+            *it = state;
+        else
+            out.push_back(state);
+    }
+    std::sort(out.begin(), out.end(), [](const SyncedEntityState& a, const SyncedEntityState& b) {
+        return a.entityId < b.entityId;
+    });
+    return true;
+}
+
+static SyncedEntityState quantized(const SyncedEntityState& state)
+{
+    SyncedEntityState rounded = state;
+    rounded.x = POSITION_X.round(state.x);
+    rounded.y = POSITION_Y.round(state.y);
+    return rounded;
+}
+
+/**
+ * Walks two entity lists sorted by entityId side by side, calling @p added for
+ * entities only in @p current, @p removed for those only in @p base and
+ * @p kept for those in both.
+ */
+template <typename Added, typename Removed, typename Kept>
+static void mergeById(const std::vector<SyncedEntityState>& current, const std::vector<SyncedEntityState>& base,
+    Added added, Removed removed, Kept kept)
+{
+    for (size_t i = 0, j = 0; i < current.size() || j < base.size(); ) {
+        if (j == base.size() || (i < current.size() && current[i].entityId < base[j].entityId)) {
+            added(i++);
+        } else if (i == current.size() || base[j].entityId < current[i].entityId) {
+            removed(j++);
+        } else {
+            kept(i, j);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+size_t encodeSnapshotPacked(uint32_t snapshotId, const SnapshotRecord* baseline, const std::vector<SyncedEntityState>& current,
+    char* out, size_t capacity, std::vector<SyncedEntityState>& view)
+{
+    static const std::vector<SyncedEntityState> empty;
+    const std::vector<SyncedEntityState>& base = baseline ? baseline->entities : empty;
+
+    view.clear();
+    if (capacity < sizeof(SnapshotPacket))
+        return 0;
+
+    BitWriter writer(out + sizeof(SnapshotPacket), capacity - sizeof(SnapshotPacket));
+
+    // Removals first, then changes, each list stopping at the first entry that
+    // does not fit so the entries sent are a prefix of the list.
+    size_t removedCount = 0;
+    bool removedFull = false;
+    uint32_t previousId = 0;
+    mergeById(current, base, [](size_t) {}, [&](size_t j) {
+        uint32_t delta = base[j].entityId - previousId;
+        if (removedFull || removedCount == UINT16_MAX || varUintBits(delta) > writer.bitsLeft()) {
+            removedFull = true;
+            return;
+        }
+        writer.writeVarUint(delta);
+        previousId = base[j].entityId;
+        ++removedCount;
+    }, [](size_t, size_t) {});
+
+    size_t changedCount = 0;
+    bool changedFull = false;
+    previousId = 0;
+    auto writeChanged = [&](const SyncedEntityState& state) {
+        uint32_t delta = state.entityId - previousId;
+        uint32_t bits = varUintBits(delta) + varUintBits(state.entityType) + POSITION_X.bits + POSITION_Y.bits;
+        if (changedFull || changedCount == UINT16_MAX || bits > writer.bitsLeft()) {
+            changedFull = true;
+            return;
+        }
+        writer.writeVarUint(delta);
+        writer.writeVarUint(state.entityType);
+        writer.writeQuantized(state.x, POSITION_X);
+        writer.writeQuantized(state.y, POSITION_Y);
+        previousId = state.entityId;
+        ++changedCount;
+    };
+    mergeById(current, base, [&](size_t i) { writeChanged(current[i]); }, [](size_t) {}, [&](size_t i, size_t j) {
+        if (!sameState(quantized(current[i]), base[j]))
+            writeChanged(current[i]);
+    });
+
+    size_t removedLeft = removedCount;
+    size_t changedLeft = changedCount;
+    mergeById(current, base, [&](size_t i) {
+        if (changedLeft > 0) {
+            --changedLeft;
+            view.push_back(quantized(current[i]));
+        }
+    }, [&](size_t j) {
+        if (removedLeft > 0)
+            --removedLeft;
+        else
+            view.push_back(base[j]);
+    }, [&](size_t i, size_t j) {
+        SyncedEntityState state = quantized(current[i]);
+        if (!sameState(state, base[j]) && changedLeft > 0) {
+            --changedLeft;
+            view.push_back(state);
+        } else {
+            view.push_back(base[j]);
+        }
+    });
+
+    SnapshotPacket header;
+    header.type = SNAPSHOT_PACKED;
+    header.snapshotId = snapshotId;
+    header.baselineId = baseline ? baseline->id : 0;
+    header.removedCount = static_cast<uint16_t>(removedCount);
+    header.changedCount = static_cast<uint16_t>(changedCount);
+    std::memcpy(out, &header, sizeof(header));
+
+    return sizeof(SnapshotPacket) + writer.finish();
+}
+
+bool decodeSnapshotPacked(const char* data, size_t size, const SnapshotHistory& history, std::vector<SyncedEntityState>& out)
+{
+    if (size < sizeof(SnapshotPacket))
+        return false;
+
+    SnapshotPacket header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.snapshotId == 0)
+        return false;
+
+    const SnapshotRecord* baseline = nullptr;
+    if (header.baselineId != 0) {
+        baseline = history.find(header.baselineId);
+        if (!baseline)
+            return false;
+    }
+
+    BitReader reader(data + sizeof(SnapshotPacket), size - sizeof(SnapshotPacket));
+    uint16_t removedRead = 0;
+    uint32_t removedId = 0;
+    bool removedPending = false;
+    auto nextRemoved = [&]() {
+        removedPending = removedRead < header.removedCount;
+        if (removedPending) {
+            removedId += reader.readVarUint();
+            ++removedRead;
+        }
+    };
+
+    out.clear();
+    nextRemoved();
+    if (baseline) {
+        out.reserve(baseline->entities.size() + header.changedCount);
+        for (const auto& state : baseline->entities) {
+            while (removedPending && removedId < state.entityId)
+                nextRemoved();
+            if (removedPending && removedId == state.entityId)
+                continue;
+            out.push_back(state);
+        }
+    }
+    while (removedPending)
+        nextRemoved();
+
+    size_t baseCount = out.size();
+    uint32_t previousId = 0;
+    for (uint16_t k = 0; k < header.changedCount && reader.ok(); ++k) {
+        SyncedEntityState state;
+        state.entityId = previousId + reader.readVarUint();
+        state.entityType = static_cast<uint16_t>(reader.readVarUint());
+        state.x = reader.readQuantized(POSITION_X);
+        state.y = reader.readQuantized(POSITION_Y);
+        previousId = state.entityId;
+        auto it = std::lower_bound(out.begin(), out.begin() + baseCount, state.entityId,
+            [](const SyncedEntityState& e, uint32_t id) { return e.entityId < id; });
+        if (it != out.begin() + baseCount && it->entityId == state.entityId)
+            *it = state;
+        else
+            out.push_back(state);
+    }
+    if (!reader.ok())
+        return false;
+    std::sort(out.begin(), out.end(), [](const SyncedEntityState& a, const SyncedEntityState& b) {
+        return a.entityId < b.entityId;
+    });
+    return true;
+}
+
+}
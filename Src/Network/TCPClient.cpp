@@ -6,7 +6,11 @@
 */
 
 #include "Network/TCP/TCPClient.hpp"
+#include "Network/Log.hpp"
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <utility>
 
 TCPClient::TCPClient(const std::string& serverIp, uint16_t port)
     : _io_context(), _socket(_io_context), _serverIp(serverIp), _port(port)
@@ -51,7 +55,7 @@ bool TCPClient::sendConnectRequest(const std::string& username, ConnectResponse&
         _socket.non_blocking(false);
 
         ConnectRequest req{};
-        req.type = 1;
+        req.type = TCPMessageType::CONNECT_VERSIONED;
         std::strncpy(req.username, username.c_str(), sizeof(req.username) - 1);
         req.username[sizeof(req.username) - 1] = '\0';
 
@@ -88,314 +92,227 @@ bool TCPClient::sendConnectRequest(const std::string& username, ConnectResponse&
     }
 }
 
-std::vector<RoomInfo> TCPClient::getRooms()
+void TCPClient::pollMessages()
 {
-    static std::vector<RoomInfo> cachedRooms;
+    std::array<uint8_t, 4096> chunk;
     asio::error_code ec;
 
-    try {
-        ListRoomsRequest req;
-        asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
-
-        if (_socket.available() < (sizeof(uint8_t) + sizeof(int))) {
-            return cachedRooms;
+    while (_socket.is_open()) {
+        size_t received = _socket.read_some(asio::buffer(chunk), ec);
+        if (ec == asio::error::would_block || ec == asio::error::try_again)
+            break;
+        if (ec) {
+            std::cerr << "TCP connection lost: " << ec.message() << std::endl;
+            _lobbyState.disconnected = true;
+            _socket.close();
+            break;
         }
+        _inbox.insert(_inbox.end(), chunk.begin(), chunk.begin() + received);
+    }
 
-        uint8_t respType = 0;
-        asio::read(_socket, asio::buffer(&respType, 1), ec);
+    size_t offset = 0;
+    while (offset < _inbox.size()) {
+        size_t consumed = handleMessage(_inbox.data() + offset, _inbox.size() - offset);
+        if (consumed == 0)
+            break;
+        offset += consumed;
+    }
+    _inbox.erase(_inbox.begin(), _inbox.begin() + offset);
+}
 
-        if (respType != static_cast<uint8_t>(TCPMessageType::LIST_ROOMS_RESPONSE)) {
-            return cachedRooms;
+size_t TCPClient::handleMessage(const uint8_t* data, size_t size)
+{
+    switch (data[0]) {
+        case TCPMessageType::LIST_ROOMS_RESPONSE: {
+            ListRoomsResponse header;
+            if (size < sizeof(header))
+                return 0;
+            std::memcpy(&header, data, sizeof(header));
+            size_t count = header.count > 0 ? static_cast<size_t>(header.count) : 0;
+            size_t total = sizeof(header) + count * sizeof(RoomInfo);
+            if (size < total)
+                return 0;
+            _rooms.resize(count);
+            std::memcpy(_rooms.data(), data + sizeof(header), count * sizeof(RoomInfo));
+            return total;
         }
-
-        int count = 0;
-        asio::read(_socket, asio::buffer(&count, sizeof(count)), ec);
-
-        std::vector<RoomInfo> newRooms;
-        for (int i = 0; i < count; ++i) {
-            RoomInfo info;
-            asio::read(_socket, asio::buffer(&info, sizeof(info)), ec);
-            newRooms.push_back(info);
+        case TCPMessageType::ROOM_UPDATE: {
+            RoomUpdateNotification update;
+            if (size < sizeof(update))
+                return 0;
+            std::memcpy(&update, data, sizeof(update));
+            auto it = std::lower_bound(_rooms.begin(), _rooms.end(), update.room.id,
+                [](const RoomInfo& room, int32_t id) { return room.id < id; });
+            if (it != _rooms.end() && it->id == update.room.id)
+                *it = update.room;
+            else
+                _rooms.insert(it, update.room);
+            return sizeof(update);
         }
+        case TCPMessageType::ROOM_REMOVED: {
+            RoomRemovedNotification removed;
+            if (size < sizeof(removed))
+                return 0;
+            std::memcpy(&removed, data, sizeof(removed));
+            std::erase_if(_rooms, [&](const RoomInfo& room) { return room.id == removed.roomId; });
+            return sizeof(removed);
+        }
+        case TCPMessageType::CREATE_ROOM_RESPONSE: {
+            CreateRoomResponse response;
+            if (size < sizeof(response))
+                return 0;
+            std::memcpy(&response, data, sizeof(response));
+            _createRoomResult = response.roomId;
+            return sizeof(response);
+        }
+        case TCPMessageType::JOIN_ROOM_RESPONSE: {
+            JoinRoomResponse response;
+            if (size < sizeof(response))
+                return 0;
+            std::memcpy(&response, data, sizeof(response));
+            _joinRoomResult = response.status == 1;
+            return sizeof(response);
+        }
+        case TCPMessageType::LOBBY_STATE_RESPONSE: {
+            LobbyStateResponse header;
+            if (size < sizeof(header))
+                return 0;
+            std::memcpy(&header, data, sizeof(header));
+            size_t count = header.playerCount > 0 ? static_cast<size_t>(header.playerCount) : 0;
+            size_t total = sizeof(header) + count * sizeof(LobbyPlayerInfo);
+            if (size < total)
+                return 0;
+            _lobbyState.hostId = header.hostId;
+            _lobbyState.players.resize(count);
+            std::memcpy(_lobbyState.players.data(), data + sizeof(header), count * sizeof(LobbyPlayerInfo));
+            return total;
+        }
+        case TCPMessageType::GAME_STARTING_NOTIFICATION:
+            _lobbyState.gameIsStarting = true;
+            Network::log() << "[DEBUG] Game Starting Notification received" << std::endl;
+            return sizeof(GameStartingNotification);
+        case TCPMessageType::CHAT_MESSAGE: {
+            uint16_t length = 0;
+            if (size < 1 + sizeof(length))
+                return 0;
+            std::memcpy(&length, data + 1, sizeof(length));
+            size_t total = 1 + sizeof(length) + length;
+            if (size < total)
+                return 0;
+            _chatMessages.emplace_back(reinterpret_cast<const char*>(data) + 1 + sizeof(length), length);
+            return total;
+        }
+        case TCPMessageType::CONNECT_ERROR: {
+            ErrorResponse err;
+            if (size < sizeof(err))
+                return 0;
+            std::memcpy(&err, data, sizeof(err));
+            err.message[sizeof(err.message) - 1] = '\0';
+            std::cerr << "Server Error: " << err.message << "\n";
+            if (_createRoomState == RequestState::SENT_REQUEST)
+                _createRoomResult = -1;
+            else if (_joinRoomState == RequestState::SENT_REQUEST)
+                _joinRoomResult = false;
+            return sizeof(err);
+        }
+        default:
+            std::cerr << "Unknown TCP message type from server: " << static_cast<int>(data[0]) << std::endl;
+            return 1;
+    }
+}
 
-        cachedRooms = newRooms;
-        return newRooms;
-
-    } catch (const std::exception& e) {
-        std::cerr << "getRooms failed: " << e.what() << std::endl;
+std::vector<RoomInfo> TCPClient::getRooms()
+{
+    if (!_roomListRequested) {
+        asio::error_code ec;
+        ListRoomsRequest req;
+        asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
+        if (ec) {
+            std::cerr << "getRooms send failed: " << ec.message() << std::endl;
+            return _rooms;
+        }
+        _roomListRequested = true;
     }
-    return cachedRooms;
+    pollMessages();
+    return _rooms;
 }
 
 std::optional<int> TCPClient::createRoom()
 {
-    asio::error_code ec;
-
-    switch (_createRoomState) {
-        case RequestState::IDLE: {
-            std::cout << "[DEBUG] createRoom: Sending request..." << std::endl;
-            CreateRoomRequest req;
-            asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
-            if (ec) {
-                std::cerr << "createRoom send failed: " << ec.message() << std::endl;
-                return std::optional<int>(-1);
-            }
-            _createRoomState = RequestState::SENT_REQUEST;
-            return std::nullopt;
-        }
-        case RequestState::SENT_REQUEST: {
-            if (_socket.available() < 1) {
-                return std::nullopt;
-            }
-
-            _socket.non_blocking(false);
-
-            uint8_t respType = 0;
-            asio::read(_socket, asio::buffer(&respType, 1), ec);
-
-            std::cout << "[DEBUG] createRoom: Received response type " << (int)respType << std::endl;
-            if (ec) {
-                std::cerr << "createRoom read type failed: " << ec.message() << std::endl;
-                _createRoomState = RequestState::IDLE;
-                _socket.non_blocking(true);
-                return std::optional<int>(-1);
-            }
-            _createRoomPendingRespType = respType;
-
-            if (_createRoomPendingRespType == TCPMessageType::CREATE_ROOM_RESPONSE) {
-                int roomId = 0;
-                asio::read(_socket, asio::buffer(&roomId, sizeof(roomId)), ec);
-                if (ec) {
-                    std::cerr << "createRoom read roomId failed: " << ec.message() << std::endl;
-                    _createRoomState = RequestState::IDLE;
-                    _createRoomPendingRespType = 0;
-                    _socket.non_blocking(true);
-                    return std::optional<int>(-1);
-                }
-                std::cout << "[DEBUG] createRoom: Success, RoomID=" << roomId << std::endl;
-                _createRoomState = RequestState::IDLE;
-                _createRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return roomId;
-            } else if (_createRoomPendingRespType == TCPMessageType::CONNECT_ERROR) {
-                ErrorResponse err{};
-                err.type = TCPMessageType::CONNECT_ERROR;
-                asio::read(_socket, asio::buffer(reinterpret_cast<char*>(&err) + 1, sizeof(err) - 1), ec);
-                if (ec) {
-                    std::cerr << "Error reading error response: " << ec.message() << std::endl;
-                }
-                std::cerr << "Server Error during createRoom: " << err.message << "\n";
-                _createRoomState = RequestState::IDLE;
-                _createRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return std::optional<int>(-1);
-            } else if (_createRoomPendingRespType == TCPMessageType::LIST_ROOMS_RESPONSE) {
-                std::cout << "[DEBUG] createRoom: Draining stray LIST_ROOMS_RESPONSE" << std::endl;
-                int count = 0;
-                asio::read(_socket, asio::buffer(&count, sizeof(count)), ec);
-                if (!ec && count > 0) {
-                    std::vector<char> trash(count * sizeof(RoomInfo));
-                    asio::read(_socket, asio::buffer(trash), ec);
-                }
-                _socket.non_blocking(true);
-
-                return std::nullopt;
-            } else {
-                std::cerr << "Invalid response type from server for createRoom: " << static_cast<int>(_createRoomPendingRespType) << "\n";
-                _createRoomState = RequestState::IDLE;
-                _createRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return std::optional<int>(-1);
-            }
+    if (_createRoomState == RequestState::IDLE) {
+        Network::log() << "[DEBUG] createRoom: Sending request..." << std::endl;
+        asio::error_code ec;
+        CreateRoomRequest req;
+        asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
+        if (ec) {
+            std::cerr << "createRoom send failed: " << ec.message() << std::endl;
+            return std::optional<int>(-1);
         }
-        default:
+        _createRoomResult.reset();
+        _createRoomState = RequestState::SENT_REQUEST;
+        return std::nullopt;
+    }
+
+    pollMessages();
+    if (!_createRoomResult.has_value()) {
+        if (_lobbyState.disconnected) {
             _createRoomState = RequestState::IDLE;
             return std::optional<int>(-1);
+        }
+        return std::nullopt;
     }
+    Network::log() << "[DEBUG] createRoom: RoomID=" << *_createRoomResult << std::endl;
+    _createRoomState = RequestState::IDLE;
+    return std::exchange(_createRoomResult, std::nullopt);
 }
 
 std::optional<bool> TCPClient::joinRoom(int roomId)
 {
-    asio::error_code ec;
-
-    switch (_joinRoomState) {
-        case RequestState::IDLE: {
-            std::cout << "[DEBUG] joinRoom: Sending request for RoomID=" << roomId << "..." << std::endl;
-            JoinRoomRequest req;
-            req.roomId = roomId;
-            asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
-            if (ec) {
-                std::cerr << "joinRoom send failed: " << ec.message() << std::endl;
-                return std::optional<bool>(false);
-            }
-            _joinRoomState = RequestState::SENT_REQUEST;
-            return std::nullopt;
-        }
-        case RequestState::SENT_REQUEST: {
-            if (_socket.available() < 1) {
-                return std::nullopt;
-            }
-
-            _socket.non_blocking(false);
-
-            uint8_t respType = 0;
-            asio::read(_socket, asio::buffer(&respType, 1), ec);
-
-            std::cout << "[DEBUG] joinRoom: Received response type " << (int)respType << std::endl;
-            if (ec) {
-                std::cerr << "joinRoom read type failed: " << ec.message() << std::endl;
-                _joinRoomState = RequestState::IDLE;
-                _socket.non_blocking(true);
-                return std::optional<bool>(false);
-            }
-            _joinRoomPendingRespType = respType;
-
-            if (_joinRoomPendingRespType == TCPMessageType::JOIN_ROOM_RESPONSE) {
-                int status = 0;
-                asio::read(_socket, asio::buffer(&status, sizeof(status)), ec);
-                if (ec) {
-                    std::cerr << "joinRoom read status failed: " << ec.message() << std::endl;
-                    _joinRoomState = RequestState::IDLE;
-                    _joinRoomPendingRespType = 0;
-                    _socket.non_blocking(true);
-                    return std::optional<bool>(false);
-                }
-                std::cout << "[DEBUG] joinRoom: Success, Status=" << status << std::endl;
-                _joinRoomState = RequestState::IDLE;
-                _joinRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return status == 1;
-            } else if (_joinRoomPendingRespType == TCPMessageType::CONNECT_ERROR) {
-                ErrorResponse err{};
-                err.type = TCPMessageType::CONNECT_ERROR;
-                asio::read(_socket, asio::buffer(reinterpret_cast<char*>(&err) + 1, sizeof(err) - 1), ec);
-                if (ec) {
-                    std::cerr << "Error reading error response: " << ec.message() << std::endl;
-                }
-                std::cerr << "Server Error during joinRoom: " << err.message << "\n";
-                _joinRoomState = RequestState::IDLE;
-                _joinRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return std::optional<bool>(false);
-            } else if (_joinRoomPendingRespType == TCPMessageType::LIST_ROOMS_RESPONSE) {
-                std::cout << "[DEBUG] joinRoom: Draining stray LIST_ROOMS_RESPONSE" << std::endl;
-                int count = 0;
-                asio::read(_socket, asio::buffer(&count, sizeof(count)), ec);
-                if (!ec && count > 0) {
-                    std::vector<char> trash(count * sizeof(RoomInfo));
-                    asio::read(_socket, asio::buffer(trash), ec);
-                }
-                _socket.non_blocking(true);
-
-                return std::nullopt;
-            } else {
-                std::cerr << "Invalid response type from server for joinRoom: " << static_cast<int>(_joinRoomPendingRespType) << "\n";
-                _joinRoomState = RequestState::IDLE;
-                _joinRoomPendingRespType = 0;
-                _socket.non_blocking(true);
-                return std::optional<bool>(false);
-            }
+    if (_joinRoomState == RequestState::IDLE) {
+        Network::log() << "[DEBUG] joinRoom: Sending request for RoomID=" << roomId << "..." << std::endl;
+        asio::error_code ec;
+        JoinRoomRequest req;
+        req.roomId = roomId;
+        asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
+        if (ec) {
+            std::cerr << "joinRoom send failed: " << ec.message() << std::endl;
+            return std::optional<bool>(false);
         }
-        default:
+        _joinRoomResult.reset();
+        _joinRoomState = RequestState::SENT_REQUEST;
+        return std::nullopt;
+    }
+
+    pollMessages();
+    if (!_joinRoomResult.has_value()) {
+        if (_lobbyState.disconnected) {
             _joinRoomState = RequestState::IDLE;
             return std::optional<bool>(false);
+        }
+        return std::nullopt;
     }
+    Network::log() << "[DEBUG] joinRoom: Status=" << *_joinRoomResult << std::endl;
+    _joinRoomState = RequestState::IDLE;
+    return std::exchange(_joinRoomResult, std::nullopt);
 }
 
 void TCPClient::sendStartGameRequest()
 {
-    std::cout << "[DEBUG] Sending START_GAME_REQUEST to server..." << std::endl;
+    Network::log() << "[DEBUG] Sending START_GAME_REQUEST to server..." << std::endl;
     asio::error_code ec;
     StartGameRequest req;
     asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
     if (ec) {
         std::cerr << "sendStartGameRequest failed: " << ec.message() << std::endl;
     } else {
-        std::cout << "[DEBUG] START_GAME_REQUEST sent successfully." << std::endl;
+        Network::log() << "[DEBUG] START_GAME_REQUEST sent successfully." << std::endl;
     }
 }
 
 LobbyState TCPClient::getLobbyState()
 {
-    static LobbyState cachedState;
-    asio::error_code ec;
-
-    try {
-        GetLobbyStateRequest req;
-        asio::write(_socket, asio::buffer(&req, sizeof(req)), ec);
-        if (ec) return cachedState;
-
-        int max_loops = 10;
-        while (_socket.available() > 0 && max_loops > 0) {
-            max_loops--;
-
-            _socket.non_blocking(false);
-
-            uint8_t respType = 0;
-            asio::read(_socket, asio::buffer(&respType, 1), ec);
-
-            if (ec) break;
-
-            std::cout << "[DEBUG] getLobbyState: Processing packet type " << (int)respType << std::endl;
-            if (respType == TCPMessageType::LOBBY_STATE_RESPONSE) {
-                uint32_t hostId = 0;
-                int32_t playerCount = 0;
-
-                std::vector<asio::mutable_buffer> bufs;
-                bufs.push_back(asio::buffer(&hostId, sizeof(hostId)));
-                bufs.push_back(asio::buffer(&playerCount, sizeof(playerCount)));
-                asio::read(_socket, bufs, ec);
-
-                if (!ec) {
-                    std::cout << "[DEBUG] getLobbyState: HostID=" << hostId << ", PlayerCount=" << playerCount << std::endl;
-                    std::vector<LobbyPlayerInfo> players;
-                    for (int i = 0; i < playerCount; ++i) {
-                        LobbyPlayerInfo pInfo;
-                        asio::read(_socket, asio::buffer(&pInfo, sizeof(pInfo)), ec);
-                        if (ec) break;
-                        players.push_back(pInfo);
-                        std::cout << "[DEBUG]   - Player[" << i << "]: ID=" << pInfo.playerId << ", Name=" << pInfo.username << std::endl;
-                    }
-                    if (!ec) {
-                        cachedState.hostId = hostId;
-                        cachedState.players = players;
-                        cachedState.gameIsStarting = false;
-                    }
-                }
-            } else if (respType == TCPMessageType::GAME_STARTING_NOTIFICATION) {
-                cachedState.gameIsStarting = true;
-                std::cout << "[DEBUG] getLobbyState: Game Starting Notification received" << std::endl;
-            } else if (respType == TCPMessageType::LIST_ROOMS_RESPONSE) {
-                std::cout << "[DEBUG] getLobbyState: Draining stray LIST_ROOMS_RESPONSE" << std::endl;
-                int count = 0;
-                asio::read(_socket, asio::buffer(&count, sizeof(count)), ec);
-                if (!ec && count > 0) {
-                    std::vector<char> trash(count * sizeof(RoomInfo));
-                    asio::read(_socket, asio::buffer(trash), ec);
-                }
-            } else if (respType == TCPMessageType::CREATE_ROOM_RESPONSE) {
-                std::cout << "[DEBUG] getLobbyState: Draining stray CREATE_ROOM_RESPONSE" << std::endl;
-                int32_t rid;
-                asio::read(_socket, asio::buffer(&rid, sizeof(rid)), ec);
-            } else if (respType == TCPMessageType::JOIN_ROOM_RESPONSE) {
-                std::cout << "[DEBUG] getLobbyState: Draining stray JOIN_ROOM_RESPONSE" << std::endl;
-                int32_t status;
-                asio::read(_socket, asio::buffer(&status, sizeof(status)), ec);
-            } else if (respType == TCPMessageType::CONNECT_ERROR) {
-                ErrorResponse err{};
-                asio::read(_socket, asio::buffer(reinterpret_cast<char*>(&err) + 1, sizeof(err) - 1), ec);
-            } else {
-                std::cerr << "Unknown packet type in getLobbyState: " << (int)respType << std::endl;
-            }
-
-            _socket.non_blocking(true);
-        }
-
-    } catch (const std::exception& e) {
-        std::cerr << "getLobbyState failed: " << e.what() << std::endl;
-        try { _socket.non_blocking(true); } catch(...) {}
-    }
-    return cachedState;
+    pollMessages();
+    return _lobbyState;
 }
 
 bool TCPClient::checkConnection()
@@ -411,10 +328,6 @@ bool TCPClient::checkConnection()
     char d;
     _socket.read_some(asio::buffer(&d, 0), ec);
 
-    asio::error_code ec_block;
-    _socket.non_blocking(false, ec_block);
-    if (ec_block) { return false; }
-
     if (ec == asio::error::would_block) {
         return true;
     }
@@ -447,31 +360,6 @@ void TCPClient::sendChatMessage(const std::string& message)
 
 std::vector<std::string> TCPClient::receiveChatMessages()
 {
-    std::vector<std::string> messages;
-    try {
-        while (_socket.available() >= 3) {
-            std::array<uint8_t, 3> header;
-            _socket.receive(asio::buffer(header), asio::socket_base::message_peek);
-
-            uint8_t type = header[0];
-            uint16_t length = 0;
-            std::memcpy(&length, &header[1], sizeof(length));
-
-            if (type == TCPMessageType::CHAT_MESSAGE) {
-                if (_socket.available() >= 3 + length) {
-                    std::vector<char> buffer(3 + length);
-                    asio::read(_socket, asio::buffer(buffer));
-                    messages.emplace_back(buffer.data() + 3, length);
-                } else {
-                    break;
-                }
-            } else {
-
-                uint8_t trash;
-                asio::read(_socket, asio::buffer(&trash, 1));
-            }
-        }
-    } catch (...) {
-    }
-    return messages;
+    pollMessages();
+    return std::exchange(_chatMessages, {});
 }
@@ -6,16 +6,418 @@
 */
 
 #include "Network/TCP/TCPServer.hpp"
+#include "Network/Log.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <cstring>
 #include <memory>
 #include <cstdint>
+#include <functional>
+#include <chrono>
+
+/**
+ * @brief Appends the raw bytes of a packed struct to a buffer.
+ */
+template <typename T>
+static void append(std::vector<uint8_t>& out, const T& packet)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&packet);
+    out.insert(out.end(), bytes, bytes + sizeof(packet));
+}
+
+template <typename T>
+static std::shared_ptr<const std::vector<uint8_t>> serialize(const T& packet)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&packet);
+    return std::make_shared<const std::vector<uint8_t>>(bytes, bytes + sizeof(packet));
+}
+
+/**
+ * @brief Appends a LIST_ROOMS_RESPONSE followed by its RoomInfo entries.
+ */
+static void appendRoomList(std::vector<uint8_t>& out, const std::vector<Network::RoomSimpleInfo>& rooms)
+{
+    ListRoomsResponse resp;
+    resp.count = static_cast<int>(rooms.size());
+    out.reserve(out.size() + sizeof(resp) + rooms.size() * sizeof(RoomInfo));
+    append(out, resp);
+    for (auto const& r : rooms) {
+        RoomInfo info;
+
+        info.id = r.id;
+        info.playerCount = r.playerCount;
+        info.maxPlayers = 4;
+        append(out, info);
+    }
+}
+
+/**
+ * @brief Appends a LOBBY_STATE_RESPONSE followed by its LobbyPlayerInfo entries.
+ */
+static void appendLobbyState(std::vector<uint8_t>& out, uint32_t hostId,
+    const std::vector<std::pair<uint32_t, std::string>>& players)
+{
+    LobbyStateResponse resp;
+    resp.type = TCPMessageType::LOBBY_STATE_RESPONSE;
+    resp.hostId = hostId;
+    resp.playerCount = static_cast<int32_t>(players.size());
+
+    out.reserve(out.size() + sizeof(resp) + players.size() * sizeof(LobbyPlayerInfo));
+    append(out, resp);
+    for (const auto& player : players) {
+        LobbyPlayerInfo info{};
+        info.playerId = player.first;
+        std::strncpy(info.username, player.second.c_str(), 31);
+        info.username[31] = '\0';
+        append(out, info);
+    }
+}
+
+/**
+ * @class TCPServer::Session
+ * @brief One client connection, from the CONNECT handshake until the socket closes.
+ *
+ * Every handler runs on the strand the socket was accepted on, so the session
+ * state needs no lock. Other threads only interact with it through send() and
+ * close(), which post to that strand.
+ *
+ * Outgoing bytes are appended to a pending buffer owned by the session and
+ * flushed with one async_write. While a write is in flight, new replies and
+ * broadcasts pile up in the pending buffer and go out together in the next
+ * write, so a multi-part reply costs one syscall, and a slow client only
+ * grows its own buffer, up to MAX_PENDING_BYTES: past that the client is not
+ * reading and the session is closed. The two buffers swap roles after each
+ * write and keep their capacity, so steady-state replies allocate nothing.
+ */
+class TCPServer::Session : public std::enable_shared_from_this<TCPServer::Session> {
+public:
+    static constexpr int NO_ROOM = -1;
+
+    Session(TCPServer& server, asio::ip::tcp::socket socket)
+        : _server(server), _socket(std::move(socket))
+    {
+    }
+
+    /**
+     * @brief Starts reading the CONNECT request.
+     */
+    void start()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(&_connectRequest, LEGACY_CONNECT_SIZE),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec || (_connectRequest.type != TCPMessageType::CONNECT && _connectRequest.type != TCPMessageType::CONNECT_VERSIONED)) {
+                    Network::log() << "[TCP] Client disconnected. (Invalid connect request)" << std::endl;
+                    finish();
+                    return;
+                }
+                if (_connectRequest.type == TCPMessageType::CONNECT) {
+                    _connectRequest.protocolVersion = PROTOCOL_VERSION_LEGACY;
+                    onConnect();
+                } else {
+                    readProtocolVersion();
+                }
+            });
+    }
+
+    /**
+     * @brief Queues a message. Safe to call from any thread.
+     * @param message The serialized message, shared between the recipients of a broadcast.
+     */
+    void send(std::shared_ptr<const std::vector<uint8_t>> message)
+    {
+        auto self = shared_from_this();
+        asio::post(_socket.get_executor(), [this, self, message = std::move(message)] {
+            if (_finished)
+                return;
+            _pending.insert(_pending.end(), message->begin(), message->end());
+            flush();
+        });
+    }
+
+    /**
+     * @brief Closes the socket. Safe to call from any thread.
+     */
+    void close()
+    {
+        auto self = shared_from_this();
+        asio::post(_socket.get_executor(), [this, self] { closeSocket(); });
+    }
+
+    /**
+     * @brief Closes the socket from the calling thread. Only used once the IO threads are joined.
+     */
+    void closeSocket()
+    {
+        asio::error_code ec;
+        _socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+        _socket.close(ec);
+    }
+
+    uint32_t playerId() const { return _playerId; }
+    int roomId() const { return _roomId.load(std::memory_order_relaxed); }
+    bool subscribedToRooms() const { return _subscribedToRooms.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t MAX_PENDING_BYTES = 256 * 1024; /**< Pending bytes above which a client is considered stalled */
+    static constexpr size_t LEGACY_CONNECT_SIZE = offsetof(ConnectRequest, protocolVersion); /**< CONNECT request size before versioning */
+
+    void readProtocolVersion()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(&_connectRequest.protocolVersion, sizeof(_connectRequest.protocolVersion)),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    finish();
+                    return;
+                }
+                onConnect();
+            });
+    }
+
+    void onConnect()
+    {
+        _username.assign(_connectRequest.username, strnlen(_connectRequest.username, sizeof(_connectRequest.username)));
+        _playerId = _server.registerSession(shared_from_this());
+        _protocolVersion = std::clamp(_connectRequest.protocolVersion, PROTOCOL_VERSION_LEGACY, PROTOCOL_VERSION);
+
+        ConnectResponse connectRes;
+        connectRes.type = TCPMessageType::CONNECT_OK;
+        connectRes.playerId = _playerId;
+        connectRes.udpPort = 5252;
+        connectRes.serverTimeMs = _server._clock.getElapsedTimeMs();
+        connectRes.protocolVersion = _protocolVersion;
+        if (_connectRequest.type == TCPMessageType::CONNECT_VERSIONED) {
+            reply(connectRes);
+        } else {
+            // A legacy client reads the response without the version byte.
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&connectRes);
+            _pending.insert(_pending.end(), bytes, bytes + offsetof(ConnectResponse, protocolVersion));
+            flush();
+        }
+        readMessageType();
+    }
+
+    void readMessageType()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(&_messageType, sizeof(_messageType)),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    finish();
+                    return;
+                }
+                if (roomId() == NO_ROOM)
+                    handleLobbyMessage();
+                else
+                    handleRoomMessage();
+            });
+    }
+
+    void handleLobbyMessage()
+    {
+        switch (static_cast<TCPMessageType>(_messageType)) {
+            case TCPMessageType::LIST_ROOMS: {
+                // Subscribing first: a delta pushed meanwhile is written after this list.
+                _subscribedToRooms.store(true, std::memory_order_relaxed);
+                appendRoomList(_pending, _server._handler->onGetRooms());
+                flush();
+                break;
+            }
+            case TCPMessageType::CREATE_ROOM: {
+                int newRoomId = _server._handler->onCreateRoom();
+                CreateRoomResponse resp{.roomId = newRoomId};
+                reply(resp);
+                break;
+            }
+            case TCPMessageType::JOIN_ROOM:
+                readJoinRoom();
+                return;
+            default:
+                break;
+        }
+        readMessageType();
+    }
+
+    void readJoinRoom()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(&_joinRoomId, sizeof(_joinRoomId)),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    finish();
+                    return;
+                }
+                // Set before the join, so the lobby state it pushes reaches this session,
+                // queued behind the JOIN_ROOM_RESPONSE written below.
+                _roomId.store(_joinRoomId, std::memory_order_relaxed);
+                bool success = _server._handler->onJoinRoom(_joinRoomId, _playerId, _username, _protocolVersion);
+                JoinRoomResponse resp;
+                resp.status = success ? 1 : 0;
+                reply(resp);
+                if (!success)
+                    _roomId.store(NO_ROOM, std::memory_order_relaxed);
+                readMessageType();
+            });
+    }
+
+    void handleRoomMessage()
+    {
+        int roomId = this->roomId();
+
+        if (static_cast<TCPMessageType>(_messageType) == TCPMessageType::START_GAME_REQUEST) {
+            _server._handler->onStartGame(roomId, _playerId);
+        } else if (static_cast<TCPMessageType>(_messageType) == TCPMessageType::GET_LOBBY_STATE) {
+            if (_server._handler->isGameStarting(roomId)) {
+                GameStartingNotification notif;
+                reply(notif);
+            } else {
+                uint32_t hostId = 0;
+                std::vector<std::pair<uint32_t, std::string>> players;
+                _server._handler->onGetLobbyState(roomId, hostId, players);
+                appendLobbyState(_pending, hostId, players);
+                flush();
+            }
+        } else if (static_cast<TCPMessageType>(_messageType) == TCPMessageType::CHAT_MESSAGE) {
+            readChatLength();
+            return;
+        }
+        readMessageType();
+    }
+
+    void readChatLength()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(&_chatLength, sizeof(_chatLength)),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    finish();
+                    return;
+                }
+                if (_chatLength == 0) {
+                    readMessageType();
+                    return;
+                }
+                _chatBuffer.resize(_chatLength);
+                readChatBody();
+            });
+    }
+
+    void readChatBody()
+    {
+        auto self = shared_from_this();
+        asio::async_read(_socket, asio::buffer(_chatBuffer),
+            [this, self](const asio::error_code& ec, size_t) {
+                if (ec) {
+                    finish();
+                    return;
+                }
+                std::string fullMsg = _username + ": " + std::string(_chatBuffer.begin(), _chatBuffer.end());
+
+                uint16_t newLen = static_cast<uint16_t>(fullMsg.size());
+                auto packet = std::make_shared<std::vector<uint8_t>>(3 + newLen);
+                (*packet)[0] = static_cast<uint8_t>(TCPMessageType::CHAT_MESSAGE);
+                std::memcpy(packet->data() + 1, &newLen, sizeof(newLen));
+                std::memcpy(packet->data() + 3, fullMsg.data(), newLen);
+
+                _server.broadcastChat(roomId(), _playerId, packet);
+                readMessageType();
+            });
+    }
+
+    /**
+     * @brief Queues a reply to this client and flushes it.
+     */
+    template <typename T>
+    void reply(const T& packet)
+    {
+        append(_pending, packet);
+        flush();
+    }
+
+    /**
+     * @brief Writes the pending bytes, unless a write is already in flight.
+     * Closes the session instead when more than MAX_PENDING_BYTES are waiting.
+     */
+    void flush()
+    {
+        if (_finished)
+            return;
+        if (_pending.size() > MAX_PENDING_BYTES) {
+            Network::log() << "[TCP] Client " << _playerId << " disconnected. (Not reading, "
+                      << _pending.size() << " bytes pending)" << std::endl;
+            // The pending read fails and runs finish().
+            _pending.clear();
+            _pending.shrink_to_fit();
+            closeSocket();
+            return;
+        }
+        if (_writing || _pending.empty())
+            return;
+        _writing = true;
+        _inFlight.swap(_pending);
+        _pending.clear();
+
+        auto self = shared_from_this();
+        asio::async_write(_socket, asio::buffer(_inFlight),
+            [this, self](const asio::error_code& ec, size_t) {
+                _writing = false;
+                _inFlight.clear();
+                if (ec) {
+                    // The pending read fails too and runs finish().
+                    _pending.clear();
+                    closeSocket();
+                    return;
+                }
+                flush();
+            });
+    }
+
+    /**
+     * @brief Runs once, when the connection is over.
+     */
+    void finish()
+    {
+        if (_finished)
+            return;
+        _finished = true;
+        int roomId = this->roomId();
+        if (roomId != NO_ROOM && _server._running)
+            _server._handler->onPlayerDisconnect(_playerId, roomId);
+        if (_playerId != 0)
+            _server.unregisterSession(_playerId);
+        _pending.clear();
+        closeSocket();
+    }
 
-TCPServer::TCPServer(int port, Network::ITCPHandler* handler, Clock& clock)
+    TCPServer& _server;
+    asio::ip::tcp::socket _socket;
+
+    ConnectRequest _connectRequest{};
+    uint8_t _messageType = 0;
+    int32_t _joinRoomId = 0;
+    uint16_t _chatLength = 0;
+    std::vector<char> _chatBuffer;
+    std::vector<uint8_t> _pending; /**< Bytes waiting for the next write */
+    std::vector<uint8_t> _inFlight; /**< Bytes of the write in progress */
+    bool _writing = false;
+    bool _finished = false;
+
+    uint32_t _playerId = 0;
+    std::string _username;
+    uint8_t _protocolVersion = PROTOCOL_VERSION_LEGACY; /**< UDP protocol version negotiated at CONNECT */
+    std::atomic<int> _roomId{NO_ROOM};
+    std::atomic<bool> _subscribedToRooms{false}; /**< Set by the first LIST_ROOMS, receives room list deltas while outside a room */
+};
+
+TCPServer::TCPServer(int port, Network::ITCPHandler* handler, Clock& clock, size_t ioThreads)
     : _io_context(),
-        _acceptor(_io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
+        _acceptor(asio::make_strand(_io_context), asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
+        _acceptRetryTimer(_acceptor.get_executor()),
         _running(false),
         _handler(handler),
+        _ioThreadCount(ioThreads ? ioThreads : 1),
         _clock(clock)
 {
 }
@@ -31,8 +433,11 @@ void TCPServer::start()
         return;
     _running = true;
     _io_context.restart();
-    std::cout << "[TCP] Server starting..." << std::endl;
-    _acceptThread = std::thread(&TCPServer::acceptLoop, this);
+    Network::log() << "[TCP] Server starting on " << _ioThreadCount << " IO threads..." << std::endl;
+    _workGuard.emplace(_io_context.get_executor());
+    asio::post(_acceptor.get_executor(), [this] { startAccept(); });
+    for (size_t i = 0; i < _ioThreadCount; ++i)
+        _ioThreads.emplace_back([this] { _io_context.run(); });
 }
 
 void TCPServer::stop()
@@ -41,252 +446,153 @@ void TCPServer::stop()
     if (!_running.compare_exchange_strong(expected, false))
         return;
 
-    std::cout << "[TCP] Server stopping..." << std::endl;
-
-    unsigned short port = 0;
-    try {
-        if (_acceptor.is_open())
-            port = _acceptor.local_endpoint().port();
-    } catch (...) {}
-
-    asio::error_code ec;
-    _acceptor.close(ec);
+    Network::log() << "[TCP] Server stopping..." << std::endl;
 
-    if (port != 0) {
-        try {
-            asio::io_context tempContext;
-            asio::ip::tcp::socket dummySocket(tempContext);
-            asio::ip::tcp::endpoint target(asio::ip::tcp::v4(), port);
+    _workGuard.reset();
+    _io_context.stop();
 
-            dummySocket.connect(target, ec);
-            dummySocket.close();
-        } catch (...) {
-        }
+    Network::log() << "[TCP] Server stopped. 1 (Joining IO threads)" << std::endl;
+    for (auto& thread : _ioThreads) {
+        if (thread.joinable())
+            thread.join();
     }
+    _ioThreads.clear();
 
-    std::cout << "[TCP] Server stopped. 1 (Joining accept thread)" << std::endl;
-    if (_acceptThread.joinable())
-        _acceptThread.join();
-
-    std::cout << "[TCP] Server stopped. 2 (Closing client sockets)" << std::endl;
+    asio::error_code ec;
+    _acceptRetryTimer.cancel();
+    _acceptor.close(ec);
 
+    Network::log() << "[TCP] Server stopped. 2 (Closing client sockets)" << std::endl;
+    std::map<uint32_t, std::shared_ptr<Session>> sessions;
     {
         std::lock_guard<std::mutex> lock(_serverMutex);
-        for (auto& pair : _playerSockets) {
-            if (pair.second && pair.second->is_open()) {
-                pair.second->close();
-            }
-        }
-    }
-
-    for (auto& thread : _clientThreads) {
-        if (thread.joinable())
-            thread.join();
+        sessions.swap(_sessions);
     }
-    _clientThreads.clear();
-    std::cout << "[TCP] Server fully stopped." << std::endl;
+    for (auto& [id, session] : sessions)
+        session->closeSocket();
+    Network::log() << "[TCP] Server fully stopped." << std::endl;
 }
 
-void TCPServer::acceptLoop()
+void TCPServer::startAccept()
 {
-    while (_running) {
-        auto clientSocket = std::make_shared<asio::ip::tcp::socket>(_io_context);
-        asio::error_code ec;
-        _acceptor.accept(*clientSocket, ec);
+    _acceptor.async_accept(asio::make_strand(_io_context),
+        [this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+            if (!_running || !_acceptor.is_open())
+                return;
+            if (ec) {
+                std::cerr << "[TCP] Accept error: " << ec.message() << std::endl;
+                _acceptRetryTimer.expires_after(std::chrono::milliseconds(100));
+                _acceptRetryTimer.async_wait([this](const asio::error_code& timerEc) {
+                    if (!timerEc && _running)
+                        startAccept();
+                });
+                return;
+            }
+            Network::log() << "[TCP] Client connection..." << std::endl;
+            // Replies are small and latency bound; Nagle would hold them for a delayed ACK.
+            asio::error_code optionEc;
+            socket.set_option(asio::ip::tcp::no_delay(true), optionEc);
+            std::make_shared<Session>(*this, std::move(socket))->start();
+            startAccept();
+        });
+}
 
-        if (!_running) {
-            return;
-        }
+uint32_t TCPServer::registerSession(const std::shared_ptr<Session>& session)
+{
+    uint32_t playerId = _nextPlayerId++;
+    std::lock_guard<std::mutex> lock(_serverMutex);
+    _sessions[playerId] = session;
+    return playerId;
+}
 
-        if (ec) {
-            if (_running)
-                std::cerr << "[TCP] Accept error: " << ec.message() << std::endl;
-            break;
-        }
-        std::cout << "[TCP] Client connection..." << std::endl;
-        _clientThreads.emplace_back(&TCPServer::handleClient, this, clientSocket);
-    }
+void TCPServer::unregisterSession(uint32_t playerId)
+{
+    std::lock_guard<std::mutex> lock(_serverMutex);
+    _sessions.erase(playerId);
 }
 
-void TCPServer::handleClient(std::shared_ptr<asio::ip::tcp::socket> clientSocket)
+std::vector<std::shared_ptr<TCPServer::Session>> TCPServer::collectSessions(const std::function<bool(const Session&)>& filter)
 {
-    asio::error_code ec;
+    std::vector<std::shared_ptr<Session>> recipients;
+    std::lock_guard<std::mutex> lock(_serverMutex);
 
-    ConnectRequest connectReq{};
-    asio::read(*clientSocket, asio::buffer(&connectReq, sizeof(connectReq)), ec);
-    if (ec == asio::error::eof || connectReq.type != TCPMessageType::CONNECT) {
-        clientSocket->close();
-        std::cout << "[TCP] Client disconnected. (Invalid connect request)" << std::endl;
-        return;
+    for (auto const& [pId, session] : _sessions) {
+        if (filter(*session))
+            recipients.push_back(session);
     }
+    return recipients;
+}
 
-    uint32_t playerId = _nextPlayerId++;
-    std::string username = connectReq.username;
+void TCPServer::broadcastChat(int roomId, uint32_t senderId, const std::shared_ptr<const std::vector<uint8_t>>& message)
+{
+    auto recipients = collectSessions([&](const Session& session) {
+        return session.playerId() != senderId && session.roomId() == roomId;
+    });
+    for (auto const& session : recipients)
+        session->send(message);
+}
 
-    {
-        std::lock_guard<std::mutex> lock(_serverMutex);
-        _playerSockets[playerId] = clientSocket;
-        _playerUsernames[playerId] = username;
-    }
+void TCPServer::sendToRoom(int roomId, const std::shared_ptr<const std::vector<uint8_t>>& message)
+{
+    auto recipients = collectSessions([&](const Session& session) { return session.roomId() == roomId; });
+    for (auto const& session : recipients)
+        session->send(message);
+}
 
-    ConnectResponse connectRes;
-    connectRes.type = TCPMessageType::CONNECT_OK;
-    connectRes.playerId = playerId;
-    connectRes.udpPort = 5252;
-        connectRes.serverTimeMs = _clock.getElapsedTimeMs();
+void TCPServer::sendToRoomListSubscribers(const std::shared_ptr<const std::vector<uint8_t>>& message)
+{
+    auto recipients = collectSessions([](const Session& session) {
+        return session.roomId() == Session::NO_ROOM && session.subscribedToRooms();
+    });
+    for (auto const& session : recipients)
+        session->send(message);
+}
 
-    asio::write(*clientSocket, asio::buffer(&connectRes, sizeof(connectRes)), ec);
+void TCPServer::sendGameStartingNotification(int roomId)
+{
+    sendToRoom(roomId, serialize(GameStartingNotification{}));
+}
 
-    if (ec)
-        return;
+void TCPServer::pushLobbyState(int roomId, uint32_t hostId, const std::vector<std::pair<uint32_t, std::string>>& players)
+{
+    auto message = std::make_shared<std::vector<uint8_t>>();
+    appendLobbyState(*message, hostId, players);
+    sendToRoom(roomId, message);
+}
 
-    bool inLobby = true;
-    while (inLobby && _running) {
-        uint8_t msgType;
-        asio::read(*clientSocket, asio::buffer(&msgType, sizeof(msgType)), ec);
-        if (ec) {
-            inLobby = false; continue;
-        }
+void TCPServer::pushRoomUpdate(const Network::RoomSimpleInfo& room)
+{
+    RoomUpdateNotification notif;
+    notif.room.id = room.id;
+    notif.room.playerCount = room.playerCount;
+    notif.room.maxPlayers = 4;
+    sendToRoomListSubscribers(serialize(notif));
+}
 
-        switch (static_cast<TCPMessageType>(msgType)) {
-            case TCPMessageType::LIST_ROOMS: {
-                auto rooms = _handler->onGetRooms();
-                ListRoomsResponse resp;
-                resp.count = static_cast<int>(rooms.size());
-                asio::write(*clientSocket, asio::buffer(&resp, sizeof(resp)), ec);
-                for (auto const& r : rooms) {
-                    RoomInfo info;
-
-                    info.id = r.id;
-                    info.playerCount = r.playerCount;
-                    info.maxPlayers = 4;
-                    asio::write(*clientSocket, asio::buffer(&info, sizeof(info)), ec);
-                }
-                break;
-            }
-            case TCPMessageType::CREATE_ROOM: {
-                int newRoomId = _handler->onCreateRoom();
-                CreateRoomResponse resp{.roomId = newRoomId};
-                asio::write(*clientSocket, asio::buffer(&resp, sizeof(resp)), ec);
-                break;
-            }
-            case TCPMessageType::JOIN_ROOM: {
-                JoinRoomRequest req;
-                asio::read(*clientSocket, asio::buffer(&req.roomId, sizeof(req.roomId)), ec);
+void TCPServer::pushRoomRemoved(int roomId)
+{
+    RoomRemovedNotification notif;
+    notif.roomId = roomId;
+    sendToRoomListSubscribers(serialize(notif));
+}
 
-                bool success = _handler->onJoinRoom(req.roomId, playerId, username);
-                JoinRoomResponse resp;
-                resp.status = success ? 1 : 0;
-                asio::write(*clientSocket, asio::buffer(&resp, sizeof(resp)), ec);
-
-                if (success) {
-                    {
-                        std::lock_guard<std::mutex> lock(_serverMutex);
-                        _playerRoomMap[playerId] = req.roomId;
-                    }
-                    handleInRoomClient(clientSocket, req.roomId, playerId);
-                    {
-                        std::lock_guard<std::mutex> lock(_serverMutex);
-                        _playerRoomMap.erase(playerId);
-                    }
-                    inLobby = false;
-                }
-                break;
-            }
-            default:
-                break;
-        }
-    }
-    {
-        std::lock_guard<std::mutex> lock(_serverMutex);
-        _playerSockets.erase(playerId);
-        _playerUsernames.erase(playerId);
-    }
-    clientSocket->close();
+void TCPServer::kickPlayer(uint32_t playerId)
+{
+    std::lock_guard<std::mutex> lock(_serverMutex);
+    auto it = _sessions.find(playerId);
+    if (it != _sessions.end())
+        it->second->close();
 }
 
-void TCPServer::handleInRoomClient(std::shared_ptr<asio::ip::tcp::socket> clientSocket, int roomId, uint32_t playerId)
+unsigned short TCPServer::getPort() const
 {
     asio::error_code ec;
-    bool inRoom = true;
-
-    while(inRoom && _running) {
-        uint8_t msgType;
-        asio::read(*clientSocket, asio::buffer(&msgType, sizeof(msgType)), ec);
-        if (ec) {
-            _handler->onPlayerDisconnect(playerId, roomId);
-            break;
-        }
-
-        if (static_cast<TCPMessageType>(msgType) == TCPMessageType::START_GAME_REQUEST) {
-            _handler->onStartGame(roomId, playerId);
-        }
-        else if (static_cast<TCPMessageType>(msgType) == TCPMessageType::GET_LOBBY_STATE) {
-            if (_handler->isGameStarting(roomId)) {
-                GameStartingNotification notif;
-                asio::write(*clientSocket, asio::buffer(&notif, sizeof(notif)), ec);
-            } else {
-                uint32_t hostId = 0;
-                std::vector<std::pair<uint32_t, std::string>> players;
-                _handler->onGetLobbyState(roomId, hostId, players);
-
-                LobbyStateResponse resp;
-                resp.type = TCPMessageType::LOBBY_STATE_RESPONSE;
-                resp.hostId = hostId;
-                resp.playerCount = static_cast<int32_t>(players.size());
-                asio::write(*clientSocket, asio::buffer(&resp, sizeof(resp)), ec);
-
-                for (const auto& player : players) {
-                    LobbyPlayerInfo info;
-                    info.playerId = player.first;
-                    std::strncpy(info.username, player.second.c_str(), 31);
-                    info.username[31] = '\0';
-                    asio::write(*clientSocket, asio::buffer(&info, sizeof(info)), ec);
-                }
-            }
-        } else if (static_cast<TCPMessageType>(msgType) == TCPMessageType::CHAT_MESSAGE) {
-            uint16_t length = 0;
-            asio::read(*clientSocket, asio::buffer(&length, sizeof(length)), ec);
-            if (!ec && length > 0) {
-                std::vector<char> msgBuffer(length);
-                asio::read(*clientSocket, asio::buffer(msgBuffer), ec);
-                if (!ec) {
-                    std::string msg(msgBuffer.begin(), msgBuffer.end());
-                    std::string senderName = "Unknown";
-                    {
-                        std::lock_guard<std::mutex> lock(_serverMutex);
-                        if (_playerUsernames.count(playerId)) senderName = _playerUsernames[playerId];
-                    }
-                    std::string fullMsg = senderName + ": " + msg;
-
-                    std::vector<uint8_t> packet;
-                    packet.push_back(static_cast<uint8_t>(TCPMessageType::CHAT_MESSAGE));
-                    uint16_t newLen = static_cast<uint16_t>(fullMsg.size());
-                    packet.resize(3);
-                    std::memcpy(&packet[1], &newLen, sizeof(newLen));
-                    packet.insert(packet.end(), fullMsg.begin(), fullMsg.end());
-
-                    std::lock_guard<std::mutex> lock(_serverMutex);
-                    for (auto const& [pId, sock] : _playerSockets) {
-                        if (pId != playerId && _playerRoomMap.count(pId) && _playerRoomMap[pId] == roomId) {
-                            asio::write(*sock, asio::buffer(packet), ec);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    auto endpoint = _acceptor.local_endpoint(ec);
+    return ec ? 0 : endpoint.port();
 }
 
-void TCPServer::kickPlayer(uint32_t playerId)
+size_t TCPServer::getSessionCount()
 {
     std::lock_guard<std::mutex> lock(_serverMutex);
-    auto it = _playerSockets.find(playerId);
-    if (it != _playerSockets.end()) {
-        if (it->second && it->second->is_open()) {
-            try {
-                it->second->close();
-            } catch (...) {}
-        }
-    }
-}
\ No newline at end of file
+    return _sessions.size();
+}
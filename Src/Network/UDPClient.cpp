@@ -6,6 +6,7 @@
 */
 
 #include "Network/UDP/UDPClient.hpp"
+#include <chrono>
 #include <stdexcept>
 
 UDPClient::UDPClient(const std::string& serverIp, uint16_t port)
@@ -24,3 +25,10 @@ UDPClient::~UDPClient()
         _socket.close();
     }
 }
+
+std::span<const char> UDPClient::reassemble(const char* data, size_t size) noexcept
+{
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return _reassembler.push(data, size, static_cast<uint32_t>(now));
+}
@@ -5,6 +5,143 @@
 ** UDPServer
 */
 #include "Network/UDP/UDPServer.hpp"
+#include "Network/Log.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <unordered_map>
+
+#if defined(__linux__) && defined(RTYPE_UDP_BATCHED_IO)
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #define RTYPE_HAS_MMSG
+#endif
+
+namespace {
+
+/**
+ * @struct StagedDestination
+ * @brief Bundle currently being filled for one destination.
+ */
+struct StagedDestination {
+    Network::Packet* bundle = nullptr; ///< Pooled datagram being built, nullptr when none is open
+    sockaddr_in addr;                  ///< Destination
+    uint8_t messageCount = 0;          ///< Messages already written in the bundle
+};
+
+/**
+ * @struct StagingBuffer
+ * @brief Per-thread storage of a TickBatch, reused across ticks to avoid allocations.
+ */
+struct StagingBuffer {
+    UDPServer* owner = nullptr;                     ///< Server the open TickBatch belongs to
+    std::unordered_map<uint64_t, size_t> index;     ///< Destination key -> slot in destinations
+    std::vector<StagedDestination> destinations;    ///< Open bundles, one per destination
+    size_t used = 0;                                ///< Number of slots in use this tick
+    std::vector<Network::Packet*> ready;            ///< Finished pooled datagrams waiting for the flush
+    uint64_t messages = 0;                          ///< Messages staged this tick
+    uint64_t copies = 0;                            ///< Payload copies into pooled datagrams this tick
+};
+
+thread_local StagingBuffer t_staging;
+
+uint64_t destinationKey(const sockaddr_in& addr)
+{
+    return (static_cast<uint64_t>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+}
+
+void closeBundle(StagingBuffer& staging, StagedDestination& dest)
+{
+    if (dest.messageCount == 0)
+        return;
+
+    Network::Packet& pkt = *dest.bundle;
+    if (dest.messageCount == 1) {
+        // A single message is sent as-is, the bundle framing would only add bytes.
+        size_t offset = sizeof(BundleHeader) + sizeof(BundledMessageHeader);
+        pkt.length -= offset;
+        std::memmove(pkt.data.data(), pkt.data.data() + offset, pkt.length);
+        ++staging.copies;
+    } else {
+        BundleHeader header;
+        header.messageCount = dest.messageCount;
+        std::memcpy(pkt.data.data(), &header, sizeof(header));
+    }
+    staging.ready.push_back(dest.bundle);
+    dest.bundle = nullptr;
+    dest.messageCount = 0;
+}
+
+/**
+ * Writes a message straight into the pooled bundle of its destination.
+ * @p acquire returns a pooled packet, or nullptr when the message has to be dropped.
+ */
+template<typename Acquire>
+void stageMessage(StagingBuffer& staging, const char* data, size_t length, const sockaddr_in& addr, Acquire&& acquire)
+{
+    auto [it, inserted] = staging.index.try_emplace(destinationKey(addr), staging.used);
+    if (inserted) {
+        if (staging.used == staging.destinations.size())
+            staging.destinations.emplace_back();
+        staging.destinations[staging.used].addr = addr;
+        staging.destinations[staging.used].bundle = nullptr;
+        staging.destinations[staging.used].messageCount = 0;
+        ++staging.used;
+    }
+    StagedDestination& dest = staging.destinations[it->second];
+    ++staging.messages;
+
+    size_t entrySize = sizeof(BundledMessageHeader) + length;
+    if (sizeof(BundleHeader) + entrySize > MAX_UDP_PACKET_SIZE) {
+        // Sent alone, after what is already bundled for this destination.
+        closeBundle(staging, dest);
+        Network::Packet* pkt = acquire();
+        if (!pkt)
+            return;
+        pkt->addr = addr;
+        pkt->length = length;
+        std::memcpy(pkt->data.data(), data, length);
+        ++staging.copies;
+        staging.ready.push_back(pkt);
+        return;
+    }
+
+    if (dest.messageCount == UINT8_MAX || (dest.messageCount > 0 && dest.bundle->length + entrySize > MAX_UDP_PACKET_SIZE))
+        closeBundle(staging, dest);
+    if (dest.messageCount == 0) {
+        dest.bundle = acquire();
+        if (!dest.bundle)
+            return;
+        dest.bundle->addr = dest.addr;
+        dest.bundle->length = sizeof(BundleHeader);
+    }
+
+    Network::Packet& bundle = *dest.bundle;
+    BundledMessageHeader entry;
+    entry.length = static_cast<uint16_t>(length);
+    std::memcpy(bundle.data.data() + bundle.length, &entry, sizeof(entry));
+    std::memcpy(bundle.data.data() + bundle.length + sizeof(entry), data, length);
+    bundle.length += entrySize;
+    ++dest.messageCount;
+    ++staging.copies;
+}
+
+}
+
+UDPServer::TickBatch::TickBatch(UDPServer& server)
+    : _server(server), _owner(t_staging.owner == nullptr)
+{
+    if (_owner)
+        t_staging.owner = &_server;
+}
+
+UDPServer::TickBatch::~TickBatch()
+{
+    if (!_owner)
+        return;
+    _server.flushStaged();
+    t_staging.owner = nullptr;
+}
 
 UDPServer::UDPServer(int port, Network::INetworkHandler* handler, Clock& clock)
     : _io_context(),
@@ -13,6 +150,9 @@ UDPServer::UDPServer(int port, Network::INetworkHandler* handler, Clock& clock)
         _clock(clock),
         _running(false)
 {
+#ifdef RTYPE_HAS_MMSG
+    _batchedIo = true;
+#endif
 }
 UDPServer::~UDPServer()
 {
@@ -25,7 +165,7 @@ void UDPServer::start()
         return;
 
     _running = true;
-    std::cout << "[UDP] Server starting..." << std::endl;
+    Network::log() << "[UDP] Server starting..." << std::endl;
 
     _recvThread = std::thread(&UDPServer::recvLoop, this);
     _sendThread = std::thread(&UDPServer::sendLoop, this);
@@ -38,7 +178,7 @@ void UDPServer::stop()
         return;
     }
 
-    std::cout << "[UDP] Server stopping..." << std::endl;
+    Network::log() << "[UDP] Server stopping..." << std::endl;
 
     unsigned short port = 0;
     try {
@@ -47,9 +187,16 @@ void UDPServer::stop()
     } catch (...) {}
 
     try {
+        // Wakes up a receive blocked in recvmmsg, closing the descriptor alone does not.
+        asio::error_code ec;
+        _socket.shutdown(asio::ip::udp::socket::shutdown_receive, ec);
         _socket.close();
     } catch (...) {}
 
+    _incomingWaiter.notify();
+    _outgoingWaiter.notify();
+    _incomingPoolWaiter.notify();
+
     if (port != 0) {
         try {
             asio::io_context tempContext;
@@ -62,7 +209,7 @@ void UDPServer::stop()
         }
     }
 
-    std::cout << "[UDP] Joining threads..." << std::endl;
+    Network::log() << "[UDP] Joining threads..." << std::endl;
 
     if (_recvThread.joinable())
         _recvThread.join();
@@ -73,56 +220,173 @@ void UDPServer::stop()
     if (_processThread.joinable())
         _processThread.join();
 
-    std::cout << "[UDP] All threads stopped." << std::endl;
+    Network::log() << "[UDP] All threads stopped." << std::endl;
 }
 
 void UDPServer::recvLoop()
 {
+    // Pooled packets the next datagrams are received into, the first `available` are set.
+    std::array<Network::Packet*, BATCH_SIZE> batch{};
+    size_t available = 0;
+
     while (_running) {
         try {
-            Network::Packet pkt{};
-            asio::ip::udp::endpoint sender_endpoint;
-            asio::error_code ec;
+            while (available < BATCH_SIZE) {
+                Network::Packet* pkt = _incomingPool.acquire();
+                if (!pkt)
+                    break;
+                batch[available++] = pkt;
+            }
+            if (available == 0) {
+                // Every packet is queued or being processed: sleep until the process thread releases some.
+                _incomingWaiter.notify();
+                _incomingPoolWaiter.wait([this]() { return !_incomingPool.empty() || !_running; });
+                continue;
+            }
 
-            size_t len = _socket.receive_from(asio::buffer(pkt.data), sender_endpoint, 0, ec);
+            size_t count = 0;
+            bool ok = _batchedIo ? receiveBatchNative(batch.data(), available, count) : receiveBatchAsio(batch.data(), count);
 
-            if (!_running) {
-                return;
+            if (!_running || !ok) {
+                break;
             }
-
-            if (ec) {
-                if (ec == asio::error::operation_aborted || ec == asio::error::bad_descriptor) {
-                    break;
-                }
-                std::cerr << "[UDP] Recv error: " << ec.message() << std::endl;
+            if (count == 0) {
                 continue;
             }
 
-            pkt.length = len;
-            pkt.addr = *reinterpret_cast<const sockaddr_in*>(sender_endpoint.data());
-            _incoming.push(pkt);
+            _recvBatches.record(count);
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+                bytes += batch[i]->length;
+            _bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+            size_t queued = _incoming.push_n(batch.data(), count);
+            if (queued < count)
+                _incomingDropped.fetch_add(count - queued, std::memory_order_relaxed);
+            _incomingWaiter.notify();
+
+            // Queued packets now belong to the process thread, the dropped ones are received into again.
+            if (queued > 0) {
+                std::copy(batch.begin() + queued, batch.begin() + available, batch.begin());
+                available -= queued;
+            }
 
         } catch (const std::exception& e) {
             if (_running) {
                 std::cerr << "[UDP] Exception: " << e.what() << std::endl;
             } else {
-                return;
+                break;
             }
         }
     }
+    for (size_t i = 0; i < available; ++i)
+        _incomingPool.release(batch[i]);
+}
+
+bool UDPServer::receiveBatchAsio(Network::Packet* const* batch, size_t& count)
+{
+    Network::Packet& pkt = *batch[0];
+    asio::ip::udp::endpoint sender_endpoint;
+    asio::error_code ec;
+
+    count = 0;
+    size_t len = _socket.receive_from(asio::buffer(pkt.data), sender_endpoint, 0, ec);
+
+    if (ec) {
+        if (ec == asio::error::operation_aborted || ec == asio::error::bad_descriptor) {
+            return false;
+        }
+        std::cerr << "[UDP] Recv error: " << ec.message() << std::endl;
+        return true;
+    }
+
+    pkt.length = len;
+    pkt.addr = *reinterpret_cast<const sockaddr_in*>(sender_endpoint.data());
+    count = 1;
+    return true;
+}
+
+bool UDPServer::receiveBatchNative(Network::Packet* const* batch, size_t available, size_t& count)
+{
+    count = 0;
+#ifdef RTYPE_HAS_MMSG
+    std::array<mmsghdr, BATCH_SIZE> msgs{};
+    std::array<iovec, BATCH_SIZE> iovs{};
+
+    available = std::min(available, BATCH_SIZE);
+    for (size_t i = 0; i < available; ++i) {
+        iovs[i].iov_base = batch[i]->data.data();
+        iovs[i].iov_len = batch[i]->data.size();
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &batch[i]->addr;
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int received = recvmmsg(_socket.native_handle(), msgs.data(), available, MSG_WAITFORONE, nullptr);
+    if (received < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+            return true;
+        }
+        if (errno == ENOSYS) {
+            std::cerr << "[UDP] recvmmsg unavailable, falling back to asio." << std::endl;
+            _batchedIo = false;
+            return true;
+        }
+        if (errno == EBADF || errno == ENOTSOCK) {
+            return false;
+        }
+        std::cerr << "[UDP] Recv error: " << std::strerror(errno) << std::endl;
+        return true;
+    }
+
+    for (int i = 0; i < received; ++i)
+        batch[i]->length = msgs[i].msg_len;
+    count = static_cast<size_t>(received);
+    return true;
+#else
+    (void)batch;
+    (void)available;
+    _batchedIo = false;
+    return true;
+#endif
 }
 
 void UDPServer::sendLoop()
 {
+    std::array<Network::Packet*, BATCH_SIZE> batch{};
+
     while (_running) {
-        if (_outgoing.isEmpty()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        size_t count = _outgoing.pop_n(batch.data(), batch.size());
+        if (count == 0) {
+            _outgoingWaiter.wait([this]() { return !_outgoing.isEmpty() || !_running; });
             continue;
         }
 
-        auto pktOpt = _outgoing.pop();
-        if (!pktOpt) continue;
-        const Network::Packet& pkt = *pktOpt;
+        for (size_t i = 0; i < count; ++i)
+            destinationDepth(batch[i]->addr).fetch_sub(1, std::memory_order_relaxed);
+        if (_evictRequests.load(std::memory_order_relaxed) != 0)
+            count = evictOldest(batch.data(), count);
+        if (count == 0)
+            continue;
+
+        _sendBatches.record(count);
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; ++i)
+            bytes += batch[i]->length;
+        _bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+        if (_batchedIo)
+            sendBatchNative(batch.data(), count);
+        else
+            sendBatchAsio(batch.data(), count);
+        for (size_t i = 0; i < count; ++i)
+            _outgoingPool.release(batch[i]);
+    }
+}
+
+void UDPServer::sendBatchAsio(Network::Packet* const* packets, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const Network::Packet& pkt = *packets[i];
 
         asio::ip::address_v4::bytes_type addr_bytes;
         std::memcpy(addr_bytes.data(), &pkt.addr.sin_addr.s_addr, 4);
@@ -139,14 +403,65 @@ void UDPServer::sendLoop()
     }
 }
 
+void UDPServer::sendBatchNative(Network::Packet* const* packets, size_t count)
+{
+#ifdef RTYPE_HAS_MMSG
+    std::array<mmsghdr, BATCH_SIZE> msgs{};
+    std::array<iovec, BATCH_SIZE> iovs{};
+
+    count = std::min(count, BATCH_SIZE);
+    for (size_t i = 0; i < count; ++i) {
+        iovs[i].iov_base = packets[i]->data.data();
+        iovs[i].iov_len = packets[i]->length;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &packets[i]->addr;
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    size_t sent = 0;
+    while (sent < count && _running) {
+        int result = sendmmsg(_socket.native_handle(), msgs.data() + sent, count - sent, 0);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENOSYS) {
+                std::cerr << "[UDP] sendmmsg unavailable, falling back to asio." << std::endl;
+                _batchedIo = false;
+                sendBatchAsio(packets + sent, count - sent);
+                return;
+            }
+            char ip[INET_ADDRSTRLEN] = {0};
+            inet_ntop(AF_INET, &packets[sent]->addr.sin_addr, ip, sizeof(ip));
+            std::cerr << "[UDP] Send error to " << ip << ":" << ntohs(packets[sent]->addr.sin_port) << " - " << std::strerror(errno) << std::endl;
+            // Skip the datagram that failed and keep sending the rest of the batch.
+            ++sent;
+            continue;
+        }
+        sent += static_cast<size_t>(result);
+    }
+#else
+    _batchedIo = false;
+    sendBatchAsio(packets, count);
+#endif
+}
+
 void UDPServer::processLoop()
 {
+    std::array<Network::Packet*, BATCH_SIZE> batch{};
+
     while (_running) {
-        if (_incoming.isEmpty())
+        size_t count = _incoming.pop_n(batch.data(), batch.size());
+        if (count == 0) {
+            _incomingWaiter.wait([this]() { return !_incoming.isEmpty() || !_running; });
             continue;
-        auto pktOpt = _incoming.pop();
+        }
 
-        handlePacket(pktOpt->data.data(), pktOpt->length, pktOpt->addr);
+        for (size_t i = 0; i < count; ++i) {
+            handlePacket(batch[i]->data.data(), batch[i]->length, batch[i]->addr);
+            _incomingPool.release(batch[i]);
+        }
+        _incomingPoolWaiter.notify();
     }
 }
 
@@ -160,12 +475,274 @@ void UDPServer::handlePacket(const char* data, size_t length, const sockaddr_in&
 void UDPServer::queueMessage(const char* data, size_t length, const sockaddr_in& clientAddr)
 {
     if (length > MAX_UDP_PACKET_SIZE) {
-        std::cerr << "Warning: UDP packet too large (" << length << " bytes), max is " << MAX_UDP_PACKET_SIZE << ". Truncating." << std::endl;
-        length = MAX_UDP_PACKET_SIZE;
-    }
-    Network::Packet pkt;
-    pkt.addr = clientAddr;
-    pkt.length = length;
-    std::memcpy(pkt.data.data(), data, length);
-    _outgoing.push(pkt);
+        queueFragmented(data, length, clientAddr);
+        return;
+    }
+    auto type = static_cast<uint8_t>(length > 0 ? data[0] : 0);
+    if (t_staging.owner == this) {
+        stageMessage(t_staging, data, length, clientAddr, [this, type]() { return acquireOutgoing(type); });
+        return;
+    }
+    Network::Packet* pkt = acquireOutgoing(type);
+    if (!pkt)
+        return;
+    pkt->addr = clientAddr;
+    pkt->length = length;
+    std::memcpy(pkt->data.data(), data, length);
+    _payloadCopies.fetch_add(1, std::memory_order_relaxed);
+    pushOutgoing(&pkt, 1);
+}
+
+void UDPServer::queueFragmented(const char* data, size_t length, const sockaddr_in& clientAddr)
+{
+    if (length > MAX_FRAGMENTED_MESSAGE_SIZE) {
+        std::cerr << "Warning: UDP message too large (" << length << " bytes), max is " << MAX_FRAGMENTED_MESSAGE_SIZE << ". Dropping." << std::endl;
+        return;
+    }
+
+    FragmentHeader header;
+    header.messageId = _nextFragmentedId.fetch_add(1, std::memory_order_relaxed);
+    header.totalSize = static_cast<uint16_t>(length);
+    header.fragmentCount = static_cast<uint8_t>((length + FRAGMENT_PAYLOAD_SIZE - 1) / FRAGMENT_PAYLOAD_SIZE);
+
+    // Fragments fill a whole datagram, so each is written straight into its own pooled packet.
+    // All of them are acquired first: a message missing a fragment cannot be reassembled.
+    std::array<Network::Packet*, MAX_FRAGMENT_COUNT> packets;
+    for (uint8_t i = 0; i < header.fragmentCount; ++i) {
+        packets[i] = acquireOutgoing(FRAGMENT);
+        if (!packets[i]) {
+            for (uint8_t j = 0; j < i; ++j)
+                _outgoingPool.release(packets[j]);
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < header.fragmentCount; ++i) {
+        Network::Packet* pkt = packets[i];
+        size_t offset = i * FRAGMENT_PAYLOAD_SIZE;
+        size_t payload = std::min(FRAGMENT_PAYLOAD_SIZE, length - offset);
+        header.fragmentIndex = i;
+        std::memcpy(pkt->data.data(), &header, sizeof(header));
+        std::memcpy(pkt->data.data() + sizeof(header), data + offset, payload);
+        pkt->length = sizeof(header) + payload;
+        pkt->addr = clientAddr;
+    }
+
+    if (t_staging.owner == this) {
+        // Sent after the messages already bundled for this destination, as they were queued first.
+        StagingBuffer& staging = t_staging;
+        auto it = staging.index.find(destinationKey(clientAddr));
+        if (it != staging.index.end())
+            closeBundle(staging, staging.destinations[it->second]);
+        staging.ready.insert(staging.ready.end(), packets.begin(), packets.begin() + header.fragmentCount);
+        staging.messages += header.fragmentCount;
+        staging.copies += header.fragmentCount;
+    } else {
+        _payloadCopies.fetch_add(header.fragmentCount, std::memory_order_relaxed);
+        pushOutgoing(packets.data(), header.fragmentCount);
+    }
+    _fragmentedMessages.fetch_add(1, std::memory_order_relaxed);
+    _fragments.fetch_add(header.fragmentCount, std::memory_order_relaxed);
+}
+
+void UDPServer::pushOutgoing(Network::Packet* const* packets, size_t count)
+{
+    // Below the pressure threshold no policy drops anything: push the whole batch with one CAS.
+    if (_outgoing.count() + count <= PRESSURE_THRESHOLD) {
+        for (size_t i = 0; i < count; ++i)
+            destinationDepth(packets[i]->addr).fetch_add(1, std::memory_order_relaxed);
+        size_t pushed = _outgoing.push_n(packets, count);
+        for (size_t i = pushed; i < count; ++i)
+            destinationDepth(packets[i]->addr).fetch_sub(1, std::memory_order_relaxed);
+        packets += pushed;
+        count -= pushed;
+    }
+    for (size_t i = 0; i < count; ++i)
+        enqueueOutgoing(packets[i]);
+    _outgoingWaiter.notify();
+}
+
+void UDPServer::enqueueOutgoing(Network::Packet* pkt)
+{
+    Network::MessagePriority priority = Network::packetPriority(*pkt);
+    std::atomic<int32_t>& depth = destinationDepth(pkt->addr);
+
+    if (priority != Network::MessagePriority::CRITICAL && !admitOutgoing(*pkt, priority)) {
+        recordDrop(*pkt);
+        _outgoingPool.release(pkt);
+        return;
+    }
+    depth.fetch_add(1, std::memory_order_relaxed);
+    if (_outgoing.push(pkt))
+        return;
+    if (priority == Network::MessagePriority::CRITICAL) {
+        // Never dropped while running: wait for the send thread to make room.
+        _criticalWaits.fetch_add(1, std::memory_order_relaxed);
+        while (_running) {
+            _outgoingWaiter.notify();
+            std::this_thread::yield();
+            if (_outgoing.push(pkt))
+                return;
+        }
+    }
+    depth.fetch_sub(1, std::memory_order_relaxed);
+    recordDrop(*pkt);
+    _outgoingPool.release(pkt);
+}
+
+Network::Packet* UDPServer::acquireOutgoing(uint8_t type)
+{
+    Network::Packet* pkt = _outgoingPool.acquire();
+    if (!pkt && t_staging.owner == this && !t_staging.ready.empty()) {
+        // This tick's finished bundles hold packets too: hand them to the send thread now.
+        pushStagedReady();
+        pkt = _outgoingPool.acquire();
+    }
+    if (!pkt && Network::messagePriority(type) == Network::MessagePriority::CRITICAL) {
+        // Never dropped while running: wait for the send thread to release packets.
+        _criticalWaits.fetch_add(1, std::memory_order_relaxed);
+        while (!pkt && _running) {
+            _outgoingWaiter.notify();
+            std::this_thread::yield();
+            pkt = _outgoingPool.acquire();
+        }
+    }
+    if (!pkt) {
+        _outgoingDropped.fetch_add(1, std::memory_order_relaxed);
+        _droppedByType[std::min<size_t>(type, Network::MESSAGE_TYPE_COUNT - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
+    return pkt;
+}
+
+bool UDPServer::admitOutgoing(const Network::Packet& pkt, Network::MessagePriority priority)
+{
+    Network::BackpressurePolicy policy = _policy.load(std::memory_order_relaxed);
+    size_t queued = _outgoing.count();
+    size_t limit = QUEUE_CAPACITY - CRITICAL_RESERVE;
+
+    if (queued < PRESSURE_THRESHOLD)
+        return true;
+    if (policy == Network::BackpressurePolicy::DROP_BY_PRIORITY && priority == Network::MessagePriority::LOW)
+        return false;
+    if (policy == Network::BackpressurePolicy::FAIR_SHARE) {
+        int32_t active = 0;
+        for (const auto& bucket : _destinationDepth)
+            active += bucket.load(std::memory_order_relaxed) > 0;
+        int32_t share = std::max(static_cast<int32_t>(limit) / std::max(active, 1), MIN_FAIR_SHARE);
+        if (destinationDepth(pkt.addr).load(std::memory_order_relaxed) >= share)
+            return false;
+    }
+    if (queued < limit)
+        return true;
+    if (policy == Network::BackpressurePolicy::DROP_OLDEST) {
+        // Takes a reserved slot for now, the send thread discards the oldest datagram to give it back.
+        _evictRequests.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+size_t UDPServer::evictOldest(Network::Packet** packets, size_t count)
+{
+    uint64_t debt = _evictRequests.exchange(0, std::memory_order_relaxed);
+    size_t kept = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (debt > 0 && Network::packetPriority(*packets[i]) != Network::MessagePriority::CRITICAL) {
+            recordDrop(*packets[i]);
+            _outgoingPool.release(packets[i]);
+            _evicted.fetch_add(1, std::memory_order_relaxed);
+            --debt;
+            continue;
+        }
+        if (kept != i)
+            packets[kept] = packets[i];
+        ++kept;
+    }
+    if (debt > 0 && !_outgoing.isEmpty())
+        _evictRequests.fetch_add(debt, std::memory_order_relaxed);
+    return kept;
+}
+
+void UDPServer::recordDrop(const Network::Packet& pkt)
+{
+    _outgoingDropped.fetch_add(1, std::memory_order_relaxed);
+    Network::forEachMessageType(pkt, [this](uint8_t type) {
+        _droppedByType[std::min<size_t>(type, Network::MESSAGE_TYPE_COUNT - 1)].fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+std::atomic<int32_t>& UDPServer::destinationDepth(const sockaddr_in& addr)
+{
+    static_assert(DESTINATION_BUCKETS == 256, "The hash keeps the top 8 bits");
+    // Fibonacci hashing, clients sharing a bucket share a fair share.
+    uint64_t hash = destinationKey(addr) * 0x9E3779B97F4A7C15ull;
+    return _destinationDepth[hash >> 56];
+}
+
+void UDPServer::setBackpressurePolicy(Network::BackpressurePolicy policy)
+{
+    _policy.store(policy, std::memory_order_relaxed);
+}
+
+Network::BackpressurePolicy UDPServer::getBackpressurePolicy() const
+{
+    return _policy.load(std::memory_order_relaxed);
+}
+
+void UDPServer::flushStaged()
+{
+    StagingBuffer& staging = t_staging;
+
+    for (size_t i = 0; i < staging.used; ++i)
+        closeBundle(staging, staging.destinations[i]);
+    pushStagedReady();
+
+    _coalescedMessages.fetch_add(staging.messages, std::memory_order_relaxed);
+    _payloadCopies.fetch_add(staging.copies, std::memory_order_relaxed);
+
+    staging.index.clear();
+    staging.used = 0;
+    staging.messages = 0;
+    staging.copies = 0;
+}
+
+void UDPServer::pushStagedReady()
+{
+    StagingBuffer& staging = t_staging;
+
+    if (staging.ready.empty())
+        return;
+    _coalescedDatagrams.fetch_add(staging.ready.size(), std::memory_order_relaxed);
+    pushOutgoing(staging.ready.data(), staging.ready.size());
+    staging.ready.clear();
+}
+
+UDPServerStats UDPServer::getStats() const
+{
+    UDPServerStats stats;
+    stats.process = _incomingWaiter.getStats();
+    stats.send = _outgoingWaiter.getStats();
+    stats.recv = _incomingPoolWaiter.getStats();
+    stats.recvBatches = _recvBatches.snapshot();
+    stats.sendBatches = _sendBatches.snapshot();
+    stats.batchedIo = _batchedIo;
+    stats.coalescedMessages = _coalescedMessages.load(std::memory_order_relaxed);
+    stats.coalescedDatagrams = _coalescedDatagrams.load(std::memory_order_relaxed);
+    stats.fragmentedMessages = _fragmentedMessages.load(std::memory_order_relaxed);
+    stats.fragments = _fragments.load(std::memory_order_relaxed);
+    stats.bytesReceived = _bytesReceived.load(std::memory_order_relaxed);
+    stats.bytesSent = _bytesSent.load(std::memory_order_relaxed);
+    stats.incomingDropped = _incomingDropped.load(std::memory_order_relaxed);
+    stats.outgoingDropped = _outgoingDropped.load(std::memory_order_relaxed);
+    stats.evicted = _evicted.load(std::memory_order_relaxed);
+    stats.criticalWaits = _criticalWaits.load(std::memory_order_relaxed);
+    stats.incomingPool = _incomingPool.getStats();
+    stats.outgoingPool = _outgoingPool.getStats();
+    stats.payloadCopies = _payloadCopies.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < Network::MESSAGE_TYPE_COUNT; ++i)
+        stats.droppedByType[i] = _droppedByType[i].load(std::memory_order_relaxed);
+    stats.policy = _policy.load(std::memory_order_relaxed);
+    stats.incomingDepth = _incoming.count();
+    stats.outgoingDepth = _outgoing.count();
+    return stats;
 }
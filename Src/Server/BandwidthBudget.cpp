@@ -0,0 +1,60 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** BandwidthBudget
+*/
+
+#include "Server/BandwidthBudget.hpp"
+#include <algorithm>
+
+void BandwidthBudget::refill(uint32_t kbps, float seconds)
+{
+    _kbps = kbps;
+    if (kbps != UNLIMITED) {
+        float bytesPerSecond = kbps * 125.0f;
+        _tokens = std::min(_tokens + bytesPerSecond * seconds, bytesPerSecond * BURST_SECONDS);
+    }
+
+    _windowSeconds += seconds;
+    if (_windowSeconds >= 1.0f) {
+        _usedKbps = static_cast<float>(_windowBytes) / 125.0f / _windowSeconds;
+        _windowBytes = 0;
+        _windowSeconds = 0.0f;
+    }
+}
+
+void BandwidthBudget::charge(size_t bytes)
+{
+    _bytes += bytes;
+    _windowBytes += bytes;
+    if (_kbps != UNLIMITED)
+        _tokens = std::max(_tokens - static_cast<float>(bytes), -(_kbps * 125.0f * DEBT_SECONDS));
+}
+
+bool BandwidthBudget::tryCharge(size_t bytes)
+{
+    if (_kbps != UNLIMITED && _tokens < static_cast<float>(bytes))
+        return false;
+    charge(bytes);
+    return true;
+}
+
+PriorityAccumulator::Entry& PriorityAccumulator::accumulate(uint32_t entityId, float relevance, uint32_t tick)
+{
+    Entry& entry = _entries[entityId];
+    entry.priority += relevance + MIN_GAIN;
+    entry.lastSeen = tick;
+    return entry;
+}
+
+void PriorityAccumulator::sent(Entry& entry)
+{
+    entry.priority = 0.0f;
+    entry.pending = false;
+}
+
+void PriorityAccumulator::prune(uint32_t tick)
+{
+    std::erase_if(_entries, [tick](const auto& item) { return item.second.lastSeen != tick; });
+}
@@ -0,0 +1,187 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** EntityKernels
+*/
+
+#include "Server/EntityKernels.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+    #include <emmintrin.h>
+    #define RTYPE_KERNELS_SSE2
+#endif
+
+// The AVX2 kernel is compiled with a target attribute, so the rest of the
+// binary keeps running on CPUs without AVX2.
+#if defined(RTYPE_KERNELS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define RTYPE_KERNELS_AVX2
+#endif
+
+namespace EntityKernels {
+
+static void clearMask(const IntegrationBatch& batch)
+{
+    std::fill(batch.destroyMask, batch.destroyMask + (batch.count + 63) / 64, 0);
+}
+
+/**
+ * @brief Scalar pass over [begin, count), used for the reference kernel and the SIMD tails.
+ */
+static size_t integrateRange(const IntegrationBatch& batch, size_t begin)
+{
+    size_t destroyed = 0;
+
+    for (size_t i = begin; i < batch.count; ++i) {
+        batch.x[i] += batch.velocityX[i] * batch.timeScale;
+        batch.y[i] += batch.velocityY[i] * batch.timeScale;
+    }
+    for (size_t i = begin; i < batch.count; ++i) {
+        if (batch.x[i] > batch.maxX || batch.x[i] < batch.minX || (batch.flags[i] & batch.destroyFlags)) {
+            batch.destroyMask[i >> 6] |= uint64_t{1} << (i & 63);
+            ++destroyed;
+        }
+    }
+    return destroyed;
+}
+
+size_t integrateScalar(const IntegrationBatch& batch)
+{
+    clearMask(batch);
+    return integrateRange(batch, 0);
+}
+
+#ifdef RTYPE_KERNELS_SSE2
+
+size_t integrateSse2(const IntegrationBatch& batch)
+{
+    clearMask(batch);
+
+    const __m128 timeScale = _mm_set1_ps(batch.timeScale);
+    const __m128 minX = _mm_set1_ps(batch.minX);
+    const __m128 maxX = _mm_set1_ps(batch.maxX);
+    const __m128i destroyFlags = _mm_set1_epi32(batch.destroyFlags);
+    const __m128i zero = _mm_setzero_si128();
+    size_t destroyed = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= batch.count; i += 4) {
+        __m128 x = _mm_add_ps(_mm_loadu_ps(batch.x + i), _mm_mul_ps(_mm_loadu_ps(batch.velocityX + i), timeScale));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(batch.y + i), _mm_mul_ps(_mm_loadu_ps(batch.velocityY + i), timeScale));
+        _mm_storeu_ps(batch.x + i, x);
+        _mm_storeu_ps(batch.y + i, y);
+
+        int32_t packedFlags;
+        std::memcpy(&packedFlags, batch.flags + i, sizeof(packedFlags));
+        __m128i flags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packedFlags), zero), zero);
+        __m128i flagged = _mm_cmpgt_epi32(_mm_and_si128(flags, destroyFlags), zero);
+
+        __m128 outside = _mm_or_ps(_mm_cmpgt_ps(x, maxX), _mm_cmplt_ps(x, minX));
+        uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(_mm_or_ps(outside, _mm_castsi128_ps(flagged))));
+        batch.destroyMask[i >> 6] |= bits << (i & 63);
+        destroyed += std::popcount(bits);
+    }
+    return destroyed + integrateRange(batch, i);
+}
+
+#else
+
+size_t integrateSse2(const IntegrationBatch& batch)
+{
+    return integrateScalar(batch);
+}
+
+#endif
+
+#ifdef RTYPE_KERNELS_AVX2
+
+__attribute__((target("avx2")))
+size_t integrateAvx2(const IntegrationBatch& batch)
+{
+    clearMask(batch);
+
+    const __m256 timeScale = _mm256_set1_ps(batch.timeScale);
+    const __m256 minX = _mm256_set1_ps(batch.minX);
+    const __m256 maxX = _mm256_set1_ps(batch.maxX);
+    const __m256i destroyFlags = _mm256_set1_epi32(batch.destroyFlags);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t destroyed = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= batch.count; i += 8) {
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(batch.x + i), _mm256_mul_ps(_mm256_loadu_ps(batch.velocityX + i), timeScale));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(batch.y + i), _mm256_mul_ps(_mm256_loadu_ps(batch.velocityY + i), timeScale));
+        _mm256_storeu_ps(batch.x + i, x);
+        _mm256_storeu_ps(batch.y + i, y);
+
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(batch.flags + i)));
+        __m256i flagged = _mm256_cmpgt_epi32(_mm256_and_si256(flags, destroyFlags), zero);
+
+        __m256 outside = _mm256_or_ps(_mm256_cmp_ps(x, maxX, _CMP_GT_OQ), _mm256_cmp_ps(x, minX, _CMP_LT_OQ));
+        uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_or_ps(outside, _mm256_castsi256_ps(flagged))));
+        batch.destroyMask[i >> 6] |= bits << (i & 63);
+        destroyed += std::popcount(bits);
+    }
+    return destroyed + integrateRange(batch, i);
+}
+
+bool hasAvx2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+size_t integrateAvx2(const IntegrationBatch& batch)
+{
+    return integrateSse2(batch);
+}
+
+bool hasAvx2()
+{
+    return false;
+}
+
+#endif
+
+/**
+ * @struct Dispatch
+ * @brief Kernel picked for this CPU.
+ */
+struct Dispatch {
+    IntegrateFunction function;
+    const char* backend;
+};
+
+static Dispatch selectIntegrate()
+{
+    if (hasAvx2())
+        return {integrateAvx2, "avx2"};
+#ifdef RTYPE_KERNELS_SSE2
+    return {integrateSse2, "sse2"};
+#else
+    return {integrateScalar, "scalar"};
+#endif
+}
+
+static const Dispatch& dispatch()
+{
+    static const Dispatch selected = selectIntegrate();
+    return selected;
+}
+
+size_t integrate(const IntegrationBatch& batch)
+{
+    return dispatch().function(batch);
+}
+
+const char* integrateBackend()
+{
+    return dispatch().backend;
+}
+
+}
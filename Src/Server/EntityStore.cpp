@@ -0,0 +1,105 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** EntityStore
+*/
+
+#include "Server/EntityStore.hpp"
+
+void EntityStore::setIndex(uint32_t id, uint32_t index)
+{
+    size_t page = id / PAGE_SIZE;
+
+    if (page >= _sparse.size()) {
+        _sparse.resize(page + 1);
+        _pageLive.resize(page + 1, 0);
+    }
+    if (!_sparse[page]) {
+        _sparse[page] = std::make_unique<Page>();
+        _sparse[page]->fill(INVALID_INDEX);
+    }
+    (*_sparse[page])[id % PAGE_SIZE] = index;
+}
+
+uint32_t EntityStore::add(const Entity& entity)
+{
+    uint32_t index = static_cast<uint32_t>(_id.size());
+
+    _id.push_back(entity.id);
+    _type.push_back(entity.type);
+    _x.push_back(entity.x);
+    _y.push_back(entity.y);
+    _velocityX.push_back(entity.velocityX);
+    _velocityY.push_back(entity.velocityY);
+    _width.push_back(entity.width);
+    _height.push_back(entity.height);
+    _flags.push_back(entity.is_collide ? COLLIDED : 0);
+
+    setIndex(entity.id, index);
+    ++_pageLive[entity.id / PAGE_SIZE];
+    return index;
+}
+
+void EntityStore::remove(uint32_t index)
+{
+    uint32_t removedId = _id[index];
+    uint32_t last = static_cast<uint32_t>(_id.size() - 1);
+
+    if (index != last) {
+        _id[index] = _id[last];
+        _type[index] = _type[last];
+        _x[index] = _x[last];
+        _y[index] = _y[last];
+        _velocityX[index] = _velocityX[last];
+        _velocityY[index] = _velocityY[last];
+        _width[index] = _width[last];
+        _height[index] = _height[last];
+        _flags[index] = _flags[last];
+        setIndex(_id[index], index);
+    }
+    _id.pop_back();
+    _type.pop_back();
+    _x.pop_back();
+    _y.pop_back();
+    _velocityX.pop_back();
+    _velocityY.pop_back();
+    _width.pop_back();
+    _height.pop_back();
+    _flags.pop_back();
+
+    size_t page = removedId / PAGE_SIZE;
+    (*_sparse[page])[removedId % PAGE_SIZE] = INVALID_INDEX;
+    if (--_pageLive[page] == 0)
+        _sparse[page].reset();
+}
+
+uint32_t EntityStore::indexOf(uint32_t id) const
+{
+    size_t page = id / PAGE_SIZE;
+
+    if (page >= _sparse.size() || !_sparse[page])
+        return INVALID_INDEX;
+    return (*_sparse[page])[id % PAGE_SIZE];
+}
+
+Entity EntityStore::get(uint32_t index) const
+{
+    return {_id[index], _type[index], _x[index], _y[index], _velocityX[index], _velocityY[index],
+            _height[index], _width[index], (_flags[index] & COLLIDED) != 0};
+}
+
+void EntityStore::clear()
+{
+    _id.clear();
+    _type.clear();
+    _x.clear();
+    _y.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _width.clear();
+    _height.clear();
+    _flags.clear();
+    _sparse.clear();
+    _pageLive.clear();
+}
@@ -8,25 +8,89 @@
 
 #include "Server/Game.hpp"
 #include "Network/UDP/UDPServer.hpp"
+#include "Server/EntityKernels.hpp"
+#include "Network/PackedUpdate.hpp"
+#include <array>
+#include <bit>
 #include <cmath>
-#include <unordered_map>
 
-// Static maps to hold Boss state per Game instance since we cannot modify Game.hpp
-static std::unordered_map<Game*, int> g_bossHP;
-static std::unordered_map<Game*, int> g_bossLevel; // 0: None, 1: Boss1, 2: Cooldown, 3: Boss2, 4: Victory
-static std::unordered_map<Game*, float> g_lastBossShootTime;
-static std::unordered_map<Game*, float> g_bossDeathTime;
-
-void Game::addPlayer(uint32_t playerId, const char* username) {
+void Game::addPlayer(uint32_t playerId, const char* username, uint8_t protocolVersion) {
     std::lock_guard<std::mutex> lock(_playersMutex);
     Player newPlayer{ .id = playerId };
+    newPlayer.protocolVersion = protocolVersion;
     strncpy(newPlayer.username, username, sizeof(newPlayer.username) - 1);
     _players.push_back(newPlayer);
 }
 
+bool Game::queueInput(const PlayerInputPacket& pkt)
+{
+    if (_inputQueue.push(pkt))
+        return true;
+    _droppedInputs.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Game::applyQueuedInputs(UDPServer& udpServer)
+{
+    // Only what was queued before the tick started, so a flooding client cannot stall it.
+    size_t remaining = _inputQueue.count();
+
+    while (remaining > 0) {
+        size_t popped = _inputQueue.pop_n(_inputBatch.data(), std::min(remaining, _inputBatch.size()));
+        if (popped == 0)
+            break;
+        for (size_t i = 0; i < popped; ++i)
+            handlePlayerInput(_inputBatch[i], udpServer);
+        remaining -= popped;
+    }
+}
+
+void Game::queueDisconnect(uint32_t playerId)
+{
+    std::lock_guard<std::mutex> lock(_commandsMutex);
+    _commands.push_back({RoomCommandType::DISCONNECT, playerId});
+}
+
+void Game::queueKick(uint32_t playerId)
+{
+    std::lock_guard<std::mutex> lock(_commandsMutex);
+    _commands.push_back({RoomCommandType::KICK, playerId});
+}
+
+void Game::releasePlayer(uint32_t playerId)
+{
+    std::lock_guard<std::mutex> lock(_commandsMutex);
+    _released.push_back(playerId);
+}
+
+void Game::takeReleasedPlayers(std::vector<uint32_t>& playerIds)
+{
+    std::lock_guard<std::mutex> lock(_commandsMutex);
+    playerIds.insert(playerIds.end(), _released.begin(), _released.end());
+    _released.clear();
+}
+
+size_t Game::applyQueuedCommands(UDPServer& udpServer)
+{
+    {
+        std::lock_guard<std::mutex> lock(_commandsMutex);
+        _commandBatch.swap(_commands);
+    }
+    size_t removed = 0;
+    for (const RoomCommand& command : _commandBatch) {
+        if (command.type == RoomCommandType::KICK)
+            removed += kickPlayer(command.playerId, udpServer);
+        else
+            removed += disconnectPlayer(command.playerId, udpServer);
+    }
+    _commandBatch.clear();
+    return removed;
+}
+
 void Game::handlePlayerInput(const PlayerInputPacket& pkt, UDPServer& udpServer)
 {
-    Player* player = getPlayer(pkt.playerId);
+    std::unique_lock<std::mutex> lock(_playersMutex);
+    Player* player = findPlayer(pkt.playerId);
     if (!player) {
         return;
     }
@@ -49,12 +113,16 @@ void Game::handlePlayerInput(const PlayerInputPacket& pkt, UDPServer& udpServer)
     // else: paquet arrivé en désordre ou dupliqué, on l'ignore pour les stats pour l'instant.
 
     // --- Logique de traitement de l'input (déplacée ici) ---
-    setPlayerLastProcessedTick(pkt.playerId, pkt.tick);
+    if (pkt.tick > player->lastProcessedTick)
+        player->lastProcessedTick = pkt.tick;
 
     if (pkt.inputs & UP) player->y -= player->velocity;
     if (pkt.inputs & DOWN) player->y += player->velocity;
     if (pkt.inputs & LEFT) player->x -= player->velocity;
     if (pkt.inputs & RIGHT) player->x += player->velocity;
+
+    // The shots take _entitiesMutex before _playersMutex and look the player up again.
+    lock.unlock();
     if (pkt.inputs & PRESSED) createPlayerShot(pkt.playerId, udpServer);
     if (pkt.inputs & HOLD) createPlayerChargedShot(pkt.playerId, udpServer);
 }
@@ -72,9 +140,9 @@ void Game::broadcastGameState(UDPServer& udpServer) {
         statePkt.x = player.x;
         statePkt.y = player.y;
 
-        for (const auto& destPlayer : _players) {
+        for (auto& destPlayer : _players) {
             if (!destPlayer.addrSet) continue;
-            udpServer.queueMessage(statePkt, destPlayer.udpAddr);
+            sendTo(destPlayer, statePkt, udpServer);
         }
     }
 }
@@ -95,17 +163,13 @@ void Game::updatePlayerUdpAddr(uint32_t playerId, const sockaddr_in& udpAddr) {
 
 void Game::setPlayerLastProcessedTick(uint32_t playerId, uint32_t tick) {
     std::lock_guard<std::mutex> lock(_playersMutex);
-    for (auto& player : _players) {
-        if (player.id == playerId) {
-            if (tick > player.lastProcessedTick)
-                player.lastProcessedTick = tick;
-            return;
-        }
+    if (Player* player = findPlayer(playerId)) {
+        if (tick > player->lastProcessedTick)
+            player->lastProcessedTick = tick;
     }
 }
 
-Player* Game::getPlayer(uint32_t playerId) {
-    std::lock_guard<std::mutex> lock(_playersMutex);
+Player* Game::findPlayer(uint32_t playerId) {
     for (auto& player : _players) {
         if (player.id == playerId) {
             return &player;
@@ -114,22 +178,23 @@ Player* Game::getPlayer(uint32_t playerId) {
     return nullptr;
 }
 
-const Player* Game::getPlayer(uint32_t playerId) const {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(_playersMutex));
-    for (const auto& player : _players) {
-        if (player.id == playerId) {
-            return &player;
-        }
-    }
-    return nullptr;
-}
-
 int Game::getPlayerCount()
 {
     std::lock_guard<std::mutex> lock(_playersMutex);
     return _players.size();
 }
 
+void Game::getInputCounters(uint64_t& received, uint64_t& lost)
+{
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    received = 0;
+    lost = 0;
+    for (const auto& player : _players) {
+        received += player.receivedInputs;
+        lost += player.lostInputs;
+    }
+}
+
 GameStatus Game::getStatus() const
 {
     return _status;
@@ -146,20 +211,26 @@ uint32_t Game::getHostId() const
     return _players.empty() ? 0 : _players.front().id;
 }
 
-const std::vector<Player>& Game::getPlayers() const
+std::vector<std::pair<uint32_t, std::string>> Game::getPlayerNames()
 {
-    return _players;
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    std::vector<std::pair<uint32_t, std::string>> names;
+    for (const auto& player : _players) {
+        names.push_back({player.id, player.username});
+    }
+    return names;
 }
 
 void Game::createPlayerShot(uint32_t playerId, UDPServer& udpServer) {
-    Player* player = getPlayer(playerId);
+    std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
+    std::lock_guard<std::mutex> lock_players(_playersMutex);
+    const Player* player = findPlayer(playerId);
 
     if (!player)
         return;
 
-    std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
     uint32_t entityId = _nextEntityId++;
-    _entities.push_back({entityId, 1, player->x + 25, player->y, 10.0f, 0.0f, 10, 5});
+    _entities.add({entityId, 1, player->x + 25, player->y, 10.0f, 0.0f, 10, 5});
 
     EntitySpawnPacket spawnPkt;
     spawnPkt.entityId = entityId;
@@ -167,23 +238,23 @@ void Game::createPlayerShot(uint32_t playerId, UDPServer& udpServer) {
     spawnPkt.x = player->x + 25;
     spawnPkt.y = player->y;
 
-    std::lock_guard<std::mutex> lock_players(_playersMutex);
-    for (const auto& destPlayer : _players) {
+    for (auto& destPlayer : _players) {
         if (destPlayer.addrSet) {
-            udpServer.queueMessage(spawnPkt, destPlayer.udpAddr);
+            sendReliable(destPlayer, spawnPkt, udpServer);
         }
     }
 }
 
 void Game::createPlayerChargedShot(uint32_t playerId, UDPServer& udpServer) {
-    Player* player = getPlayer(playerId);
+    std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
+    std::lock_guard<std::mutex> lock_players(_playersMutex);
+    const Player* player = findPlayer(playerId);
 
     if (!player)
         return;
 
-    std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
     uint32_t entityId = _nextEntityId++;
-    _entities.push_back({entityId, 4, player->x + 25, player->y, 12.0f, 0.0f, 29, 30});
+    _entities.add({entityId, 4, player->x + 25, player->y, 12.0f, 0.0f, 29, 30});
 
     EntitySpawnPacket spawnPkt;
     spawnPkt.entityId = entityId;
@@ -191,10 +262,9 @@ void Game::createPlayerChargedShot(uint32_t playerId, UDPServer& udpServer) {
     spawnPkt.x = player->x + 25;
     spawnPkt.y = player->y;
 
-    std::lock_guard<std::mutex> lock_players(_playersMutex);
-    for (const auto& destPlayer : _players) {
+    for (auto& destPlayer : _players) {
         if (destPlayer.addrSet) {
-            udpServer.queueMessage(spawnPkt, destPlayer.udpAddr);
+            sendReliable(destPlayer, spawnPkt, udpServer);
         }
     }
 }
@@ -218,7 +288,7 @@ void Game::createEnemy(UDPServer& udpServer) {
         height = 40;
     }
 
-    _entities.push_back({entityId, type, spawnX, spawnY, speed, 0.0f, width, height});
+    _entities.add({entityId, type, spawnX, spawnY, speed, 0.0f, width, height});
 
     EntitySpawnPacket spawnPkt;
     spawnPkt.entityId = entityId;
@@ -227,67 +297,223 @@ void Game::createEnemy(UDPServer& udpServer) {
     spawnPkt.y = spawnY;
 
     std::lock_guard<std::mutex> lock_players(_playersMutex);
-    for (const auto& destPlayer : _players) {
+    for (auto& destPlayer : _players) {
         if (destPlayer.addrSet) {
-            udpServer.queueMessage(spawnPkt, destPlayer.udpAddr);
+            sendReliable(destPlayer, spawnPkt, udpServer);
         }
     }
 }
 
-void Game::updateEntities(UDPServer& udpServer) {
+void Game::updateEntities(UDPServer& udpServer, float deltaTime) {
     std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
-    std::vector<uint32_t> destroyedEntities;
+    std::lock_guard<std::mutex> lock_players(_playersMutex);
+
+    size_t count = _entities.size();
+    size_t words = (count + 63) / 64;
+    _destroyMask.resize(words);
+
+    IntegrationBatch batch;
+    batch.x = _entities.x();
+    batch.y = _entities.y();
+    batch.velocityX = _entities.velocityX();
+    batch.velocityY = _entities.velocityY();
+    batch.flags = _entities.flags();
+    batch.count = count;
+    batch.timeScale = deltaTime * REFERENCE_TICK_RATE;
+    batch.minX = -20.0f;
+    batch.maxX = 1920.0f;
+    batch.destroyFlags = EntityStore::COLLIDED;
+    batch.destroyMask = _destroyMask.data();
+    size_t destroyed = EntityKernels::integrate(batch);
+
+    _aliveIndices.clear();
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t alive = ~_destroyMask[w];
+        if (w == words - 1 && count % 64 != 0)
+            alive &= (uint64_t{1} << (count % 64)) - 1;
+        for (; alive != 0; alive &= alive - 1)
+            _aliveIndices.push_back(static_cast<uint32_t>(w * 64 + std::countr_zero(alive)));
+    }
 
-    for (auto it = _entities.begin(); it != _entities.end(); ) {
-        auto& entity = *it;
-        entity.x += entity.velocityX;
-        entity.y += entity.velocityY;
+    uint32_t kbps = _budgetKbps.load(std::memory_order_relaxed);
+    for (auto& destPlayer : _players) {
+        if (destPlayer.addrSet) {
+            destPlayer.budget.refill(kbps, deltaTime);
+            replicateEntities(destPlayer, udpServer);
+        }
+    }
+
+    if (destroyed == 0)
+        return;
+    const uint32_t* ids = _entities.id();
+    // Highest index first: swap-and-pop then only ever moves a surviving entity.
+    for (size_t w = words; w-- > 0; ) {
+        for (uint64_t dead = _destroyMask[w]; dead != 0; ) {
+            int bit = 63 - std::countl_zero(dead);
+            dead &= ~(uint64_t{1} << bit);
+            uint32_t i = static_cast<uint32_t>(w * 64 + bit);
 
-        if (entity.x > 1920 || entity.x < -20 || entity.is_collide) {
-            destroyedEntities.push_back(entity.id);
             EntityDestroyPacket destroyPkt;
-            destroyPkt.entityId = entity.id;
-            for (const auto& destPlayer : _players) {
+            destroyPkt.entityId = ids[i];
+            for (auto& destPlayer : _players) {
                 if (destPlayer.addrSet)
-                    udpServer.queueMessage(destroyPkt, destPlayer.udpAddr);
+                    sendReliable(destPlayer, destroyPkt, udpServer);
             }
-            it = _entities.erase(it);
+            _entities.remove(i);
+        }
+    }
+}
+
+void Game::replicateEntities(Player& destPlayer, UDPServer& udpServer) {
+    const uint32_t* ids = _entities.id();
+    const uint16_t* types = _entities.type();
+    const float* x = _entities.x();
+    const float* y = _entities.y();
+    const float* velocityX = _entities.velocityX();
+    const float* velocityY = _entities.velocityY();
+    const int* width = _entities.width();
+    const int* height = _entities.height();
+
+    _replicationQueue.clear();
+    for (uint32_t i : _aliveIndices) {
+        ReplicatedEntity entity{ids[i], types[i], x[i], y[i], velocityX[i], velocityY[i], width[i], height[i]};
+        float score = InterestManager::relevance(entity, destPlayer.x, destPlayer.y);
+        RelevanceTier tier = InterestManager::tierOf(score);
+        PriorityAccumulator::Entry& entry = destPlayer.priorities.accumulate(ids[i], score, _tick);
+
+        if (!entry.pending && !InterestManager::isDue(tier, ids[i], _tick)) {
+            _interest.record(tier, ReplicationOutcome::DEFERRED);
+            continue;
+        }
+        entry.pending = true;
+        entry.tier = tier;
+        _replicationQueue.push_back({&entry, i});
+    }
+
+    // Most starved first, the budget runs out on the least urgent updates.
+    std::sort(_replicationQueue.begin(), _replicationQueue.end(), [](const ReplicationCandidate& a, const ReplicationCandidate& b) {
+        return a.entry->priority > b.entry->priority;
+    });
+    bool packed = destPlayer.protocolVersion >= PROTOCOL_VERSION_PACKED;
+    Network::PackedUpdateSizer packedSize(PACKED_UPDATE_CAPACITY);
+    _packedUpdates.clear();
+    for (const ReplicationCandidate& candidate : _replicationQueue) {
+        // A packed entry costs the whole bytes it adds, plus the header of each message the updates are split into.
+        size_t cost = packed ? packedSize.cost(ids[candidate.index]) : sizeof(EntityUpdatePacket);
+        if (!destPlayer.budget.tryCharge(cost)) {
+            destPlayer.budget.recordThrottled();
+            _interest.record(candidate.entry->tier, ReplicationOutcome::THROTTLED);
+            continue;
+        }
+        EntityUpdatePacket updatePkt;
+        updatePkt.entityId = ids[candidate.index];
+        updatePkt.x = x[candidate.index];
+        updatePkt.y = y[candidate.index];
+        if (packed) {
+            _packedUpdates.push_back(updatePkt);
+            packedSize.add(updatePkt.entityId);
         } else {
-            EntityUpdatePacket updatePkt;
-            updatePkt.entityId = entity.id;
-            updatePkt.x = entity.x;
-            updatePkt.y = entity.y;
+            udpServer.queueMessage(updatePkt, destPlayer.udpAddr);
+        }
+        PriorityAccumulator::sent(*candidate.entry);
+        _interest.record(candidate.entry->tier, ReplicationOutcome::SENT);
+    }
 
-            std::lock_guard<std::mutex> lock_players(_playersMutex);
-            for (const auto& destPlayer : _players) {
-                if (destPlayer.addrSet) {
-                    udpServer.queueMessage(updatePkt, destPlayer.udpAddr);
-                }
-            }
-            ++it;
+    std::array<char, PACKED_UPDATE_CAPACITY> packetBuffer;
+    for (size_t offset = 0; offset < _packedUpdates.size(); ) {
+        size_t encoded = 0;
+        size_t length = Network::encodeEntityUpdates(_packedUpdates.data() + offset, _packedUpdates.size() - offset,
+            packetBuffer.data(), packetBuffer.size(), encoded);
+        if (encoded == 0)
+            break;
+        udpServer.queueMessage(packetBuffer.data(), length, destPlayer.udpAddr);
+        offset += encoded;
+    }
+
+    if (_tick % PRIORITY_PRUNE_INTERVAL == 0)
+        destPlayer.priorities.prune(_tick);
+}
+
+void Game::sendTo(Player& destPlayer, const char* data, size_t length, UDPServer& udpServer) {
+    destPlayer.budget.charge(length);
+    udpServer.queueMessage(data, length, destPlayer.udpAddr);
+}
+
+void Game::sendReliable(Player& destPlayer, const char* data, size_t length, UDPServer& udpServer) {
+    if (destPlayer.protocolVersion >= PROTOCOL_VERSION_RELIABLE) {
+        auto transmit = [&](const char* message, size_t size) { sendTo(destPlayer, message, size, udpServer); };
+        if (destPlayer.reliable.send(data, length, Network::ReliableSender::Clock::now(), transmit))
+            return;
+    }
+    sendTo(destPlayer, data, length, udpServer);
+}
+
+void Game::resendReliable(UDPServer& udpServer) {
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    auto now = Network::ReliableSender::Clock::now();
+    for (auto& destPlayer : _players) {
+        if (!destPlayer.addrSet || destPlayer.protocolVersion < PROTOCOL_VERSION_RELIABLE)
+            continue;
+        destPlayer.reliable.resend(now, [&](const char* message, size_t size) {
+            sendTo(destPlayer, message, size, udpServer);
+        });
+    }
+    for (auto it = _departing.begin(); it != _departing.end(); ) {
+        if (it->reliable.idle() || now >= it->deadline) {
+            releasePlayer(it->playerId);
+            it = _departing.erase(it);
+            continue;
         }
+        it->reliable.resend(now, [&](const char* message, size_t size) {
+            udpServer.queueMessage(message, size, it->udpAddr);
+        });
+        ++it;
+    }
+}
+
+void Game::setBandwidthBudget(uint32_t kbps) {
+    _budgetKbps.store(kbps, std::memory_order_relaxed);
+}
+
+std::vector<ClientBandwidth> Game::getBandwidthUsage() {
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    std::vector<ClientBandwidth> usage;
+    for (const auto& player : _players) {
+        usage.push_back({player.id, player.budget.getKbps(), player.budget.getUsedKbps(),
+                         player.budget.getBytes(), player.budget.getThrottled()});
     }
+    return usage;
 }
 
 void Game::updateGameLevel(float elapsedTime) {
     _gameTime += elapsedTime;
 
     std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
-    for (auto& entity : _entities) {
-        if (_gameTime > 60.0f && (entity.type == 2 || entity.type == 3)) {
-            entity.velocityY = 5.0f * std::sin(_gameTime * 2.0f + entity.id);
+    size_t count = _entities.size();
+    const uint32_t* ids = _entities.id();
+    const uint16_t* types = _entities.type();
+    const float* x = _entities.x();
+    float* velocityX = _entities.velocityX();
+    float* velocityY = _entities.velocityY();
+
+    if (_gameTime > 60.0f) {
+        for (size_t i = 0; i < count; ++i) {
+            if (types[i] == 2 || types[i] == 3)
+                velocityY[i] = 5.0f * std::sin(_gameTime * 2.0f + ids[i]);
         }
-        if (entity.type == 10) { // Boss movement
-            if (entity.x > 1500) {
-                entity.velocityX = -2.0f;
-                entity.velocityY = 0.0f;
-            } else {
-                entity.velocityX = 0.0f;
-                    if (g_bossLevel[this] == 3) { // Boss Level 2 (Faster)
-                        entity.velocityY = 8.0f * std::sin(_gameTime * 4.0f);
-                    } else { // Boss Level 1
-                        entity.velocityY = 3.0f * std::sin(_gameTime);
-                    }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (types[i] != 10) // Boss movement
+            continue;
+        if (x[i] > 1500) {
+            velocityX[i] = -2.0f;
+            velocityY[i] = 0.0f;
+        } else {
+            velocityX[i] = 0.0f;
+            if (_bossLevel == 3) { // Boss Level 2 (Faster)
+                velocityY[i] = 8.0f * std::sin(_gameTime * 4.0f);
+            } else { // Boss Level 1
+                velocityY[i] = 3.0f * std::sin(_gameTime);
             }
         }
     }
@@ -296,56 +522,139 @@ void Game::updateGameLevel(float elapsedTime) {
 void Game::sendGlobalStateSync(UDPServer& udpServer) {
     std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
 
-    size_t totalPacketSize = sizeof(GlobalStateSyncPacket) + (_entities.size() * sizeof(SyncedEntityState));
-
-    if (totalPacketSize > MAX_UDP_PACKET_SIZE) {
-        std::cerr << "Warning: Global state sync packet size (" << totalPacketSize
-                  << ") exceeds MAX_UDP_PACKET_SIZE (" << MAX_UDP_PACKET_SIZE
-                  << "). Fragmentation or reduction of data sent per packet is required." << std::endl;
+    _snapshotEntities.clear();
+    for (uint32_t i = 0; i < _entities.size(); ++i) {
+        _snapshotEntities.push_back({_entities.id()[i], _entities.type()[i], _entities.x()[i], _entities.y()[i]});
     }
+    std::sort(_snapshotEntities.begin(), _snapshotEntities.end(), [](const SyncedEntityState& a, const SyncedEntityState& b) {
+        return a.entityId < b.entityId;
+    });
 
-    std::vector<char> packetBuffer(totalPacketSize);
-    GlobalStateSyncPacket header;
-    header.entityCount = _entities.size();
+    uint32_t snapshotId = _nextSnapshotId++;
+    std::array<char, MAX_SNAPSHOT_SIZE> packetBuffer;
 
-    std::memcpy(packetBuffer.data(), &header, sizeof(GlobalStateSyncPacket));
+    std::lock_guard<std::mutex> lock_players(_playersMutex);
+    for (auto& destPlayer : _players) {
+        if (!destPlayer.addrSet) continue;
+
+        const Network::SnapshotRecord* baseline = destPlayer.snapshots.baselineFor(snapshotId);
+        if (destPlayer.protocolVersion >= PROTOCOL_VERSION_RELIABLE && baseline && snapshotId % RELIABLE_SYNC_DIVIDER != 0)
+            continue;
+        Network::SnapshotRecord& record = destPlayer.snapshots.push(snapshotId);
+        auto encode = destPlayer.protocolVersion >= PROTOCOL_VERSION_PACKED ? Network::encodeSnapshotPacked : Network::encodeSnapshot;
+        size_t length = encode(snapshotId, baseline, _snapshotEntities, packetBuffer.data(), packetBuffer.size(), record.entities);
+        sendTo(destPlayer, packetBuffer.data(), length, udpServer);
+    }
+}
+
+void Game::acknowledgeSnapshot(uint32_t playerId, uint32_t snapshotId) {
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    for (auto& player : _players) {
+        if (player.id == playerId) {
+            player.snapshots.acknowledge(snapshotId);
+            return;
+        }
+    }
+}
 
-    size_t offset = sizeof(GlobalStateSyncPacket);
-    for (const auto& entity : _entities) {
-        SyncedEntityState state = {entity.id, entity.type, entity.x, entity.y};
-        std::memcpy(packetBuffer.data() + offset, &state, sizeof(SyncedEntityState));
-        offset += sizeof(SyncedEntityState);
+void Game::acknowledgeReliable(uint32_t playerId, uint16_t ack, uint32_t ackBits) {
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    for (auto& player : _players) {
+        if (player.id == playerId) {
+            player.reliable.acknowledge(ack, ackBits, Network::ReliableSender::Clock::now());
+            return;
+        }
+    }
+    for (auto& channel : _departing) {
+        if (channel.playerId == playerId) {
+            channel.reliable.acknowledge(ack, ackBits, Network::ReliableSender::Clock::now());
+            return;
+        }
     }
+}
 
-    std::lock_guard<std::mutex> lock_players(_playersMutex);
-    for (const auto& destPlayer : _players) {
-        if (destPlayer.addrSet) {
-            udpServer.queueMessage(packetBuffer.data(), packetBuffer.size(), destPlayer.udpAddr);
+void Game::getReliableCounters(Network::ReliableStats& total) {
+    std::lock_guard<std::mutex> lock(_playersMutex);
+    total = {};
+    size_t sampled = 0;
+    for (const auto& player : _players) {
+        Network::ReliableStats stats = player.reliable.getStats();
+        total.sent += stats.sent;
+        total.retransmits += stats.retransmits;
+        total.acked += stats.acked;
+        total.overflows += stats.overflows;
+        total.pending += stats.pending;
+        if (stats.rttMs > 0.0f) {
+            total.rttMs += stats.rttMs;
+            total.rtoMs += stats.rtoMs;
+            ++sampled;
         }
     }
+    if (sampled > 0) {
+        total.rttMs /= sampled;
+        total.rtoMs /= sampled;
+    }
 }
 
-void Game::update(UDPServer& udpServer) {
+void Game::update(UDPServer& udpServer, float deltaTime) {
+    TickProfiler::Clock::time_point tickStart = TickProfiler::Clock::now();
+    applyQueuedInputs(udpServer);
+    if (applyQueuedCommands(udpServer) > 0)
+        _departed.store(true, std::memory_order_release);
     if (_status != GameStatus::PLAYING)
         return;
+    _profiler.record(TickPhase::INPUTS, tickStart);
+    ScopedPhaseTimer tickTimer(_profiler, TickPhase::TICK, tickStart);
+    ++_tick;
+
+    {
+        ScopedPhaseTimer timer(_profiler, TickPhase::ENTITIES);
+        updateEntities(udpServer, deltaTime);
+    }
+    {
+        ScopedPhaseTimer timer(_profiler, TickPhase::COLLISIONS);
+        handleCollision(udpServer);
+    }
+    {
+        ScopedPhaseTimer timer(_profiler, TickPhase::BROADCAST);
+        broadcastGameState(udpServer);
+        resendReliable(udpServer);
+    }
+    {
+        ScopedPhaseTimer timer(_profiler, TickPhase::LEVEL);
+        updateGameLevel(deltaTime);
+    }
+    {
+        ScopedPhaseTimer timer(_profiler, TickPhase::BOSS);
+        updateBoss(udpServer);
+    }
+
+    if (std::chrono::steady_clock::now() - _lastEnemySpawnTime > std::chrono::seconds(2)) {
+        ScopedPhaseTimer timer(_profiler, TickPhase::SPAWN);
+        createEnemy(udpServer);
+        _lastEnemySpawnTime = std::chrono::steady_clock::now();
+    }
 
-    updateEntities(udpServer);
-    handleCollision(udpServer);
-    broadcastGameState(udpServer);
-    updateGameLevel(0.016f);
+    if (std::chrono::steady_clock::now() - _lastGlobalSyncTime >= GLOBAL_SYNC_INTERVAL) {
+        ScopedPhaseTimer timer(_profiler, TickPhase::GLOBAL_SYNC);
+        sendGlobalStateSync(udpServer);
+        _lastGlobalSyncTime = std::chrono::steady_clock::now();
+    }
+}
 
+void Game::updateBoss(UDPServer& udpServer) {
     bool spawnBoss = false;
     int bossMaxHP = 1000;
 
-    if (g_bossLevel[this] == 0 && _gameTime > 10.0f) {
-        g_bossLevel[this] = 1;
-        g_bossHP[this] = 1000;
+    if (_bossLevel == 0 && _gameTime > 10.0f) {
+        _bossLevel = 1;
+        _bossHP = 1000;
         bossMaxHP = 1000;
         spawnBoss = true;
         std::cout << "[Game] Boss Level 1 Spawned!" << std::endl;
-    } else if (g_bossLevel[this] == 2 && _gameTime > g_bossDeathTime[this] + 0.0f) { // Spawn Boss 2 (30s after death)
-        g_bossLevel[this] = 3;
-        g_bossHP[this] = 2000;
+    } else if (_bossLevel == 2 && _gameTime > _bossDeathTime + 0.0f) { // Spawn Boss 2 (30s after death)
+        _bossLevel = 3;
+        _bossHP = 2000;
         bossMaxHP = 2000;
         spawnBoss = true;
         std::cout << "[Game] Boss Level 2 Spawned!" << std::endl;
@@ -355,7 +664,8 @@ void Game::update(UDPServer& udpServer) {
         std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
         uint32_t entityId = _nextEntityId++;
         // Spawn Boss: Type 10
-        _entities.push_back({entityId, 10, 1600.0f, 400.0f, -2.0f, 0.0f, 296, 88});
+        _entities.add({entityId, 10, 1600.0f, 400.0f, -2.0f, 0.0f, 296, 88});
+        _bossEntityId = entityId;
 
         EntitySpawnPacket spawnPkt;
         spawnPkt.entityId = entityId;
@@ -364,50 +674,48 @@ void Game::update(UDPServer& udpServer) {
         spawnPkt.y = 400.0f;
 
         BossStatePacket bossPkt;
-        bossPkt.hp = g_bossHP[this];
+        bossPkt.hp = _bossHP;
         bossPkt.maxHp = bossMaxHP;
 
         std::lock_guard<std::mutex> lock_players(_playersMutex);
-        for (const auto& destPlayer : _players) {
+        for (auto& destPlayer : _players) {
             if (destPlayer.addrSet) {
-                udpServer.queueMessage(spawnPkt, destPlayer.udpAddr);
-                udpServer.queueMessage(bossPkt, destPlayer.udpAddr);
+                sendReliable(destPlayer, spawnPkt, udpServer);
+                sendReliable(destPlayer, bossPkt, udpServer);
             }
         }
     }
 
     // Boss Shooting Logic
-    if (g_bossLevel[this] == 1 || g_bossLevel[this] == 3) {
+    if (_bossLevel == 1 || _bossLevel == 3) {
         bool bossExists = false;
         float bossX = 0;
         float bossY = 0;
         
         {
             std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
-            for (const auto& entity : _entities) {
-                if (entity.type == 10) {
-                    bossExists = true;
-                    bossX = entity.x;
-                    bossY = entity.y;
-                    break;
-                }
+            uint32_t index = _entities.indexOf(_bossEntityId);
+            if (index != EntityStore::INVALID_INDEX) {
+                bossExists = true;
+                bossX = _entities.x()[index];
+                bossY = _entities.y()[index];
             }
         }
 
-        float shootInterval = (g_bossLevel[this] == 3) ? 1.0f : 1.5f;
+        float shootInterval = (_bossLevel == 3) ? 1.0f : 1.5f;
 
-        if (bossExists && (_gameTime - g_lastBossShootTime[this] > shootInterval)) {
-            g_lastBossShootTime[this] = _gameTime;
+        if (bossExists && (_gameTime - _lastBossShootTime > shootInterval)) {
+            _lastBossShootTime = _gameTime;
             std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
             std::lock_guard<std::mutex> lock_players(_playersMutex);
 
             std::vector<float> vyOffsets;
-            if (g_bossLevel[this] == 3) vyOffsets = {-5.0f, 0.0f, 5.0f}; // Triple shot
+            if (_bossLevel == 3) vyOffsets = {-5.0f, 0.0f, 5.0f}; // Triple shot
             else vyOffsets = {0.0f}; // Single shot
 
             for (float vy : vyOffsets) {
                 uint32_t projId = _nextEntityId++;
-                _entities.push_back({projId, 11, bossX, bossY + 80, -15.0f, vy, 30, 30});
+                _entities.add({projId, 11, bossX, bossY + 80, -15.0f, vy, 30, 30});
 
                 EntitySpawnPacket spawnPkt;
                 spawnPkt.entityId = projId;
@@ -415,43 +723,35 @@ void Game::update(UDPServer& udpServer) {
                 spawnPkt.x = bossX;
                 spawnPkt.y = bossY + 80;
 
-                for (const auto& destPlayer : _players) {
-                    if (destPlayer.addrSet) udpServer.queueMessage(spawnPkt, destPlayer.udpAddr);
+                for (auto& destPlayer : _players) {
+                    if (destPlayer.addrSet) sendReliable(destPlayer, spawnPkt, udpServer);
                 }
             }
         }
     }
-
-    if (std::chrono::steady_clock::now() - _lastEnemySpawnTime > std::chrono::seconds(2)) {
-        createEnemy(udpServer);
-        _lastEnemySpawnTime = std::chrono::steady_clock::now();
-    }
-
-    if (std::chrono::steady_clock::now() - _lastGlobalSyncTime >= GLOBAL_SYNC_INTERVAL) {
-        sendGlobalStateSync(udpServer);
-        _lastGlobalSyncTime = std::chrono::steady_clock::now();
-    }
 }
 
-void Game::disconnectPlayer(uint32_t playerId, UDPServer& udpServer) {
+bool Game::disconnectPlayer(uint32_t playerId, UDPServer& udpServer) {
     std::lock_guard<std::mutex> lock(_playersMutex);
     auto it = std::remove_if(_players.begin(), _players.end(),
                              [playerId](const Player& player) {
                                 return player.id == playerId;
                              });
-    if (it != _players.end()) {
-        _players.erase(it, _players.end());
-        std::cout << "[Game] Player " << playerId << " disconnected." << std::endl;
-    }
+    if (it == _players.end())
+        return false;
+    _players.erase(it, _players.end());
+    releasePlayer(playerId);
+    std::cout << "[Game] Player " << playerId << " disconnected." << std::endl;
 
-    for (const auto& destPlayer : _players) {
+    for (auto& destPlayer : _players) {
         if (destPlayer.addrSet) {
             PlayerDisconnectPacket disconnectPkt {};
             disconnectPkt.playerId = playerId;
-            udpServer.queueMessage(disconnectPkt, destPlayer.udpAddr);
+            sendReliable(destPlayer, disconnectPkt, udpServer);
             std::cout << "Send message disconnect to player " << destPlayer.id << "." << std::endl;
         }
     }
+    return true;
 }
 
 void Game::removePlayerFromLobby(uint32_t playerId) {
@@ -477,89 +777,123 @@ void Game::handleCollision(UDPServer &udpServer) {
     std::lock_guard<std::mutex> lock_entities(_entitiesMutex);
     std::lock_guard<std::mutex> lock_players(_playersMutex);
 
-    for (auto& projectile : _entities) {
-        if (projectile.type != 1 && projectile.type != 4) continue;
-        for (auto& enemy : _entities) {
-            if (enemy.type != 2 && enemy.type != 3 && enemy.type != 10) continue;
-            if (projectile.is_collide || enemy.is_collide) continue;
-            if (checkCollision(projectile.x, projectile.y, projectile.width, projectile.height, enemy.x, enemy.y, enemy.width, enemy.height)) {
-                projectile.is_collide = true;
-                
-                if (enemy.type == 10) { // Boss Logic
-                    int damage = (projectile.type == 4) ? 50 : 10;
-                    g_bossHP[this] -= damage;
-
-                    BossStatePacket bossPkt;
-                    bossPkt.hp = g_bossHP[this];
-                    bossPkt.maxHp = (g_bossLevel[this] == 3) ? 2000 : 1000;
-
-                    for (const auto& destPlayer : _players) {
-                        if (destPlayer.addrSet) udpServer.queueMessage(bossPkt, destPlayer.udpAddr);
-                    }
-
-                    if (g_bossHP[this] <= 0) {
-                        enemy.is_collide = true;
-                        if (g_bossLevel[this] == 1) {
-                            g_bossLevel[this] = 2; // Start cooldown for Boss 2
-                            g_bossDeathTime[this] = _gameTime;
-                            std::cout << "[Game] Boss 1 Defeated. Waiting for Boss 2..." << std::endl;
-                        } else if (g_bossLevel[this] == 3) {
-                            g_bossLevel[this] = 4; // Victory
-                            std::cout << "[Game] Boss 2 Defeated. Victory!" << std::endl;
-                        }
-                    }
-                } else {
-                    enemy.is_collide = true;
+    size_t count = _entities.size();
+    const uint32_t* ids = _entities.id();
+    const uint16_t* types = _entities.type();
+    const float* x = _entities.x();
+    const float* y = _entities.y();
+    const int* width = _entities.width();
+    const int* height = _entities.height();
+    uint8_t* flags = _entities.flags();
+
+    // Broadphase: everything that can be hit goes into the grid,
+    // projectiles and players only query it.
+    _collisionGrid.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (types[i] == 2 || types[i] == 3 || types[i] == 10 || types[i] == 11)
+            _collisionGrid.insert(i, x[i], y[i], width[i], height[i]);
+    }
+    _collisionGrid.build();
+
+    for (uint32_t p = 0; p < count; ++p) {
+        if (types[p] != 1 && types[p] != 4) continue;
+        if (flags[p] & EntityStore::COLLIDED) continue;
+
+        // A projectile hits the overlapping enemy with the lowest id, which is
+        // the oldest one. The grid may report an enemy once per shared cell.
+        uint32_t hit = EntityStore::INVALID_INDEX;
+        _collisionGrid.query(x[p], y[p], width[p], height[p], [&](uint32_t e) {
+            if (types[e] == 11 || (flags[e] & EntityStore::COLLIDED)) return;
+            if (hit != EntityStore::INVALID_INDEX && ids[e] >= ids[hit]) return;
+            if (checkCollision(x[p], y[p], width[p], height[p], x[e], y[e], width[e], height[e]))
+                hit = e;
+        });
+        if (hit == EntityStore::INVALID_INDEX) continue;
+
+        flags[p] |= EntityStore::COLLIDED;
+
+        if (types[hit] == 10) { // Boss Logic
+            int damage = (types[p] == 4) ? 50 : 10;
+            _bossHP -= damage;
+
+            BossStatePacket bossPkt;
+            bossPkt.hp = _bossHP;
+            bossPkt.maxHp = (_bossLevel == 3) ? 2000 : 1000;
+
+            for (auto& destPlayer : _players) {
+                if (destPlayer.addrSet) sendReliable(destPlayer, bossPkt, udpServer);
+            }
+
+            if (_bossHP <= 0) {
+                flags[hit] |= EntityStore::COLLIDED;
+                if (_bossLevel == 1) {
+                    _bossLevel = 2; // Start cooldown for Boss 2
+                    _bossDeathTime = _gameTime;
+                    std::cout << "[Game] Boss 1 Defeated. Waiting for Boss 2..." << std::endl;
+                } else if (_bossLevel == 3) {
+                    _bossLevel = 4; // Victory
+                    std::cout << "[Game] Boss 2 Defeated. Victory!" << std::endl;
                 }
             }
+        } else {
+            flags[hit] |= EntityStore::COLLIDED;
         }
     }
 
     for (auto& player : _players) {
-        for (auto& enemy : _entities) {
-            if (enemy.type != 2 && enemy.type != 3 && enemy.type != 11)
-                continue;
-            if (enemy.is_collide)
-                continue;
-
-            if (checkCollision(player.x, player.y, 60, 30, enemy.x, enemy.y, enemy.width, enemy.height)) {
-                enemy.is_collide = true;
+        _collisionGrid.query(player.x, player.y, 60, 30, [&](uint32_t e) {
+            if (types[e] == 10 || (flags[e] & EntityStore::COLLIDED))
+                return;
+
+            if (checkCollision(player.x, player.y, 60, 30, x[e], y[e], width[e], height[e])) {
+                flags[e] |= EntityStore::COLLIDED;
             }
-        }
+        });
     }
 }
 
-void Game::kickPlayer(uint32_t playerId, UDPServer& udpServer) {
+bool Game::kickPlayer(uint32_t playerId, UDPServer& udpServer) {
     std::lock_guard<std::mutex> lock(_playersMutex);
 
-    // Notify the kicked player
-    for (const auto& player : _players) {
-        if (player.id == playerId) {
-            if (player.addrSet) {
-                YouHaveBeenKickedPacket kickPkt;
-                udpServer.queueMessage(kickPkt, player.udpAddr);
-            }
-            break;
+    auto it = std::find_if(_players.begin(), _players.end(),
+                           [playerId](const Player& player) {
+                               return player.id == playerId;
+                           });
+    if (it == _players.end())
+        return false;
+
+    // Notify the kicked player. Its reliable channel, and its route, outlive it
+    // until the notice is acknowledged or KICK_LINGER expires.
+    bool departing = false;
+    if (it->addrSet) {
+        YouHaveBeenKickedPacket kickPkt;
+        bool queued = false;
+        if (it->protocolVersion >= PROTOCOL_VERSION_RELIABLE) {
+            auto now = Network::ReliableSender::Clock::now();
+            DepartingChannel& channel = _departing.emplace_back(
+                DepartingChannel{playerId, it->udpAddr, std::move(it->reliable), now + KICK_LINGER});
+            departing = true;
+            queued = channel.reliable.send(reinterpret_cast<const char*>(&kickPkt), sizeof(kickPkt), now,
+                [&](const char* message, size_t size) {
+                    udpServer.queueMessage(message, size, channel.udpAddr);
+                });
         }
+        if (!queued)
+            udpServer.queueMessage(kickPkt, it->udpAddr);
     }
 
-    // Remove the player
-    auto it = std::remove_if(_players.begin(), _players.end(),
-                             [playerId](const Player& player) {
-                                return player.id == playerId;
-                             });
-
-    if (it != _players.end()) {
-        _players.erase(it, _players.end());
-        std::cout << "[Game] Player " << playerId << " kicked." << std::endl;
-    }
+    _players.erase(it);
+    if (!departing)
+        releasePlayer(playerId);
+    std::cout << "[Game] Player " << playerId << " kicked." << std::endl;
 
     // Notify remaining players
-    for (const auto& destPlayer : _players) {
+    for (auto& destPlayer : _players) {
         if (destPlayer.addrSet) {
             PlayerDisconnectPacket disconnectPkt;
             disconnectPkt.playerId = playerId;
-            udpServer.queueMessage(disconnectPkt, destPlayer.udpAddr);
+            sendReliable(destPlayer, disconnectPkt, udpServer);
         }
     }
-}
\ No newline at end of file
+    return true;
+}
@@ -0,0 +1,90 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** InterestManager
+*/
+
+#include "Server/InterestManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float PLAYER_WIDTH = 33.0f;
+constexpr float PLAYER_HEIGHT = 17.0f;
+
+bool isHostile(uint16_t type)
+{
+    return type == 2 || type == 3 || type == 11;
+}
+
+float typeWeight(uint16_t type)
+{
+    switch (type) {
+        case 11: return 1.0f; // Boss projectile
+        case 2:
+        case 3: return 0.8f;  // Enemies
+        case 1:
+        case 4: return 0.4f;  // Player shots, harmless to players
+        default: return 0.5f;
+    }
+}
+
+}
+
+float InterestManager::relevance(const ReplicatedEntity& entity, float playerX, float playerY)
+{
+    if (entity.type == 10)
+        return 1.0f;
+
+    float dx = (entity.x + entity.width * 0.5f) - (playerX + PLAYER_WIDTH * 0.5f);
+    float dy = (entity.y + entity.height * 0.5f) - (playerY + PLAYER_HEIGHT * 0.5f);
+    float proximity = 1.0f - std::min(std::sqrt(dx * dx + dy * dy) / FAR_DISTANCE, 1.0f);
+    float score = typeWeight(entity.type) * proximity;
+
+    // A hostile coming at the ship's row matters more the sooner it gets there.
+    if (isHostile(entity.type) && dx > 0.0f && entity.velocityX < 0.0f && std::abs(dy) < THREAT_LANE) {
+        float ticksToReach = dx / -entity.velocityX;
+        score += 0.5f * (1.0f - std::min(ticksToReach / THREAT_HORIZON, 1.0f));
+    }
+    return score;
+}
+
+RelevanceTier InterestManager::tierOf(float score)
+{
+    if (score >= HIGH_RELEVANCE)
+        return RelevanceTier::HIGH;
+    if (score >= MEDIUM_RELEVANCE)
+        return RelevanceTier::MEDIUM;
+    return RelevanceTier::LOW;
+}
+
+bool InterestManager::isDue(RelevanceTier tier, uint32_t entityId, uint32_t tick)
+{
+    if (tier == RelevanceTier::MEDIUM)
+        return (tick + entityId) % MEDIUM_INTERVAL == 0;
+    if (tier == RelevanceTier::LOW)
+        return (tick + entityId) % LOW_INTERVAL == 0;
+    return true;
+}
+
+void InterestManager::record(RelevanceTier tier, ReplicationOutcome outcome)
+{
+    auto index = static_cast<size_t>(tier);
+    if (outcome == ReplicationOutcome::SENT)
+        _sent[index].fetch_add(1, std::memory_order_relaxed);
+    else if (outcome == ReplicationOutcome::DEFERRED)
+        _deferred[index].fetch_add(1, std::memory_order_relaxed);
+    else
+        _throttled[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void InterestManager::addTo(ReplicationStats& out) const
+{
+    for (size_t i = 0; i < RELEVANCE_TIER_COUNT; ++i) {
+        out.sent[i] += _sent[i].load(std::memory_order_relaxed);
+        out.deferred[i] += _deferred[i].load(std::memory_order_relaxed);
+        out.throttled[i] += _throttled[i].load(std::memory_order_relaxed);
+    }
+}
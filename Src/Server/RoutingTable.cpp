@@ -0,0 +1,126 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** RoutingTable
+*/
+
+#include "Server/RoutingTable.hpp"
+#include <mutex>
+
+uint64_t RoutingTable::addressKey(const sockaddr_in& addr)
+{
+    return (static_cast<uint64_t>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+}
+
+void RoutingTable::eraseAddress(uint64_t key, uint32_t playerId)
+{
+    AddressShard& shard = addressShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.players.find(key);
+    if (it != shard.players.end() && it->second == playerId)
+        shard.players.erase(it);
+}
+
+void RoutingTable::bindPlayer(uint32_t playerId, int roomId, std::shared_ptr<Game> game)
+{
+    PlayerShard& shard = playerShard(playerId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    Route& route = shard.routes[playerId];
+
+    if (route.hasAddress)
+        eraseAddress(route.addressKey, playerId);
+    route = Route{roomId, std::move(game)};
+}
+
+void RoutingTable::unbindPlayer(uint32_t playerId)
+{
+    PlayerShard& shard = playerShard(playerId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.routes.find(playerId);
+
+    if (it == shard.routes.end())
+        return;
+    if (it->second.hasAddress)
+        eraseAddress(it->second.addressKey, playerId);
+    shard.routes.erase(it);
+}
+
+size_t RoutingTable::unbindRoom(int roomId)
+{
+    size_t removed = 0;
+
+    for (PlayerShard& shard : _players) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.routes.begin(); it != shard.routes.end();) {
+            if (it->second.roomId != roomId) {
+                ++it;
+                continue;
+            }
+            if (it->second.hasAddress)
+                eraseAddress(it->second.addressKey, it->first);
+            it = shard.routes.erase(it);
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+std::shared_ptr<Game> RoutingTable::findRoom(uint32_t playerId) const
+{
+    const PlayerShard& shard = playerShard(playerId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.routes.find(playerId);
+
+    return it != shard.routes.end() ? it->second.game : nullptr;
+}
+
+bool RoutingTable::bindAddress(const sockaddr_in& addr, uint32_t playerId)
+{
+    PlayerShard& shard = playerShard(playerId);
+    uint64_t key = addressKey(addr);
+
+    {
+        // Fast path: every packet after the first one.
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.routes.find(playerId);
+        if (it == shard.routes.end() || it->second.hasAddress)
+            return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.routes.find(playerId);
+    if (it == shard.routes.end() || it->second.hasAddress)
+        return false;
+    {
+        AddressShard& addresses = addressShard(key);
+        std::unique_lock<std::shared_mutex> addressLock(addresses.mutex);
+        auto [entry, inserted] = addresses.players.try_emplace(key, playerId);
+        if (!inserted)
+            return false;
+    }
+    it->second.addressKey = key;
+    it->second.hasAddress = true;
+    return true;
+}
+
+uint32_t RoutingTable::findPlayer(const sockaddr_in& addr) const
+{
+    uint64_t key = addressKey(addr);
+    const AddressShard& shard = addressShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.players.find(key);
+
+    return it != shard.players.end() ? it->second : NO_PLAYER;
+}
+
+size_t RoutingTable::size() const
+{
+    size_t total = 0;
+
+    for (const PlayerShard& shard : _players) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.routes.size();
+    }
+    return total;
+}
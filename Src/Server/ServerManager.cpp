@@ -6,23 +6,159 @@
 */
 
 #include "Server/ServerManager.hpp"
+#include "Server/EntityKernels.hpp"
 #include <iostream>
 #include <thread>
 #include <sstream>
 #include <chrono>
+#include <cstring>
 
-ServerManager::ServerManager()
+ServerManager::ServerManager(uint32_t tickRate, unsigned short metricsPort, Network::BackpressurePolicy backpressure,
+                             uint32_t clientKbps)
     : _clock(),
       _tcpServer(4242, this, _clock),
       _udpServer(5252, this, _clock),
-      _running(true)
+      _running(true),
+      _scheduler(tickRate),
+      _droppedInputs(_metrics.counter("rtype_room_inputs_dropped_total", "Player inputs dropped because the room input queue was full")),
+      _metricsPort(metricsPort),
+      _metricsExporter(_metrics, metricsPort),
+      _clientKbps(clientKbps)
 {
+    _udpServer.setBackpressurePolicy(backpressure);
+    registerMetrics();
+}
+
+void ServerManager::registerMetrics()
+{
+    // Every room and UDP metric of one scrape reads the same snapshot, taken once.
+    _metrics.onRender([this] {
+        _scrapedUdp = _udpServer.getStats();
+        _scrapedRooms = collectRoomMetrics();
+    });
+    _metrics.counterFunction("rtype_udp_datagrams_received_total", "UDP datagrams received",
+        [this] { return static_cast<double>(_scrapedUdp.recvBatches.datagrams); });
+    _metrics.counterFunction("rtype_udp_datagrams_sent_total", "UDP datagrams sent",
+        [this] { return static_cast<double>(_scrapedUdp.sendBatches.datagrams); });
+    _metrics.counterFunction("rtype_udp_bytes_received_total", "UDP payload bytes received",
+        [this] { return static_cast<double>(_scrapedUdp.bytesReceived); });
+    _metrics.counterFunction("rtype_udp_bytes_sent_total", "UDP payload bytes sent",
+        [this] { return static_cast<double>(_scrapedUdp.bytesSent); });
+    _metrics.counterFunction("rtype_udp_incoming_dropped_total", "UDP datagrams dropped because the incoming queue was full",
+        [this] { return static_cast<double>(_scrapedUdp.incomingDropped); });
+    _metrics.counterFunction("rtype_udp_outgoing_dropped_total", "UDP datagrams dropped because the outgoing queue was full",
+        [this] { return static_cast<double>(_scrapedUdp.outgoingDropped); });
+    for (uint8_t type = PLAYER_STATE; type <= RELIABLE; ++type) {
+        if (type == PLAYER_INPUT || type == PING || type == PLAYER_DISCONNECT || type == SNAPSHOT_ACK)
+            continue;
+        _metrics.counterFunction("rtype_udp_messages_dropped_total", "Outgoing messages dropped by the backpressure policy",
+            [this, type] { return static_cast<double>(_scrapedUdp.droppedByType[type]); },
+            std::string("type=\"") + Network::messageTypeName(type) + "\"");
+    }
+    _metrics.counterFunction("rtype_udp_critical_waits_total", "Critical datagrams that waited for room in the outgoing queue",
+        [this] { return static_cast<double>(_scrapedUdp.criticalWaits); });
+    _metrics.gaugeFunction("rtype_udp_pool_packets_in_use", "Pooled packet buffers in use",
+        [this] { return static_cast<double>(_scrapedUdp.incomingPool.inUse); }, "pool=\"recv\"");
+    _metrics.gaugeFunction("rtype_udp_pool_packets_in_use", "Pooled packet buffers in use",
+        [this] { return static_cast<double>(_scrapedUdp.outgoingPool.inUse); }, "pool=\"send\"");
+    _metrics.counterFunction("rtype_udp_pool_exhausted_total", "Packet buffer requests that found the pool empty",
+        [this] { return static_cast<double>(_scrapedUdp.incomingPool.exhausted); }, "pool=\"recv\"");
+    _metrics.counterFunction("rtype_udp_pool_exhausted_total", "Packet buffer requests that found the pool empty",
+        [this] { return static_cast<double>(_scrapedUdp.outgoingPool.exhausted); }, "pool=\"send\"");
+    _metrics.counterFunction("rtype_udp_payload_copies_total", "Copies of outgoing message bytes into pooled datagrams",
+        [this] { return static_cast<double>(_scrapedUdp.payloadCopies); });
+    _metrics.gaugeFunction("rtype_udp_incoming_queue_depth", "UDP datagrams waiting to be processed",
+        [this] { return static_cast<double>(_scrapedUdp.incomingDepth); });
+    _metrics.gaugeFunction("rtype_udp_outgoing_queue_depth", "UDP datagrams waiting to be sent",
+        [this] { return static_cast<double>(_scrapedUdp.outgoingDepth); });
+
+    _metrics.counterFunction("rtype_ticks_total", "Game loop ticks run",
+        [this] { return static_cast<double>(_scheduler.getStats().ticks); });
+    _metrics.counterFunction("rtype_tick_overruns_total", "Ticks that took longer than one period",
+        [this] { return static_cast<double>(_scheduler.getStats().overruns); });
+    _metrics.counterFunction("rtype_ticks_dropped_total", "Ticks skipped because the loop fell too far behind",
+        [this] { return static_cast<double>(_scheduler.getStats().droppedTicks); });
+    _metrics.gaugeFunction("rtype_tick_rate_hz", "Configured tick rate",
+        [this] { return static_cast<double>(_scheduler.getTickRate()); });
+
+    _metrics.gaugeFunction("rtype_tcp_sessions", "Connected lobby clients",
+        [this] { return static_cast<double>(_tcpServer.getSessionCount()); });
+    _metrics.gaugeFunction("rtype_rooms", "Rooms, in lobby or playing",
+        [this] { return static_cast<double>(_scrapedRooms.rooms); });
+    _metrics.gaugeFunction("rtype_rooms_playing", "Rooms in game",
+        [this] { return static_cast<double>(_scrapedRooms.playing); });
+    _metrics.gaugeFunction("rtype_players", "Players in a room",
+        [this] { return static_cast<double>(_scrapedRooms.players); });
+    _metrics.gaugeFunction("rtype_player_inputs_received", "Inputs received from the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.inputsReceived); });
+    _metrics.gaugeFunction("rtype_player_bytes_sent", "Message bytes sent to the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.bytesSent); });
+    _metrics.gaugeFunction("rtype_player_updates_throttled", "Entity updates held back by the bandwidth budget of the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.updatesThrottled); });
+    _metrics.gaugeFunction("rtype_player_budget_kbps", "Bandwidth budget of each player, 0 when unlimited",
+        [this] { return static_cast<double>(_clientKbps.load(std::memory_order_relaxed)); });
+    _metrics.gaugeFunction("rtype_player_inputs_lost", "Inputs estimated as lost from the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.inputsLost); });
+    _metrics.gaugeFunction("rtype_player_reliable_sent", "Messages sent on the reliable channel to the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.reliable.sent); });
+    _metrics.gaugeFunction("rtype_player_reliable_retransmits", "Reliable messages sent again after their timeout to the players currently in a room",
+        [this] { return static_cast<double>(_scrapedRooms.reliable.retransmits); });
+    _metrics.gaugeFunction("rtype_player_reliable_pending", "Reliable messages waiting for an acknowledgement",
+        [this] { return static_cast<double>(_scrapedRooms.reliable.pending); });
+    _metrics.gaugeFunction("rtype_player_reliable_rtt_ms", "Smoothed round-trip time measured by the reliable channel",
+        [this] { return static_cast<double>(_scrapedRooms.reliable.rttMs); });
+}
+
+ServerManager::RoomMetrics ServerManager::collectRoomMetrics()
+{
+    std::vector<std::shared_ptr<Game>> games;
+    RoomMetrics metrics;
+    {
+        std::lock_guard<std::mutex> lock(_serverMutex);
+        for (const auto& [id, game] : _rooms) {
+            if (game)
+                games.push_back(game);
+        }
+    }
+    size_t sampled = 0;
+    for (const auto& game : games) {
+        uint64_t received = 0;
+        uint64_t lost = 0;
+        game->getInputCounters(received, lost);
+        Network::ReliableStats reliable;
+        game->getReliableCounters(reliable);
+        metrics.reliable.sent += reliable.sent;
+        metrics.reliable.retransmits += reliable.retransmits;
+        metrics.reliable.acked += reliable.acked;
+        metrics.reliable.overflows += reliable.overflows;
+        metrics.reliable.pending += reliable.pending;
+        if (reliable.rttMs > 0.0f) {
+            metrics.reliable.rttMs += reliable.rttMs;
+            metrics.reliable.rtoMs += reliable.rtoMs;
+            ++sampled;
+        }
+        metrics.rooms++;
+        metrics.playing += game->getStatus() == GameStatus::PLAYING;
+        metrics.players += static_cast<uint64_t>(game->getPlayerCount());
+        metrics.inputsReceived += received;
+        metrics.inputsLost += lost;
+        for (const ClientBandwidth& client : game->getBandwidthUsage()) {
+            metrics.bytesSent += client.bytes;
+            metrics.updatesThrottled += client.throttled;
+        }
+    }
+    if (sampled > 0) {
+        metrics.reliable.rttMs /= sampled;
+        metrics.reliable.rtoMs /= sampled;
+    }
+    return metrics;
 }
 
 ServerManager::~ServerManager()
 {
     _running = false;
     std::cout << "[ServerManager] Stopping servers..." << std::endl;
+    _metricsExporter.stop();
     _tcpServer.stop();
     _udpServer.stop();
 
@@ -37,19 +173,42 @@ void ServerManager::run()
         _shellThread = std::thread(&ServerManager::shellLoop, this);
         _tcpServer.start();
         _udpServer.start();
+        if (_metricsPort != 0)
+            _metricsExporter.start();
 
         std::cout << "[ServerManager] Servers started. Entering game loop..." << std::endl;
+        std::cout << "[ServerManager] Entity integration kernel: " << EntityKernels::integrateBackend() << std::endl;
+        std::cout << "[ServerManager] Tick rate: " << _scheduler.getTickRate() << " Hz" << std::endl;
+        std::cout << "[ServerManager] Room workers: " << _roomPool.getStats().workers << " + game loop thread" << std::endl;
 
         while (_running) {
-            {
-                std::lock_guard<std::mutex> lock(_serverMutex);
-                for (auto& [id, game] : _rooms) {
-                    if (game) {
-                        game->update(_udpServer);
+            uint32_t ticks = _scheduler.waitForTicks();
+            float deltaTime = _scheduler.getTickDelta();
+
+            for (uint32_t i = 0; i < ticks && _running; ++i) {
+                auto tickStart = std::chrono::steady_clock::now();
+                {
+                    // Only the room list is copied under the lock, so lobby calls never wait for a tick.
+                    std::lock_guard<std::mutex> lock(_serverMutex);
+                    _tickRooms.clear();
+                    for (auto& [id, game] : _rooms) {
+                        if (game) {
+                            _tickRooms.push_back({id, game});
+                        }
                     }
                 }
+                for (auto& [id, game] : _tickRooms) {
+                    Game* room = game.get();
+                    _roomPool.submit([this, room, deltaTime] {
+                        UDPServer::TickBatch batch(_udpServer);
+                        room->update(_udpServer, deltaTime);
+                    });
+                }
+                _roomPool.wait();
+                publishDepartures();
+                _tickRooms.clear();
+                _scheduler.recordTick(std::chrono::steady_clock::now() - tickStart);
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
         }
     } catch (const std::exception& e) {
         std::cerr << "[ServerManager] Error: " << e.what() << std::endl;
@@ -64,25 +223,34 @@ void ServerManager::onMessageReceived(const char* data, size_t length, const soc
 
     switch (type) {
         case PLAYER_INPUT:
-            if (length == sizeof(PlayerInputPacket)) {
-                const auto* p = reinterpret_cast<const PlayerInputPacket*>(data);
-                for (auto& [id, game] : _rooms) {
-                    if (game->getPlayer(p->playerId)) {
-                        game->updatePlayerUdpAddr(p->playerId, clientAddr);
-                        game->handlePlayerInput(*p, _udpServer);
-                        break;
+            if (length == sizeof(PlayerInputPacket) || length == LEGACY_PLAYER_INPUT_SIZE) {
+                PlayerInputPacket p{};
+                std::memcpy(&p, data, length);
+                if (auto game = routePacket(p.playerId, clientAddr)) {
+                    if (_routes.bindAddress(clientAddr, p.playerId)) {
+                        game->updatePlayerUdpAddr(p.playerId, clientAddr);
                     }
+                    if (length == sizeof(PlayerInputPacket))
+                        game->acknowledgeReliable(p.playerId, p.reliableAck, p.reliableAckBits);
+                    if (!game->queueInput(p))
+                        _droppedInputs.add();
                 }
             }
             break;
         case PLAYER_DISCONNECT:
             if (length == sizeof(PlayerDisconnectPacket)) {
                 const auto* p = reinterpret_cast<const PlayerDisconnectPacket*>(data);
-                for (auto& [id, game] : _rooms) {
-                    if (game->getPlayer(p->playerId)) {
-                        game->disconnectPlayer(p->playerId, _udpServer);
-                        break;
-                    }
+                if (auto game = routePacket(p->playerId, clientAddr)) {
+                    game->queueDisconnect(p->playerId);
+                    _routes.unbindPlayer(p->playerId);
+                }
+            }
+            break;
+        case SNAPSHOT_ACK:
+            if (length == sizeof(SnapshotAckPacket)) {
+                const auto* p = reinterpret_cast<const SnapshotAckPacket*>(data);
+                if (auto game = routePacket(p->playerId, clientAddr)) {
+                    game->acknowledgeSnapshot(p->playerId, p->snapshotId);
                 }
             }
             break;
@@ -96,10 +264,49 @@ void ServerManager::onMessageReceived(const char* data, size_t length, const soc
     }
 }
 
+std::shared_ptr<Game> ServerManager::routePacket(uint32_t playerId, const sockaddr_in& clientAddr)
+{
+    uint32_t owner = _routes.findPlayer(clientAddr);
+
+    if (owner != RoutingTable::NO_PLAYER && owner != playerId) {
+        return nullptr;
+    }
+    return _routes.findRoom(playerId);
+}
+
+void ServerManager::publishDepartures()
+{
+    for (const auto& [roomId, game] : _tickRooms) {
+        _releasedPlayers.clear();
+        game->takeReleasedPlayers(_releasedPlayers);
+        for (uint32_t playerId : _releasedPlayers)
+            _routes.unbindPlayer(playerId);
+        if (!game->takeDepartures())
+            continue;
+        std::lock_guard<std::mutex> lock(_serverMutex);
+        publishRoom(roomId);
+    }
+}
+
+void ServerManager::publishRoom(int roomId)
+{
+    auto it = _rooms.find(roomId);
+    if (it == _rooms.end() || !it->second) {
+        _tcpServer.pushRoomRemoved(roomId);
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, std::string>> players = it->second->getPlayerNames();
+    _tcpServer.pushRoomUpdate({roomId, static_cast<int>(players.size())});
+    _tcpServer.pushLobbyState(roomId, it->second->getHostId(), players);
+}
+
 int ServerManager::onCreateRoom() {
     std::lock_guard<std::mutex> lock(_serverMutex);
     int id = _nextRoomId++;
     _rooms[id] = std::make_shared<Game>();
+    _rooms[id]->setBandwidthBudget(_clientKbps.load(std::memory_order_relaxed));
+    publishRoom(id);
     return id;
 }
 
@@ -112,11 +319,13 @@ std::vector<Network::RoomSimpleInfo> ServerManager::onGetRooms() {
     return list;
 }
 
-bool ServerManager::onJoinRoom(int roomId, uint32_t playerId, const std::string& username) {
+bool ServerManager::onJoinRoom(int roomId, uint32_t playerId, const std::string& username, uint8_t protocolVersion) {
     std::lock_guard<std::mutex> lock(_serverMutex);
     auto it = _rooms.find(roomId);
     if (it != _rooms.end() && it->second->getStatus() == GameStatus::LOBBY) {
-        it->second->addPlayer(playerId, username.c_str());
+        it->second->addPlayer(playerId, username.c_str(), protocolVersion);
+        _routes.bindPlayer(playerId, roomId, it->second);
+        publishRoom(roomId);
         std::cout << "[ServerManager] Player " << username << " joined room " << roomId << std::endl;
         return true;
     }
@@ -128,8 +337,8 @@ std::vector<uint32_t> ServerManager::onGetPlayersInRoom(int roomId) {
     std::vector<uint32_t> playerIds;
     auto it = _rooms.find(roomId);
     if (it != _rooms.end()) {
-        for (const auto& player : it->second->getPlayers()) {
-            playerIds.push_back(player.id);
+        for (const auto& [id, username] : it->second->getPlayerNames()) {
+            playerIds.push_back(id);
         }
     }
     return playerIds;
@@ -147,7 +356,15 @@ bool ServerManager::isGameStarting(int roomId) {
 void ServerManager::onPlayerDisconnect(uint32_t playerId, int roomId) {
     std::lock_guard<std::mutex> lock(_serverMutex);
     if (_rooms.count(roomId)) {
-        _rooms[roomId]->removePlayerFromLobby(playerId);
+        // During a game the room removes the player on its next tick, tells the
+        // others, and the room is published and the route dropped after that tick.
+        if (_rooms[roomId]->getStatus() == GameStatus::PLAYING) {
+            _rooms[roomId]->queueDisconnect(playerId);
+        } else {
+            _rooms[roomId]->removePlayerFromLobby(playerId);
+            _routes.unbindPlayer(playerId);
+            publishRoom(roomId);
+        }
         std::cout << "[ServerManager] Player " << playerId << " left room " << roomId << std::endl;
     }
 }
@@ -157,9 +374,7 @@ void ServerManager::onGetLobbyState(int roomId, uint32_t& hostId, std::vector<st
     if (_rooms.count(roomId)) {
         auto game = _rooms[roomId];
         hostId = game->getHostId();
-        for (const auto& p : game->getPlayers()) {
-            players.push_back({p.id, p.username});
-        }
+        players = game->getPlayerNames();
     }
 }
 
@@ -168,6 +383,7 @@ void ServerManager::onStartGame(int roomId, uint32_t playerId) {
     if (_rooms.count(roomId)) {
         if (playerId == _rooms[roomId]->getHostId()) {
             _rooms[roomId]->setStatus(GameStatus::PLAYING);
+            _tcpServer.sendGameStartingNotification(roomId);
             std::cout << "[ServerManager] Room " << roomId << " starting game!" << std::endl;
         }
     }
@@ -206,6 +422,12 @@ void ServerManager::processCommand(const std::string& command)
                   << "  create                 - Create a new room\n"
                   << "  delete <room_id>       - Delete a room\n"
                   << "  kick <player_id>       - Kick a player from the server\n"
+                  << "  netstats               - Show UDP network thread counters\n"
+                  << "  tickrate [30|60|120]   - Show tick statistics or change the tick rate\n"
+                  << "  stats [room_id]        - Show tick phase timings of all rooms or of one\n"
+                  << "  backpressure [policy]  - Show UDP drops by message type or change the policy\n"
+                  << "                           (drop-newest, drop-oldest, priority, fair-share)\n"
+                  << "  budget [kbps]          - Show bandwidth use per player or change the budget (0: unlimited)\n"
                   << "  exit                   - Shut down the server\n";
     } else if (cmd == "rooms") {
         std::lock_guard<std::mutex> lock(_serverMutex);
@@ -213,13 +435,153 @@ void ServerManager::processCommand(const std::string& command)
             std::cout << "No rooms available." << std::endl;
             return;
         }
-        std::cout << "ID\tStatus\tPlayers\n" << "-----------------------\n";
+        std::cout << "ID\tStatus\tPlayers\tDropped inputs\n" << "--------------------------------------\n";
         for (const auto& [id, game] : _rooms) {
             if (game) {
                 std::string status = (game->getStatus() == GameStatus::PLAYING) ? "Playing" : "Lobby";
-                std::cout << id << "\t" << status << "\t" << game->getPlayerCount() << "/4" << std::endl;
+                std::cout << id << "\t" << status << "\t" << game->getPlayerCount() << "/4\t" << game->getDroppedInputs() << std::endl;
+            }
+        }
+        std::cout << "Routed players: " << _routes.size() << std::endl;
+    } else if (cmd == "netstats") {
+        UDPServerStats stats = _udpServer.getStats();
+        std::cout << "Thread\tSpinHits\tParks\tWakeups\tNotifies\n" << "-----------------------------------------------\n";
+        std::cout << "process\t" << stats.process.spinHits << "\t\t" << stats.process.parks << "\t"
+                  << stats.process.wakeups << "\t" << stats.process.notifies << std::endl;
+        std::cout << "send\t" << stats.send.spinHits << "\t\t" << stats.send.parks << "\t"
+                  << stats.send.wakeups << "\t" << stats.send.notifies << std::endl;
+        std::cout << "recv\t" << stats.recv.spinHits << "\t\t" << stats.recv.parks << "\t"
+                  << stats.recv.wakeups << "\t" << stats.recv.notifies << std::endl;
+        std::cout << "\nI/O backend: " << (stats.batchedIo ? "recvmmsg/sendmmsg" : "asio") << "\n"
+                  << "Dir\tBatches\tDatagrams\tAvg\tMax\n" << "-----------------------------------------------\n";
+        std::cout << "recv\t" << stats.recvBatches.batches << "\t" << stats.recvBatches.datagrams << "\t\t"
+                  << stats.recvBatches.average() << "\t" << stats.recvBatches.maxBatch << std::endl;
+        std::cout << "send\t" << stats.sendBatches.batches << "\t" << stats.sendBatches.datagrams << "\t\t"
+                  << stats.sendBatches.average() << "\t" << stats.sendBatches.maxBatch << std::endl;
+        std::cout << "\nCoalescing: " << stats.coalescedMessages << " messages in "
+                  << stats.coalescedDatagrams << " datagrams" << std::endl;
+        std::cout << "Fragmentation: " << stats.fragmentedMessages << " messages in "
+                  << stats.fragments << " fragments" << std::endl;
+        std::cout << "\nPool\tCapacity\tIn use\tAcquired\tExhausted\n" << "-----------------------------------------------\n";
+        for (const auto& [name, pool] : {std::pair{"recv", stats.incomingPool}, std::pair{"send", stats.outgoingPool}}) {
+            std::cout << name << "\t" << pool.capacity << "\t\t" << pool.inUse << "\t" << pool.acquired
+                      << "\t\t" << pool.exhausted << std::endl;
+        }
+        std::cout << "Payload copies: " << stats.payloadCopies << std::endl;
+        Network::ReliableStats reliable = collectRoomMetrics().reliable;
+        std::cout << "\nReliable: " << reliable.sent << " sent, " << reliable.retransmits << " retransmitted, "
+                  << reliable.acked << " acked, " << reliable.pending << " pending, " << reliable.overflows << " overflows\n"
+                  << "Reliable RTT: " << reliable.rttMs << " ms (timeout " << reliable.rtoMs << " ms)" << std::endl;
+    } else if (cmd == "tickrate") {
+        uint32_t rate;
+        if (ss >> rate) {
+            if (_scheduler.setTickRate(rate))
+                std::cout << "Tick rate set to " << rate << " Hz." << std::endl;
+            else
+                std::cout << "Unsupported tick rate, use 30, 60 or 120." << std::endl;
+            return;
+        }
+        TickStats stats = _scheduler.getStats();
+        std::cout << "Tick rate: " << stats.tickRate << " Hz (budget " << 1000000 / stats.tickRate << " us)\n"
+                  << "Ticks: " << stats.ticks << "\tOverruns: " << stats.overruns
+                  << "\tCatch-up: " << stats.catchUpTicks << "\tDropped: " << stats.droppedTicks << "\n"
+                  << "Tick time (us): last " << stats.lastTickUs << "\tavg " << stats.averageTickUs()
+                  << "\tmax " << stats.maxTickUs << std::endl;
+        PoolStats pool = _roomPool.getStats();
+        std::cout << "Room workers: " << pool.workers << "\tRoom ticks: " << pool.executed
+                  << "\tStolen: " << pool.stolen << std::endl;
+    } else if (cmd == "backpressure") {
+        std::string name;
+        if (ss >> name) {
+            Network::BackpressurePolicy policy;
+            if (!Network::parseBackpressurePolicy(name, policy)) {
+                std::cout << "Unknown policy, use drop-newest, drop-oldest, priority or fair-share." << std::endl;
+                return;
+            }
+            _udpServer.setBackpressurePolicy(policy);
+            std::cout << "Backpressure policy set to " << name << "." << std::endl;
+            return;
+        }
+        UDPServerStats stats = _udpServer.getStats();
+        std::cout << "Policy: " << Network::backpressurePolicyName(stats.policy) << "\n"
+                  << "Outgoing queue: " << stats.outgoingDepth << " queued\tDropped: " << stats.outgoingDropped
+                  << " datagrams (" << stats.evicted << " evicted)\tCritical waits: " << stats.criticalWaits << "\n"
+                  << "Incoming queue: " << stats.incomingDepth << " queued\tDropped: " << stats.incomingDropped << std::endl;
+        bool any = false;
+        for (size_t type = 0; type < Network::MESSAGE_TYPE_COUNT; ++type) {
+            if (stats.droppedByType[type] == 0)
+                continue;
+            if (!any)
+                std::cout << "Type\t\t\tDropped messages\n" << "-----------------------------------------------\n";
+            std::string name = Network::messageTypeName(static_cast<uint8_t>(type));
+            std::cout << name << (name.size() < 8 ? "\t\t\t" : name.size() < 16 ? "\t\t" : "\t") << stats.droppedByType[type] << std::endl;
+            any = true;
+        }
+    } else if (cmd == "budget") {
+        uint32_t kbps;
+        bool set = static_cast<bool>(ss >> kbps);
+        std::vector<std::pair<int, std::shared_ptr<Game>>> games;
+        {
+            std::lock_guard<std::mutex> lock(_serverMutex);
+            if (set)
+                _clientKbps.store(kbps, std::memory_order_relaxed);
+            for (const auto& [id, game] : _rooms) {
+                if (game)
+                    games.emplace_back(id, game);
             }
         }
+        if (set) {
+            for (const auto& [id, game] : games)
+                game->setBandwidthBudget(kbps);
+            std::cout << "Bandwidth budget set to " << (kbps == BandwidthBudget::UNLIMITED ? "unlimited" : std::to_string(kbps) + " kbps") << "." << std::endl;
+            return;
+        }
+        uint32_t current = _clientKbps.load(std::memory_order_relaxed);
+        std::cout << "Budget: " << (current == BandwidthBudget::UNLIMITED ? "unlimited" : std::to_string(current) + " kbps") << " per player\n"
+                  << "Room\tPlayer\tUsed kbps\tUse %\tBytes\t\tThrottled\n" << "-----------------------------------------------------------------\n";
+        for (const auto& [id, game] : games) {
+            for (const ClientBandwidth& client : game->getBandwidthUsage()) {
+                std::cout << id << "\t" << client.playerId << "\t" << client.usedKbps << "\t\t";
+                if (client.kbps == BandwidthBudget::UNLIMITED)
+                    std::cout << "-";
+                else
+                    std::cout << static_cast<int>(100.0f * client.usedKbps / client.kbps);
+                std::cout << "\t" << client.bytes << "\t\t" << client.throttled << std::endl;
+            }
+        }
+    } else if (cmd == "stats") {
+        int roomId;
+        bool oneRoom = static_cast<bool>(ss >> roomId);
+        std::vector<std::shared_ptr<Game>> games;
+        {
+            std::lock_guard<std::mutex> lock(_serverMutex);
+            for (const auto& [id, game] : _rooms) {
+                if (game && (!oneRoom || id == roomId))
+                    games.push_back(game);
+            }
+        }
+        if (games.empty()) {
+            std::cout << (oneRoom ? "Room not found." : "No rooms available.") << std::endl;
+            return;
+        }
+        TickProfile profile{};
+        ReplicationStats replication;
+        for (const auto& game : games) {
+            game->getProfiler().addTo(profile);
+            game->getInterestManager().addTo(replication);
+        }
+        std::cout << "Phase		Samples	p50 us	p99 us	Max us\n" << "-----------------------------------------------\n";
+        for (size_t i = 0; i < TICK_PHASE_COUNT; ++i) {
+            const PhaseHistogram::Snapshot& phase = profile[i];
+            std::string name = TickProfiler::phaseName(static_cast<TickPhase>(i));
+            std::cout << name << (name.size() < 8 ? "\t\t" : "\t") << phase.samples << "\t" << phase.percentile(50)
+                      << "\t" << phase.percentile(99) << "\t" << phase.maxUs << std::endl;
+        }
+        static constexpr const char* TIER_NAMES[RELEVANCE_TIER_COUNT] = {"high", "medium", "low"};
+        std::cout << "\nEntity updates\tSent\tDeferred\tThrottled\n" << "-----------------------------------------------\n";
+        for (size_t i = 0; i < RELEVANCE_TIER_COUNT; ++i)
+            std::cout << TIER_NAMES[i] << "\t\t" << replication.sent[i] << "\t" << replication.deferred[i]
+                      << "\t\t" << replication.throttled[i] << std::endl;
     } else if (cmd == "create") {
         int newId = onCreateRoom();
         std::cout << "Room " << newId << " created." << std::endl;
@@ -231,6 +593,8 @@ void ServerManager::processCommand(const std::string& command)
         }
         std::lock_guard<std::mutex> lock(_serverMutex);
         if (_rooms.erase(roomId)) {
+            _routes.unbindRoom(roomId);
+            publishRoom(roomId);
             std::cout << "Room " << roomId << " deleted. Players inside will be disconnected." << std::endl;
         } else {
             std::cout << "Room " << roomId << " not found." << std::endl;
@@ -243,15 +607,10 @@ void ServerManager::processCommand(const std::string& command)
         }
 
         bool playerFoundAndRemoved = false;
-        {
-            std::lock_guard<std::mutex> lock(_serverMutex);
-            for (auto const& [id, game] : _rooms) {
-                if (game && game->getPlayer(playerId)) {
-                    game->kickPlayer(playerId, _udpServer);
-                    playerFoundAndRemoved = true;
-                    break;
-                }
-            }
+        if (auto game = _routes.findRoom(playerId)) {
+            // The route stays until the room is done delivering the kick notice.
+            game->queueKick(playerId);
+            playerFoundAndRemoved = true;
         }
 
         if (!playerFoundAndRemoved) {
@@ -0,0 +1,54 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** SpatialGrid
+*/
+
+#include "Server/SpatialGrid.hpp"
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+    : _inverseCellSize(1.0f / cellSize),
+      _columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+      _rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+      _cellStart(static_cast<size_t>(_columns * _rows) + 1, 0)
+{
+}
+
+void SpatialGrid::clear()
+{
+    _boxes.clear();
+    _cellItems.clear();
+    std::fill(_cellStart.begin(), _cellStart.end(), 0);
+}
+
+void SpatialGrid::insert(uint32_t index, float x, float y, int w, int h)
+{
+    _boxes.push_back({index, cellX(x), cellY(y), cellX(x + w), cellY(y + h)});
+}
+
+void SpatialGrid::build()
+{
+    std::fill(_cellStart.begin(), _cellStart.end(), 0);
+
+    // Counting sort: count the boxes of each cell, turn the counts into
+    // offsets, then place every box index at its cell's offset.
+    for (const Box& box : _boxes) {
+        for (int cy = box.y0; cy <= box.y1; ++cy)
+            for (int cx = box.x0; cx <= box.x1; ++cx)
+                ++_cellStart[static_cast<size_t>(cy * _columns + cx) + 1];
+    }
+    for (size_t cell = 1; cell < _cellStart.size(); ++cell)
+        _cellStart[cell] += _cellStart[cell - 1];
+
+    _cellItems.resize(_cellStart.back());
+    for (const Box& box : _boxes) {
+        for (int cy = box.y0; cy <= box.y1; ++cy)
+            for (int cx = box.x0; cx <= box.x1; ++cx)
+                _cellItems[_cellStart[static_cast<size_t>(cy * _columns + cx)]++] = box.index;
+    }
+    // The fill pass advanced every offset to the start of the next cell.
+    for (size_t cell = _cellStart.size() - 1; cell > 0; --cell)
+        _cellStart[cell] = _cellStart[cell - 1];
+    _cellStart[0] = 0;
+}
@@ -0,0 +1,86 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** TickProfiler
+*/
+
+#include "Server/TickProfiler.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+size_t PhaseHistogram::bucketIndex(uint64_t us)
+{
+    us = std::min<uint64_t>(us, (1ull << MAX_VALUE_BITS) - 1);
+    if (us < SUB_BUCKETS)
+        return static_cast<size_t>(us);
+    // Keeps the SUB_BUCKET_BITS + 1 top bits: the leading one picks the power of two, the rest the linear bucket.
+    uint32_t shift = static_cast<uint32_t>(std::bit_width(us)) - SUB_BUCKET_BITS - 1;
+    return static_cast<size_t>(shift * SUB_BUCKETS + (us >> shift));
+}
+
+uint64_t PhaseHistogram::bucketUpperBound(size_t index)
+{
+    if (index < SUB_BUCKETS)
+        return index;
+    uint64_t shift = index / SUB_BUCKETS - 1;
+    uint64_t top = index - shift * SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+void PhaseHistogram::record(uint64_t us)
+{
+    _counts[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = _maxUs.load(std::memory_order_relaxed);
+    while (us > max && !_maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
+}
+
+void PhaseHistogram::addTo(Snapshot& out) const
+{
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t count = _counts[i].load(std::memory_order_relaxed);
+        out.counts[i] += count;
+        out.samples += count;
+    }
+    out.maxUs = std::max(out.maxUs, _maxUs.load(std::memory_order_relaxed));
+}
+
+uint64_t PhaseHistogram::Snapshot::percentile(double p) const
+{
+    if (samples == 0)
+        return 0;
+    auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(samples)));
+    rank = std::clamp<uint64_t>(rank, 1, samples);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::min(bucketUpperBound(i), maxUs);
+    }
+    return maxUs;
+}
+
+void TickProfiler::addTo(TickProfile& out) const
+{
+    for (size_t i = 0; i < TICK_PHASE_COUNT; ++i)
+        _phases[i].addTo(out[i]);
+}
+
+const char* TickProfiler::phaseName(TickPhase phase)
+{
+    switch (phase) {
+        case TickPhase::INPUTS: return "inputs";
+        case TickPhase::ENTITIES: return "entities";
+        case TickPhase::COLLISIONS: return "collisions";
+        case TickPhase::BROADCAST: return "broadcast";
+        case TickPhase::LEVEL: return "level";
+        case TickPhase::BOSS: return "boss";
+        case TickPhase::SPAWN: return "spawn";
+        case TickPhase::GLOBAL_SYNC: return "global sync";
+        case TickPhase::TICK: return "tick";
+        default: return "?";
+    }
+}
@@ -0,0 +1,94 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** TickScheduler
+*/
+
+#include "Server/TickScheduler.hpp"
+#include <thread>
+
+TickScheduler::TickScheduler(uint32_t tickRate)
+    : _tickRate(isSupportedTickRate(tickRate) ? tickRate : DEFAULT_TICK_RATE),
+      _activeRate(_tickRate.load()),
+      _period(std::chrono::nanoseconds(std::chrono::seconds(1)) / _activeRate)
+{
+}
+
+bool TickScheduler::isSupportedTickRate(uint32_t tickRate)
+{
+    return tickRate == 30 || tickRate == 60 || tickRate == 120;
+}
+
+bool TickScheduler::setTickRate(uint32_t tickRate)
+{
+    if (!isSupportedTickRate(tickRate))
+        return false;
+    _tickRate.store(tickRate, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t TickScheduler::waitForTicks()
+{
+    uint32_t requested = _tickRate.load(std::memory_order_relaxed);
+    if (requested != _activeRate) {
+        _activeRate = requested;
+        _period = std::chrono::nanoseconds(std::chrono::seconds(1)) / _activeRate;
+        _accumulator = std::chrono::nanoseconds(0);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!_started) {
+        // The first tick runs immediately.
+        _started = true;
+        _lastWake = now;
+        _accumulator = _period;
+    }
+    _accumulator += now - _lastWake;
+    _lastWake = now;
+
+    while (_accumulator < _period) {
+        std::this_thread::sleep_until(now + (_period - _accumulator));
+        now = std::chrono::steady_clock::now();
+        _accumulator += now - _lastWake;
+        _lastWake = now;
+    }
+
+    uint64_t due = static_cast<uint64_t>(_accumulator / _period);
+    if (due > MAX_CATCH_UP_TICKS) {
+        _droppedTicks.fetch_add(due - MAX_CATCH_UP_TICKS, std::memory_order_relaxed);
+        due = MAX_CATCH_UP_TICKS;
+        _accumulator %= _period;
+    } else {
+        _accumulator -= _period * due;
+    }
+    _catchUpTicks.fetch_add(due - 1, std::memory_order_relaxed);
+    return static_cast<uint32_t>(due);
+}
+
+void TickScheduler::recordTick(std::chrono::steady_clock::duration duration)
+{
+    uint64_t us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+    _ticks.fetch_add(1, std::memory_order_relaxed);
+    _lastTickUs.store(us, std::memory_order_relaxed);
+    _totalTickUs.fetch_add(us, std::memory_order_relaxed);
+    if (us > _maxTickUs.load(std::memory_order_relaxed))
+        _maxTickUs.store(us, std::memory_order_relaxed);
+    if (duration > _period)
+        _overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+TickStats TickScheduler::getStats() const
+{
+    TickStats stats;
+    stats.tickRate = getTickRate();
+    stats.ticks = _ticks.load(std::memory_order_relaxed);
+    stats.overruns = _overruns.load(std::memory_order_relaxed);
+    stats.catchUpTicks = _catchUpTicks.load(std::memory_order_relaxed);
+    stats.droppedTicks = _droppedTicks.load(std::memory_order_relaxed);
+    stats.lastTickUs = _lastTickUs.load(std::memory_order_relaxed);
+    stats.maxTickUs = _maxTickUs.load(std::memory_order_relaxed);
+    stats.totalTickUs = _totalTickUs.load(std::memory_order_relaxed);
+    return stats;
+}
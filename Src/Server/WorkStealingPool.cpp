@@ -0,0 +1,132 @@
+/*
+** EPITECH PROJECT, 2025
+** RType-CI-CD
+** File description:
+** WorkStealingPool
+*/
+
+#include "Server/WorkStealingPool.hpp"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+size_t WorkStealingPool::defaultWorkerCount()
+{
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return cores - 1;
+}
+
+WorkStealingPool::WorkStealingPool(size_t workers)
+{
+    for (size_t i = 0; i <= workers; ++i)
+        _queues.push_back(std::make_unique<Queue>());
+    _workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+        _workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping = true;
+    }
+    _wakeCondition.notify_all();
+    for (auto& worker : _workers) {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    Queue& queue = *_queues[_nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size()];
+
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        _queued.fetch_add(1, std::memory_order_release);
+    }
+    {
+        // Orders the increment with a worker that checked its wait predicate but is not asleep yet.
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+    }
+    _wakeCondition.notify_one();
+}
+
+bool WorkStealingPool::runOne(size_t home)
+{
+    Task task;
+    bool stolen = false;
+
+    {
+        Queue& own = *_queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    for (size_t offset = 1; !task && offset < _queues.size(); ++offset) {
+        Queue& victim = *_queues[(home + offset) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            stolen = true;
+        }
+    }
+    if (!task)
+        return false;
+
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "[WorkStealingPool] Task failed: " << e.what() << std::endl;
+    }
+    _executed.fetch_add(1, std::memory_order_relaxed);
+    if (stolen)
+        _stolen.fetch_add(1, std::memory_order_relaxed);
+
+    if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(_doneMutex);
+        _doneCondition.notify_all();
+    }
+    return true;
+}
+
+void WorkStealingPool::workerLoop(size_t index)
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait(lock, [this] {
+                return _stopping.load() || _queued.load(std::memory_order_acquire) > 0;
+            });
+            if (_stopping)
+                return;
+        }
+        while (runOne(index)) {
+        }
+    }
+}
+
+void WorkStealingPool::wait()
+{
+    while (runOne(_queues.size() - 1)) {
+    }
+    std::unique_lock<std::mutex> lock(_doneMutex);
+    _doneCondition.wait(lock, [this] { return _pending.load(std::memory_order_acquire) == 0; });
+}
+
+PoolStats WorkStealingPool::getStats() const
+{
+    PoolStats stats;
+    stats.workers = _workers.size();
+    stats.executed = _executed.load(std::memory_order_relaxed);
+    stats.stolen = _stolen.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -7,13 +7,48 @@
 
 #include <iostream>
 #include "Exception.hpp"
+#include <cstdlib>
 #include <memory>
+#include <string>
 #include "Server/ServerManager.hpp"
 
-int main(void)
+int main(int argc, char **argv)
 {
+    uint32_t tickRate = TickScheduler::DEFAULT_TICK_RATE;
+    unsigned long metricsPort = Network::MetricsExporter::DEFAULT_PORT;
+    Network::BackpressurePolicy backpressure = Network::BackpressurePolicy::DROP_BY_PRIORITY;
+    uint32_t clientKbps = BandwidthBudget::DEFAULT_KBPS;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            if (!TickScheduler::isSupportedTickRate(tickRate)) {
+                std::cerr << "Unsupported tick rate, use 30, 60 or 120." << std::endl;
+                return 84;
+            }
+        } else if (arg == "--metrics-port" && i + 1 < argc) {
+            metricsPort = std::strtoul(argv[++i], nullptr, 10);
+            if (metricsPort > 65535) {
+                std::cerr << "Invalid metrics port." << std::endl;
+                return 84;
+            }
+        } else if (arg == "--backpressure" && i + 1 < argc) {
+            if (!Network::parseBackpressurePolicy(argv[++i], backpressure)) {
+                std::cerr << "Unknown backpressure policy, use drop-newest, drop-oldest, priority or fair-share." << std::endl;
+                return 84;
+            }
+        } else if (arg == "--client-kbps" && i + 1 < argc) {
+            clientKbps = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--tick-rate 30|60|120] [--metrics-port port|0]"
+                      << " [--backpressure drop-newest|drop-oldest|priority|fair-share] [--client-kbps kbps|0]" << std::endl;
+            return 84;
+        }
+    }
+
     try {
-        auto serverManager = std::make_unique<ServerManager>();
+        auto serverManager = std::make_unique<ServerManager>(tickRate, static_cast<unsigned short>(metricsPort), backpressure, clientKbps);
         serverManager->run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;